@@ -1,6 +1,7 @@
 #ifndef CLIST_ITEM_H
 #define CLIST_ITEM_H
 
+#include <stdint.h>
 #include <stdlib.h>
 
 /*
@@ -14,9 +15,49 @@ typedef int (*ClistCompareCallback)(const void *, const void *, size_t);
 
 typedef void *(*ClistCopyCallback)(void *, const void *, size_t);
 
+/*
+ * Callbacks for sorting with user data
+ */
+typedef int (*ClistSortCallback)(const void *, const void *, size_t, void *);
+
+typedef int64_t (*ClistKeyCallback)(const void *, size_t, void *);
+
+/*
+ * Callback for hashing data, data that compares equal must hash the same
+ */
+typedef size_t (*ClistHashCallback)(const void *);
+
 /* public type for private implementation */
 typedef struct __clist_item ClistItem;
 
+/* the callbacks shared by a group of items */
+typedef struct __clist_item_type ClistItemType;
+
+/**
+ * creates an item type to share between items with the same callbacks
+ * the type must outlive any items using it
+ * @param  comparator the function to compare the memory, can be NULL for memcmp
+ * @param  allocator  the function to allocate new memory, can be NULL
+ * @param  destructor the function to destroy the memory, can be NULL
+ * @param  copier     the function to copy the memory, can be NULL
+ * @return            an item type
+ */
+ClistItemType *clist_item_type_new(ClistCompareCallback comparator, ClistAllocCallback allocator,
+                                   ClistDestroyCallback destructor, ClistCopyCallback copier);
+
+/**
+ * destroys an item type
+ * @param type the item type instance
+ */
+void clist_item_type_delete(ClistItemType *type);
+
+/**
+ * gets the type of an item
+ * @param item the item instance
+ * @return the item type
+ */
+const ClistItemType *clist_item_type(const ClistItem *item);
+
 /**
  * creates a list item suitable for adding to a list
  * this implementation will use the stdlib methods for dealing with memory:
@@ -55,6 +96,16 @@ ClistItem *clist_item_new_transient(void *data, size_t size, ClistCompareCallbac
                                            ClistAllocCallback allocator, ClistDestroyCallback destructor,
                                            ClistCopyCallback copier);
 
+/**
+ * creates a list item suitable for adding to a list
+ * the callbacks are shared through the type instead of stored in each item
+ * @param  data the memory to use as a list item
+ * @param  size the size of the data in bytes
+ * @param  type the item type
+ * @return      a list item
+ */
+ClistItem *clist_item_new_typed(void *data, size_t size, const ClistItemType *type);
+
 /**
  * destroy a list item
  * will call the destructor function on the data if set
@@ -85,6 +136,21 @@ size_t clist_item_size(const ClistItem *item);
  */
 ClistItem *clist_item_copy(const ClistItem *item);
 
+/**
+ * sets the largest data size copied inline with its item.
+ * applies to items with an allocator and a copier that are destroyed with free (or not at all),
+ * the copies need a single allocation and no destructor call.  zero disables inline copies.
+ * may be changed while other threads copy, each copy uses the setting it reads.
+ * @param size the size in bytes
+ */
+void clist_item_set_inline_threshold(size_t size);
+
+/**
+ * gets the largest data size copied inline with its item
+ * @return the size in bytes
+ */
+size_t clist_item_inline_threshold();
+
 /**
  * compares two items.  the compare function must be set on the item, otherwise memcmp will be used
  * @param  item the item instance
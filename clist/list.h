@@ -6,12 +6,140 @@
 /* public type for private implementation */
 typedef struct __clist Clist;
 
+/* counters for lists that allocate from a node pool */
+typedef struct __clist_pool_stats {
+    /* the number of nodes allocated */
+    size_t allocations;
+    /* the number of allocations served by a previously freed node */
+    size_t recycled;
+    /* the number of nodes currently allocated */
+    size_t in_use;
+    /* the number of blocks held by the pool */
+    size_t blocks;
+    /* the number of nodes in each block */
+    size_t block_size;
+} ClistPoolStats;
+
 /**
  * creates a new list
  * @return an allocated list object
  */
 Clist *clist_new_single();
 
+/**
+ * creates a new list that allocates its nodes from blocks owned by the list.
+ * removed nodes are reused, and the blocks are released when the list is cleared.
+ * @param block_size the number of nodes to allocate at once, zero for a default
+ * @return an allocated list object
+ */
+Clist *clist_new_single_pooled(size_t block_size);
+
+/**
+ * creates a new list that allocates its nodes, and the items it copies, from an arena owned by the list.
+ * memory for removed nodes is only reclaimed when the list is cleared. clearing is a single
+ * arena reset when the list holds no items that need to be destroyed individually.
+ * @param block_size the number of bytes to allocate at once, zero for a default
+ * @return an allocated list object
+ */
+Clist *clist_new_single_arena(size_t block_size);
+
+/**
+ * creates a new list backed by a dynamic array
+ * items can be accessed by index in constant time
+ * @return an allocated list object
+ */
+Clist *clist_new_array();
+
+/**
+ * creates a new list backed by a dynamic array
+ * @param capacity the number of items to reserve space for
+ * @return an allocated list object
+ */
+Clist *clist_new_array_with_capacity(size_t capacity);
+
+/**
+ * creates a new unrolled linked list
+ * each node holds a small array of items, so scans touch several items per node
+ * while inserting and removing in the middle only moves the items of one node.
+ * nodes are split when full and merged when less than half full.
+ * @param chunk_capacity the number of items held by each node, zero for a default
+ * @return an allocated list object
+ */
+Clist *clist_new_unrolled(size_t chunk_capacity);
+
+/**
+ * creates a new ordered list
+ * the items are kept in the order of their compare function, equal items in the order
+ * they were added, whatever position they are added at.  a skip list finds an item,
+ * or the item at an index, in O(log n).  sorting has no effect.
+ * @return an allocated list object
+ */
+Clist *clist_new_ordered();
+
+/**
+ * creates a new rope
+ * a balanced tree of the items in list order, so getting, setting, adding and removing
+ * at an index take O(log n), as do clist_split, clist_concat and clist_transfer_range.
+ * @return an allocated list object
+ */
+Clist *clist_new_rope();
+
+/*
+ * what a full ring does with an added item
+ */
+typedef enum {
+    /* drop the item at the far end from the insert, the oldest when adding last */
+    ClistRingOverwrite,
+    /* refuse the added item, leaving it with the caller */
+    ClistRingReject
+} ClistRingPolicy;
+
+/**
+ * creates a new ring, a fixed capacity list in a circular buffer
+ * items are added and removed at either end and found by index in constant time,
+ * and nothing is allocated after the buffer.  a full ring overwrites its oldest items.
+ * @param capacity the most items the ring holds, at least one
+ * @return an allocated list object
+ */
+Clist *clist_new_ring(size_t capacity);
+
+/**
+ * creates a new ring with a policy for adding to it when full.
+ * overwritten items are deleted, compare the size to the capacity to keep them.
+ * rejected items are not, they stay with the caller, see clist_ring_offer.
+ * a rejecting ring adds all of the items of a batch, list or transfer or none of them.
+ * @param capacity the most items the ring holds, at least one
+ * @param policy what to do with an added item when full
+ * @return an allocated list object
+ */
+Clist *clist_new_ring_with_policy(size_t capacity, ClistRingPolicy policy);
+
+/**
+ * creates a stack that threads can add to and pop from without locking.
+ * only clist_add, clist_add_value, clist_pop_first, clist_clear, clist_size and clist_is_empty
+ * are supported, and the size is exact only while no thread is changing the stack.
+ * @return an allocated list object
+ */
+Clist *clist_new_lockfree_stack();
+
+/**
+ * creates a list that can be shared between threads, wrapping another list of any
+ * implementation with a reader/writer lock.  reads run in parallel and changes one at a time.
+ * each call is atomic on its own, but a sequence of calls is not, nor is the data returned
+ * by get once another thread can remove the item, use clist_locked_apply for those.
+ * callbacks are given the wrapped list, and must not call back into the concurrent list.
+ * @param inner the list to wrap, owned by the concurrent list and not to be used directly
+ * @return an allocated list object
+ */
+Clist *clist_new_concurrent(Clist *inner);
+
+/**
+ * creates a new doubly linked list
+ * items can be added and removed at either end in constant time
+ * @return an allocated list object
+ */
+Clist *clist_new_double();
+
 /**
  * destroys a created list
  * @param list the list instance
@@ -26,6 +154,47 @@ void clist_delete(Clist *list);
  */
 void clist_add(Clist *list, ClistItem *item);
 
+/**
+ * prepends a copy of some data to the list
+ * the list owns the copy, which is stored in a single allocation with the
+ * list node and item where the implementation supports it
+ * @param list       the list instance
+ * @param data       the data to copy
+ * @param size       the size of the data in bytes
+ * @param comparator the compare function, can be NULL
+ */
+void clist_add_value(Clist *list, const void *data, size_t size, ClistCompareCallback comparator);
+
+/**
+ * appends a list item to the list
+ * @param list the list instance
+ * @param item the item to add to the list
+ * @see rj_list_item_create
+ */
+void clist_add_last(Clist *list, ClistItem *item);
+
+/**
+ * appends a list item to a ring, reporting if a full rejecting ring refused it
+ * @param list the ring instance, or a concurrent list wrapping one
+ * @param item the item to add to the ring
+ * @return positive if the item was added, zero if it was rejected and is still the caller's
+ */
+int clist_ring_offer(Clist *list, ClistItem *item);
+
+/**
+ * removes the first item from the list without destroying it
+ * @param list the list instance
+ * @return the removed item, owned by the caller, or NULL if the list is empty
+ */
+ClistItem *clist_pop_first(Clist *list);
+
+/**
+ * removes the last item from the list without destroying it
+ * @param list the list instance
+ * @return the removed item, owned by the caller, or NULL if the list is empty
+ */
+ClistItem *clist_pop_last(Clist *list);
+
 /**
  * adds an item to the list after the specific index
  * @param list  the list instance
@@ -39,6 +208,7 @@ void clist_add_index(Clist *list, size_t index, ClistItem *item);
  * adds one list to another
  * if the items in the other list have an allocator and a copier,
  * then a copy will be made.
+ * the items are added at the front, in the order of the other list.
  * @param list  the list instance
  * @param other the list to add from
  */
@@ -48,12 +218,32 @@ void clist_add_all(Clist *list, const Clist *other);
  * adds one list to another after the specified index
  * if the items in the other list have an allocator and a copier,
  * then a copy will be made.
+ * the items keep the order of the other list.
  * @param list  the list instance
  * @param index the index to add after
  * @param other the list to add from
  */
 void clist_add_all_index(Clist *list, size_t index, const Clist *other);
 
+/**
+ * prepends some items to the list, keeping their order.
+ * the list takes the items, and a linked list allocates their nodes together.
+ * @param list  the list instance
+ * @param items the items to add
+ * @param count the number of items
+ */
+void clist_add_batch(Clist *list, ClistItem **items, size_t count);
+
+/**
+ * adds some items to the list after the specific index, keeping their order.
+ * the index is only found once.  past the end nothing is added, and the items are still the caller's.
+ * @param list  the list instance
+ * @param index the index to add after
+ * @param items the items to add
+ * @param count the number of items
+ */
+void clist_add_batch_index(Clist *list, size_t index, ClistItem **items, size_t count);
+
 /**
  * removes all items in the list
  * if the items have a destructor set, it will be called
@@ -146,11 +336,192 @@ int clist_is_empty(const Clist *list);
 
 /**
  * sorts the list based on the comparator
- * NOTE: the implementation is subject to change
+ * the sort is stable, items that compare equal keep their order.
+ * runs already in order (or in reverse order) are detected, so a sorted list takes linear time.
  * @param  list the list instance
  */
 void clist_sort(Clist *list);
 
+/**
+ * sorts the list with a compare function taking user data, instead of the item compare functions
+ * the sort is stable, items that compare equal keep their order.
+ * @param list     the list instance
+ * @param compare  the compare function, given the data of two items, the size of the first and ctx
+ * @param ctx      user data passed to the compare function
+ */
+void clist_sort_with(Clist *list, ClistSortCallback compare, void *ctx);
+
+/**
+ * sorts the list based on the comparator, splitting the work between threads.
+ * the list is cut into parts sorted at the same time, then merged in pairs at the same time,
+ * giving the same order as clist_sort.  small lists are sorted on the calling thread.
+ * @param list     the list instance
+ * @param nthreads the most threads to sort with, including the calling thread
+ */
+void clist_sort_parallel(Clist *list, size_t nthreads);
+
+/**
+ * sorts the list by an integer key, extracted once per item and cached for the sort
+ * the sort is stable and takes linear time.
+ * @param list the list instance
+ * @param key  the key function, given the data and size of an item and ctx
+ * @param ctx  user data passed to the key function
+ */
+void clist_sort_by_key(Clist *list, ClistKeyCallback key, void *ctx);
+
+/**
+ * splits a list in two, without copying any items
+ * @param  list  the list instance
+ * @param  index the index of the first item to move
+ * @return       an allocated list, of the same implementation, with the items from the index onwards
+ */
+Clist *clist_split(Clist *list, size_t index);
+
+/**
+ * moves all the items of another list to the end of a list, without copying them
+ * @param list  the list instance
+ * @param other a list of the same implementation, left empty
+ */
+void clist_concat(Clist *list, Clist *other);
+
+/**
+ * moves all the items of another list into a list at a position, without copying them.
+ * an ordered list keeps the items in order, whatever the position.
+ * @param dst   the list instance
+ * @param index the position of the first item moved, at most the size of the list
+ * @param src   a list of the same implementation, left empty
+ */
+void clist_splice(Clist *dst, size_t index, Clist *src);
+
+/**
+ * moves a range of items from another list into a list at a position, without copying them.
+ * nodes are relinked where the lists allocate them the same way, pooled or arena nodes are
+ * replaced by nodes of the destination holding the same items.
+ * @param dst       the list instance
+ * @param dst_index the position of the first item moved, at most the size of the list
+ * @param src       a list of the same implementation
+ * @param from      the index of the first item to move
+ * @param count     the number of items to move, fewer are moved if the source ends first
+ * @return          the number of items moved
+ */
+size_t clist_transfer_range(Clist *dst, size_t dst_index, Clist *src, size_t from, size_t count);
+
+/*
+ * how contains_all and remove_all match the items of two lists
+ */
+typedef enum {
+    /* scan for small lists, otherwise hash if there is a hash function, otherwise sort */
+    ClistJoinAuto,
+    /* compare the items pairwise, O(n * m) without extra memory */
+    ClistJoinScan,
+    /* hash one of the lists, O(n + m), needs a hash function */
+    ClistJoinHash,
+    /* sort one of the lists and search it, O((n + m) log n) with the item compare functions */
+    ClistJoinSort
+} ClistJoinStrategy;
+
+/**
+ * sets how contains_all and remove_all match the items of the list with another list
+ * a list with a hash index searches the index instead for contains_all.
+ * @param list     the list instance
+ * @param strategy the strategy
+ * @param hash     the hash function for item data, NULL to use the hash index function if there is one
+ */
+void clist_set_join_strategy(Clist *list, ClistJoinStrategy strategy, ClistHashCallback hash);
+
+/*
+ * the set operations keep the first of each group of equal items, in list order.
+ * they hash with the join strategy hash function or the hash index function, otherwise
+ * they sort.  like clist_add_all, items with an allocator and a copier are copied.
+ */
+
+/**
+ * creates a list, of the same implementation, with the items in either list
+ * @param  list  the list instance
+ * @param  other the other list
+ * @return       an allocated list with the items of the list, then the items only in the other list
+ */
+Clist *clist_union(const Clist *list, const Clist *other);
+
+/**
+ * creates a list, of the same implementation, with the items in both lists
+ * @param  list  the list instance
+ * @param  other the other list
+ * @return       an allocated list
+ */
+Clist *clist_intersection(const Clist *list, const Clist *other);
+
+/**
+ * creates a list, of the same implementation, with the items not in another list
+ * @param  list  the list instance
+ * @param  other the other list
+ * @return       an allocated list
+ */
+Clist *clist_difference(const Clist *list, const Clist *other);
+
+/**
+ * creates a list, of the same implementation, without duplicate items
+ * @param  list the list instance
+ * @return      an allocated list
+ */
+Clist *clist_unique(const Clist *list);
+
+/**
+ * keeps the items in either list, appending the items only in the other list
+ * @param  list  the list instance
+ * @param  other the other list
+ * @return       the number of items in the list
+ */
+int clist_union_in_place(Clist *list, const Clist *other);
+
+/**
+ * keeps the items also in another list
+ * @param  list  the list instance
+ * @param  other the other list
+ * @return       the number of items in the list
+ */
+int clist_intersection_in_place(Clist *list, const Clist *other);
+
+/**
+ * keeps the items not in another list
+ * @param  list  the list instance
+ * @param  other the other list
+ * @return       the number of items in the list
+ */
+int clist_difference_in_place(Clist *list, const Clist *other);
+
+/**
+ * removes duplicate items from a list
+ * @param  list the list instance
+ * @return      the number of items in the list
+ */
+int clist_unique_in_place(Clist *list);
+
+/**
+ * keeps a hash index of the items in a list, so that contains, and index_of and remove of
+ * data not in the list, take expected constant time.  a match is located by the list as
+ * without an index, linked lists removing the only match by identity, without comparing.
+ * the index is kept up to date as items are added and removed, and equal items are still
+ * told apart with the item compare functions.
+ * @param list the list instance
+ * @param hash the hash function for item data, equal data must hash the same
+ */
+void clist_enable_hash_index(Clist *list, ClistHashCallback hash);
+
+/**
+ * stops keeping a hash index of the items in a list
+ * @param list the list instance
+ */
+void clist_disable_hash_index(Clist *list);
+
+/**
+ * gets the node pool counters for a list
+ * @param list the list instance
+ * @param stats the counters to fill
+ * @return positive if the list uses a pool, otherwise zero
+ */
+int clist_pool_stats(const Clist *list, ClistPoolStats *stats);
+
 typedef enum { ClistIterateNext, ClistIteratorBreak, ClistIteratorDelete } ClistCallbackReturn;
 
 typedef ClistCallbackReturn (*ClistCallback)(Clist *list, size_t index, ClistItem *node);
@@ -162,4 +533,107 @@ typedef ClistCallbackReturn (*ClistCallback)(Clist *list, size_t index, ClistIte
  */
 void clist_for_each(Clist *list, ClistCallback callback);
 
+typedef void (*ClistParallelCallback)(void *data, size_t size, void *ctx);
+
+/**
+ * calls a function for the data of each item, with the items split between threads.
+ * linked lists are split by walking them once, arrays by index.  the threads are kept
+ * for the next parallel call.  the function may change the data but not the list, and
+ * may be called for several items at the same time.  a hash index is rebuilt afterwards.
+ * @param list     the list instance
+ * @param callback the function to call, given the data and size of an item and ctx
+ * @param ctx      user data passed to the callback
+ * @param nthreads the most threads to use, including the calling thread
+ */
+void clist_parallel_for_each(Clist *list, ClistParallelCallback callback, void *ctx, size_t nthreads);
+
+typedef int64_t (*ClistMapCallback)(const void *data, size_t size);
+
+typedef int64_t (*ClistCombineCallback)(int64_t a, int64_t b);
+
+/**
+ * maps the data of each item to a value and combines the values, with the items split between
+ * threads like clist_parallel_for_each.  values are combined in list order within each part
+ * and then across the parts, so combining must be associative but needn't be commutative.
+ * @param list     the list instance
+ * @param map      the map function, given the data and size of an item
+ * @param combine  the combine function
+ * @param identity the identity of the combine function, and the result for an empty list
+ * @param nthreads the most threads to use, including the calling thread
+ * @return the combined value
+ */
+int64_t clist_parallel_reduce(Clist *list, ClistMapCallback map, ClistCombineCallback combine, int64_t identity,
+                              size_t nthreads);
+
+typedef int (*ClistApplyCallback)(Clist *list, void *arg);
+
+/**
+ * calls a function that makes several changes to a list, holding the write lock of a
+ * concurrent list once for all of them.  any other list is passed to the function as is.
+ * @param list the list instance
+ * @param callback the function to call, given the list to change, the wrapped list if concurrent
+ * @param arg user data passed to the callback
+ * @return the callback result
+ */
+int clist_locked_apply(Clist *list, ClistApplyCallback callback, void *arg);
+
+/**
+ * a position in a list, for walking it in order without callbacks:
+ *
+ *   ClistIterator iter;
+ *   ClistItem *item;
+ *
+ *   for (clist_iter_begin(list, &iter); (item = clist_iter_next(&iter)) != NULL;) {
+ *       if (...) clist_iter_remove(&iter);
+ *   }
+ *
+ * the fields belong to the implementation.  while an iterator is in use, the list
+ * must only be changed through it.
+ */
+typedef struct __clist_iterator {
+    Clist *list;
+    /* the item returned by the last step, NULL after a remove or an insert */
+    ClistItem *item;
+    /* the number of items stepped over */
+    size_t index;
+    /* positions in the implementation */
+    void *node;
+    void *prev;
+    size_t offset;
+} ClistIterator;
+
+/**
+ * starts iterating a list, before the first item
+ * @param list the list instance
+ * @param iter the iterator to start
+ */
+void clist_iter_begin(Clist *list, ClistIterator *iter);
+
+/**
+ * steps to the next item, in constant time for all but the ordered and rope lists
+ * @param iter the iterator
+ * @return the item, still owned by the list, or NULL at the end
+ */
+ClistItem *clist_iter_next(ClistIterator *iter);
+
+/**
+ * removes the item returned by the last step, the next step returns the item after it
+ * @param iter the iterator
+ * @return positive if an item was removed, zero if there was no item to remove
+ */
+int clist_iter_remove(ClistIterator *iter);
+
+/**
+ * inserts an item after the items stepped over, at the front before the first step.
+ * the iterator moves past the new item, which is not returned by a step, and there is no
+ * item to remove until the next step.  an ordered list adds the item in order instead,
+ * where it is stepped to later if it belongs after the iterator.  a full ring list with the
+ * reject policy leaves the iterator where it was and the item with the caller, who must
+ * delete it; an inserted item belongs to the list.
+ * @param iter the iterator
+ * @param item the item to insert
+ * @return positive if the item was inserted, zero if it was rejected and is left with the caller
+ */
+int clist_iter_insert_after(ClistIterator *iter, ClistItem *item);
+
 #endif
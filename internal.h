@@ -1,25 +1,473 @@
 #ifndef CLIST_INTERNAL_H
 #define CLIST_INTERNAL_H
 
+#include <stddef.h>
+
 #include "list-vtable.h"
 
+/*
+ * rounds the size of a header up, so what is stored after it is aligned for any type
+ */
+#define CLIST_ALIGN_HEADER(size) (((size) + _Alignof(max_align_t) - 1) & ~(_Alignof(max_align_t) - 1))
+
+typedef struct __clist_index ClistIndex;
+
 struct __clist {
     ClistVtable *vtable;
     void *impl;
+    /* optional hash index of the items */
+    ClistIndex *index;
+    /* how to match the items of two lists, with an optional hash function */
+    ClistJoinStrategy join;
+    ClistHashCallback join_hash;
 };
 
-struct __clist_item {
-    void *data;
-    size_t size;
+struct __clist_item_type {
     ClistAllocCallback allocator;
     ClistDestroyCallback destructor;
     ClistCopyCallback copier;
     ClistCompareCallback comparer;
+    /* the next interned type */
+    ClistItemType *next;
 };
 
+struct __clist_item {
+    void *data;
+    size_t size;
+    const ClistItemType *type;
+};
+
+/**
+ * finds or registers a shared type for a set of callbacks.
+ * interned types live for the life of the program.
+ * @return the type instance
+ */
+const ClistItemType *__clist_item_type_intern(ClistCompareCallback comparer, ClistAllocCallback allocator,
+                                              ClistDestroyCallback destructor, ClistCopyCallback copier);
+
+/**
+ * the number of bytes needed to hold an item with its data inline
+ * @param size the size of the data
+ */
+size_t __clist_item_inline_size(size_t size);
+
+/**
+ * initializes an item in a block of memory with a copy of the data stored after it, aligned for any type.
+ * the block is owned by the caller, aligned for any type, and at least __clist_item_inline_size(size) bytes.
+ * @param block the memory for the item
+ * @param data the data to copy
+ * @param size the size of the data
+ * @param type the item type
+ * @return the initialized item
+ */
+ClistItem *__clist_item_init_inline(void *block, const void *data, size_t size, const ClistItemType *type);
+
+/**
+ * creates an item with a copy of the data in a single allocation
+ */
+ClistItem *__clist_item_new_inline(const void *data, size_t size, const ClistItemType *type);
+
+/**
+ * tests if an item holds its data inline
+ */
+int __clist_item_is_inline(const ClistItem *item);
+
+/**
+ * tests if the data of an item can be copied into new memory and released with free
+ */
+int __clist_item_is_plain(const ClistItem *item);
+
+/**
+ * tests if a copy of an item will hold its data inline,
+ * either because it already does or because the data is plain and under the inline threshold
+ */
+int __clist_item_copies_inline(const ClistItem *item);
+
+/**
+ * initializes an item in a block of memory with an inline copy of another item's data.
+ * the block must be at least __clist_item_inline_size(orig->size) bytes.
+ * @param block the memory for the item
+ * @param orig the item to copy
+ * @return the initialized item
+ */
+ClistItem *__clist_item_init_copy(void *block, const ClistItem *orig);
+
+/**
+ * destroys the data of an item without freeing the item itself,
+ * for items embedded in another allocation
+ */
+void __clist_item_release(ClistItem *item);
+
+typedef struct __clist_pool ClistPool;
+
+/**
+ * creates a pool of fixed size objects
+ * @param object_size the size of each object
+ * @param block_size the number of objects allocated at once, zero for a default
+ * @return the pool instance
+ */
+ClistPool *__clist_pool_new(size_t object_size, size_t block_size);
+
+/**
+ * destroys a pool and all the memory it allocated
+ */
+void __clist_pool_delete(ClistPool *pool);
+
+/**
+ * releases all the blocks in a pool at once.
+ * any objects still allocated from the pool become invalid.
+ */
+void __clist_pool_reset(ClistPool *pool);
+
+/**
+ * allocates an object, recycling a freed one if possible
+ */
+void *__clist_pool_alloc(ClistPool *pool);
+
+/**
+ * makes room for a number of objects in a single block, so allocating them doesn't allocate again
+ */
+void __clist_pool_reserve(ClistPool *pool, size_t count);
+
+/**
+ * returns an object to the pool for reuse
+ */
+void __clist_pool_free(ClistPool *pool, void *ptr);
+
+/**
+ * tests if memory was allocated from a pool
+ */
+int __clist_pool_owns(const ClistPool *pool, const void *ptr);
+
+/**
+ * gets the counters for a pool
+ */
+void __clist_pool_stats(const ClistPool *pool, ClistPoolStats *stats);
+
+/**
+ * creates a hash index for the items of a list
+ * @param hash the hash function for item data
+ * @return the index instance
+ */
+ClistIndex *__clist_index_new(ClistHashCallback hash);
+
+/**
+ * destroys a hash index, the items are not touched
+ */
+void __clist_index_delete(ClistIndex *index);
+
+/**
+ * gets the hash function of a hash index
+ */
+ClistHashCallback __clist_index_hasher(const ClistIndex *index);
+
+/**
+ * removes all the items from a hash index
+ */
+void __clist_index_clear(ClistIndex *index);
+
+/**
+ * adds an item to a hash index
+ */
+void __clist_index_attach(ClistIndex *index, ClistItem *item);
+
+/**
+ * removes an item, by identity, from a hash index, an item not in the index is ignored
+ */
+void __clist_index_detach(ClistIndex *index, const ClistItem *item);
+
+/**
+ * indexes all the items of a list again, if it has a hash index
+ * @param list the list instance
+ */
+void __clist_reindex(Clist *list);
+
+/**
+ * finds the items matching some data in a hash index
+ * @param index the index instance
+ * @param data the data to find
+ * @param found filled with up to max matching items, in no particular order
+ * @param max the size of found, zero to only test for a match
+ * @return the number of matching items, or max + 1 if there are more, found at the first one past max
+ */
+size_t __clist_index_find(const ClistIndex *index, const void *data, ClistItem **found, size_t max);
+
+/**
+ * counts the items in another list found in a list, by hashing or sorting the list
+ * @param list the list to search
+ * @param other the items to find
+ * @param hash the hash function, NULL to sort instead
+ * @return the number of items found
+ */
+int __clist_join_contains_all(const Clist *list, const Clist *other, ClistHashCallback hash);
+
+/**
+ * removes the first match in a list for each item in another list, by hashing or sorting the other list
+ * @param list the list to remove from, must not be the other list
+ * @param other the items to remove
+ * @param hash the hash function, NULL to sort instead
+ * @return the number of items removed
+ */
+int __clist_join_remove_all(Clist *list, const Clist *other, ClistHashCallback hash);
+
+/*
+ * the set operations on lists
+ */
+typedef enum { ClistSetUnion, ClistSetIntersection, ClistSetDifference, ClistSetUnique } ClistSetOp;
+
+/**
+ * selects the distinct items of a set operation, the first of each group of equal items in list order
+ * @param list the list
+ * @param other the other list, unused for unique
+ * @param op the set operation
+ * @param hash the hash function, NULL to sort instead
+ * @param selected set to an allocated array of the items, from the list and then the other list
+ * @return the number of items selected
+ */
+size_t __clist_join_select(const Clist *list, const Clist *other, ClistSetOp op, ClistHashCallback hash,
+                           ClistItem ***selected);
+
+typedef struct __clist_arena ClistArena;
+
+/**
+ * creates a bump allocator
+ * @param block_size the number of bytes allocated at once, zero for a default
+ * @return the arena instance
+ */
+ClistArena *__clist_arena_new(size_t block_size);
+
+/**
+ * destroys an arena and all the memory it allocated
+ */
+void __clist_arena_delete(ClistArena *arena);
+
+/**
+ * allocates memory from an arena, aligned for any type
+ */
+void *__clist_arena_alloc(ClistArena *arena, size_t size);
+
+/**
+ * releases everything allocated from an arena at once
+ */
+void __clist_arena_reset(ClistArena *arena);
+
 /**
  * a singly linked list
  */
 ClistVtable *__clist_single_vtable();
 
+/**
+ * allocates the nodes of a singly linked list from a pool
+ * @param list the singly linked list instance, must be empty
+ * @param block_size the number of nodes to allocate at once
+ */
+void __clist_single_set_pool(Clist *list, size_t block_size);
+
+/**
+ * allocates the nodes, items and item copies of a singly linked list from an arena
+ * @param list the singly linked list instance, must be empty
+ * @param block_size the number of bytes to allocate at once
+ */
+void __clist_single_set_arena(Clist *list, size_t block_size);
+
+/**
+ * a doubly linked list
+ */
+ClistVtable *__clist_double_vtable();
+
+/**
+ * a dynamic array list
+ */
+ClistVtable *__clist_array_vtable();
+
+/**
+ * ensures an array list can hold a number of items without growing
+ * @param list the array list instance
+ * @param capacity the number of items
+ */
+void __clist_array_reserve(Clist *list, size_t capacity);
+
+/*
+ * a part of a parallel operation
+ */
+typedef void (*ClistTaskCallback)(void *task);
+
+/**
+ * runs a callback for each of some tasks, spread over the shared worker threads and the
+ * calling thread, returning once all of them are done
+ * @param tasks the tasks, in an array
+ * @param task_size the size of a task
+ * @param count the number of tasks, a worker is started for each after the first if needed
+ * @param callback the callback, given a task
+ */
+void __clist_threads_run(void *tasks, size_t task_size, size_t count, ClistTaskCallback callback);
+
+/**
+ * calls a function for the data of each item, with the items split between threads
+ * @param list the list instance
+ * @param callback the function to call
+ * @param ctx user data passed to the callback
+ * @param nthreads the most threads to use, including the calling thread
+ */
+void __clist_parallel_for_each(Clist *list, ClistParallelCallback callback, void *ctx, size_t nthreads);
+
+/**
+ * maps the data of each item to a value and combines the values, with the items split between threads
+ * @param list the list instance
+ * @param map the map function
+ * @param combine the combine function, associative with identity as its identity
+ * @param identity the result for no items
+ * @param nthreads the most threads to use, including the calling thread
+ * @return the combined value
+ */
+int64_t __clist_parallel_reduce(Clist *list, ClistMapCallback map, ClistCombineCallback combine, int64_t identity,
+                                size_t nthreads);
+
+/*
+ * a compare function with user data for sorting
+ */
+struct __clist_sort_comparer {
+    /* NULL to use the item compare functions */
+    ClistSortCallback compare;
+    void *ctx;
+    /* the most threads to sort with, large sorts are split between them */
+    size_t threads;
+};
+
+/**
+ * sorts a chain of nodes with a stable, iterative merge of natural runs.
+ * O(n) for input already in order (or in reverse order), O(n log n) otherwise.
+ * @param first the first node, each node must start with its next link
+ * @param item_offset the offset of the item pointer in a node
+ * @param comparer the compare function, NULL to use the item compare functions.
+ *                 with more than one thread, a long chain is cut into parts sorted in parallel.
+ * @return the new first node, the chain ends with a NULL next link
+ */
+void *__clist_sort_nodes(void *first, size_t item_offset, const ClistSortComparer *comparer);
+
+/**
+ * sorts an array of items in place with the same algorithm as __clist_sort_nodes
+ * @param items the items
+ * @param size the number of items
+ * @param comparer the compare function, NULL to use the item compare functions
+ */
+void __clist_sort_items(ClistItem **items, size_t size, const ClistSortComparer *comparer);
+
+/**
+ * sorts a chain of nodes by a key extracted once per item, stable and O(n)
+ * @param first the first node, each node must start with its next link
+ * @param size the number of nodes
+ * @param item_offset the offset of the item pointer in a node
+ * @param key the key function
+ * @param ctx user data passed to the key function
+ * @return the new first node, the chain ends with a NULL next link
+ */
+void *__clist_sort_nodes_by_key(void *first, size_t size, size_t item_offset, ClistKeyCallback key, void *ctx);
+
+/**
+ * sorts an array of items in place by a key extracted once per item, stable and O(n)
+ * @param items the items
+ * @param size the number of items
+ * @param key the key function
+ * @param ctx user data passed to the key function
+ */
+void __clist_sort_items_by_key(ClistItem **items, size_t size, ClistKeyCallback key, void *ctx);
+
+/**
+ * an unrolled linked list
+ */
+ClistVtable *__clist_unrolled_vtable();
+
+/**
+ * sets the number of items held by each node of an unrolled list
+ * @param list the unrolled list instance, must be empty
+ * @param capacity the number of items per node, zero for a default
+ */
+void __clist_unrolled_set_capacity(Clist *list, size_t capacity);
+
+/**
+ * a skip list kept in the order of the item compare functions
+ */
+ClistVtable *__clist_ordered_vtable();
+
+/**
+ * a treap ordered by position, for positional access in O(log n)
+ */
+ClistVtable *__clist_rope_vtable();
+
+/**
+ * a fixed capacity circular buffer
+ */
+ClistVtable *__clist_ring_vtable();
+
+/**
+ * allocates the buffer of a ring
+ * @param list the ring instance, must not have a buffer
+ * @param capacity the number of items, at least one
+ * @param policy what to do with an added item when full
+ */
+void __clist_ring_set_capacity(Clist *list, size_t capacity, ClistRingPolicy policy);
+
+/**
+ * gets the number of items a list takes before rejecting one
+ * @param list the list instance
+ * @return the free slots of a rejecting ring, otherwise SIZE_MAX
+ */
+size_t __clist_ring_room(const Clist *list);
+
+/**
+ * allocates the buffer of a ring with the capacity and policy of another
+ * @param list the ring instance, must not have a buffer
+ * @param other another ring
+ */
+void __clist_ring_copy_capacity(Clist *list, const Clist *other);
+
+/**
+ * a lock free stack, adding and popping at the front only
+ */
+ClistVtable *__clist_lockfree_vtable();
+
+/**
+ * another list behind a reader/writer lock
+ */
+ClistVtable *__clist_concurrent_vtable();
+
+/**
+ * sets the list a concurrent list wraps, and takes ownership of it
+ * @param list the concurrent instance, must not wrap a list yet
+ * @param inner the list to wrap
+ */
+void __clist_concurrent_set_inner(Clist *list, Clist *inner);
+
+/**
+ * gets the list a concurrent list wraps, which must only be used with the lock held
+ * @param list the concurrent instance
+ * @return the wrapped list
+ */
+Clist *__clist_concurrent_inner(const Clist *list);
+
+/**
+ * enables or disables the hash index of the wrapped list with the lock held
+ * @param list the concurrent instance
+ * @param hash the hash function, or NULL to disable
+ */
+void __clist_concurrent_set_hash_index(Clist *list, ClistHashCallback hash);
+
+/**
+ * calls a function with the wrapped list and the write lock held
+ * @param list the concurrent instance
+ * @param callback the function to call
+ * @param arg user data passed to the callback
+ * @return the callback result
+ */
+int __clist_concurrent_apply(Clist *list, ClistApplyCallback callback, void *arg);
+
+/**
+ * visits each item in a list, regardless of implementation
+ * @param list the list instance
+ * @param callback the visit callback
+ * @param arg user data passed to the callback
+ */
+void __clist_visit(const Clist *list, ClistVisitCallback callback, void *arg);
+
 #endif
@@ -0,0 +1,105 @@
+#include <assert.h>
+#include <stddef.h>
+#include <stdlib.h>
+
+#include "internal.h"
+
+#define CLIST_ARENA_DEFAULT_BLOCK_SIZE (64 * 1024)
+
+#define CLIST_ARENA_ALIGN(size) (((size) + sizeof(max_align_t) - 1) & ~(sizeof(max_align_t) - 1))
+
+typedef struct __clist_arena_block ClistArenaBlock;
+
+struct __clist_arena_block {
+    ClistArenaBlock *next;
+    size_t size;
+    max_align_t data[];
+};
+
+/*
+ * a bump allocator. memory is only released all at once when the arena is reset.
+ */
+struct __clist_arena {
+    size_t block_size;
+    /* the newest block, linked to the older ones */
+    ClistArenaBlock *blocks;
+    char *cursor;
+    char *limit;
+};
+
+ClistArena *__clist_arena_new(size_t block_size) {
+    ClistArena *arena = malloc(sizeof(ClistArena));
+    assert(arena != NULL);
+    arena->block_size = block_size > 0 ? block_size : CLIST_ARENA_DEFAULT_BLOCK_SIZE;
+    arena->blocks = NULL;
+    arena->cursor = NULL;
+    arena->limit = NULL;
+    return arena;
+}
+
+static void __clist_arena_use(ClistArena *arena, ClistArenaBlock *block) {
+    arena->cursor = (char *) block->data;
+    arena->limit = arena->cursor + block->size;
+}
+
+void *__clist_arena_alloc(ClistArena *arena, size_t size) {
+    ClistArenaBlock *block = NULL;
+    void *ptr = NULL;
+    size_t block_size = 0;
+
+    assert(arena != NULL);
+
+    size = CLIST_ARENA_ALIGN(size);
+
+    if ((size_t) (arena->limit - arena->cursor) < size) {
+        block_size = size > arena->block_size ? size : arena->block_size;
+
+        block = malloc(sizeof(ClistArenaBlock) + block_size);
+        assert(block != NULL);
+
+        block->size = block_size;
+        block->next = arena->blocks;
+        arena->blocks = block;
+
+        __clist_arena_use(arena, block);
+    }
+
+    ptr = arena->cursor;
+    arena->cursor += size;
+    return ptr;
+}
+
+void __clist_arena_reset(ClistArena *arena) {
+    ClistArenaBlock *block = NULL, *next = NULL;
+
+    assert(arena != NULL);
+
+    if (arena->blocks == NULL) {
+        return;
+    }
+
+    /* keep the oldest block for reuse */
+    for (block = arena->blocks; block->next; block = next) {
+        next = block->next;
+        free(block);
+    }
+
+    arena->blocks = block;
+
+    __clist_arena_use(arena, block);
+}
+
+void __clist_arena_delete(ClistArena *arena) {
+    ClistArenaBlock *block = NULL, *next = NULL;
+
+    if (arena == NULL) {
+        return;
+    }
+
+    for (block = arena->blocks; block; block = next) {
+        next = block->next;
+        free(block);
+    }
+
+    free(arena);
+}
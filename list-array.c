@@ -0,0 +1,708 @@
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <clist/list-item.h>
+#include "list-vtable.h"
+#include "internal.h"
+
+#define CLIST_ARRAY_MIN_CAPACITY 8
+
+typedef struct __clist_array ClistArray;
+
+/*
+ * items are kept in a contiguous block from head to head + size.
+ * free space is kept on both ends so that prepending (add) and
+ * appending are both amortized constant time.
+ */
+struct __clist_array {
+    ClistItem **items;
+    size_t head;
+    size_t size;
+    size_t capacity;
+};
+
+extern void clist_array_clear(Clist *list);
+
+static inline ClistArray *__clist_array_impl(const Clist *arg) {
+    assert(arg->impl != NULL);
+    return (ClistArray *) arg->impl;
+}
+
+static inline ClistItem **__clist_array_begin(const ClistArray *array) {
+    return array->items + array->head;
+}
+
+/*
+ * ensures there is room for a number of items before and after the current items
+ */
+static void __clist_array_ensure(ClistArray *array, size_t front, size_t back) {
+    ClistItem **items = NULL;
+    size_t capacity = 0, head = 0;
+
+    assert(array != NULL);
+
+    if (array->head >= front && array->capacity - array->head - array->size >= back) {
+        return;
+    }
+
+    /* enough room overall, just re-center the items */
+    if (array->size + front + back <= array->capacity / 2) {
+        head = front + (array->capacity - array->size - front - back) / 2;
+        memmove(array->items + head, __clist_array_begin(array), array->size * sizeof(ClistItem *));
+        array->head = head;
+        return;
+    }
+
+    capacity = array->capacity * 2;
+
+    if (capacity < array->size + front + back) {
+        capacity = array->size + front + back;
+    }
+
+    if (capacity < CLIST_ARRAY_MIN_CAPACITY) {
+        capacity = CLIST_ARRAY_MIN_CAPACITY;
+    }
+
+    items = malloc(capacity * sizeof(ClistItem *));
+    assert(items != NULL);
+
+    head = front + (capacity - array->size - front - back) / 2;
+
+    if (array->items != NULL) {
+        memcpy(items + head, __clist_array_begin(array), array->size * sizeof(ClistItem *));
+        free(array->items);
+    }
+
+    array->items = items;
+    array->head = head;
+    array->capacity = capacity;
+}
+
+/*
+ * opens a gap of count slots at a position, moving the smaller side of the array
+ * @return the first slot of the gap
+ */
+static ClistItem **__clist_array_open(ClistArray *array, size_t pos, size_t count) {
+    ClistItem **items = NULL;
+
+    assert(array != NULL);
+    assert(pos <= array->size);
+
+    if (pos < array->size / 2) {
+        __clist_array_ensure(array, count, 0);
+        items = __clist_array_begin(array);
+        memmove(items - count, items, pos * sizeof(ClistItem *));
+        array->head -= count;
+    } else {
+        __clist_array_ensure(array, 0, count);
+        items = __clist_array_begin(array);
+        memmove(items + pos + count, items + pos, (array->size - pos) * sizeof(ClistItem *));
+    }
+
+    array->size += count;
+
+    return __clist_array_begin(array) + pos;
+}
+
+/*
+ * closes a gap of count slots at a position, moving the smaller side of the array
+ */
+static void __clist_array_close(ClistArray *array, size_t pos, size_t count) {
+    ClistItem **items = NULL;
+
+    assert(array != NULL);
+    assert(pos + count <= array->size);
+
+    items = __clist_array_begin(array);
+
+    if (pos < (array->size - count) / 2) {
+        memmove(items + count, items, pos * sizeof(ClistItem *));
+        array->head += count;
+    } else {
+        memmove(items + pos, items + pos + count, (array->size - pos - count) * sizeof(ClistItem *));
+    }
+
+    array->size -= count;
+}
+
+static int __clist_array_find_data(const ClistArray *array, const void *data) {
+    ClistItem **items = NULL;
+    size_t pos = 0;
+
+    assert(array != NULL);
+
+    items = __clist_array_begin(array);
+
+    for (pos = 0; pos < array->size; pos++) {
+        if (clist_item_compare(items[pos], data) == 0) {
+            return (int) pos;
+        }
+    }
+    return -1;
+}
+
+void *clist_array_new() {
+    ClistArray *array = malloc(sizeof(ClistArray));
+    assert(array != NULL);
+    array->items = NULL;
+    array->head = 0;
+    array->size = 0;
+    array->capacity = 0;
+    return array;
+}
+
+void __clist_array_reserve(Clist *list, size_t capacity) {
+    ClistArray *impl = NULL;
+
+    assert(list != NULL);
+
+    impl = __clist_array_impl(list);
+
+    if (capacity > impl->capacity) {
+        __clist_array_ensure(impl, 0, capacity - impl->size);
+    }
+}
+
+void clist_array_delete(Clist *list) {
+    ClistArray *impl = NULL;
+
+    assert(list != NULL);
+
+    clist_array_clear(list);
+
+    impl = __clist_array_impl(list);
+
+    free(impl->items);
+    free(impl);
+}
+
+void clist_array_add(Clist *list, ClistItem *item) {
+    assert(list != NULL);
+    assert(item != NULL);
+
+    *__clist_array_open(__clist_array_impl(list), 0, 1) = item;
+}
+
+void clist_array_add_last(Clist *list, ClistItem *item) {
+    ClistArray *impl = NULL;
+
+    assert(list != NULL);
+    assert(item != NULL);
+
+    impl = __clist_array_impl(list);
+
+    *__clist_array_open(impl, impl->size, 1) = item;
+}
+
+ClistItem *clist_array_pop_first(Clist *list) {
+    ClistArray *impl = NULL;
+    ClistItem *item = NULL;
+
+    assert(list != NULL);
+
+    impl = __clist_array_impl(list);
+
+    if (impl->size == 0) {
+        return NULL;
+    }
+
+    item = __clist_array_begin(impl)[0];
+
+    __clist_array_close(impl, 0, 1);
+
+    return item;
+}
+
+ClistItem *clist_array_pop_last(Clist *list) {
+    ClistArray *impl = NULL;
+    ClistItem *item = NULL;
+
+    assert(list != NULL);
+
+    impl = __clist_array_impl(list);
+
+    if (impl->size == 0) {
+        return NULL;
+    }
+
+    item = __clist_array_begin(impl)[impl->size - 1];
+
+    __clist_array_close(impl, impl->size - 1, 1);
+
+    return item;
+}
+
+void clist_array_add_index(Clist *list, size_t index, ClistItem *item) {
+    ClistArray *impl = NULL;
+
+    assert(list != NULL);
+    assert(item != NULL);
+
+    impl = __clist_array_impl(list);
+
+    if (index >= impl->size) {
+        return;
+    }
+
+    *__clist_array_open(impl, index + 1, 1) = item;
+}
+
+typedef struct __clist_array_copy_arg {
+    ClistItem **slot;
+} ClistArrayCopyArg;
+
+static ClistCallbackReturn __clist_array_copy_item(ClistItem *item, void *arg) {
+    ClistArrayCopyArg *params = (ClistArrayCopyArg *) arg;
+    *params->slot++ = clist_item_copy(item);
+    return ClistIterateNext;
+}
+
+/*
+ * inserts copies of the items in another list at a position, preserving their order
+ */
+static void __clist_array_insert_copies(Clist *list, size_t pos, const Clist *other) {
+    ClistArray *impl = NULL;
+    ClistArrayCopyArg params;
+    ClistItem **copies = NULL;
+    size_t count = 0, i = 0;
+
+    impl = __clist_array_impl(list);
+
+    count = clist_size(other);
+
+    if (count == 0) {
+        return;
+    }
+
+    /* the gap would be visited when adding a list to itself, so copy first */
+    if (list == other) {
+        copies = malloc(count * sizeof(ClistItem *));
+        assert(copies != NULL);
+
+        for (i = 0; i < count; i++) {
+            copies[i] = clist_item_copy(__clist_array_begin(impl)[i]);
+        }
+
+        memcpy(__clist_array_open(impl, pos, count), copies, count * sizeof(ClistItem *));
+
+        free(copies);
+        return;
+    }
+
+    params.slot = __clist_array_open(impl, pos, count);
+
+    __clist_visit(other, __clist_array_copy_item, &params);
+}
+
+void clist_array_add_all(Clist *list, const Clist *other) {
+    assert(list != NULL);
+    assert(other != NULL);
+
+    __clist_array_insert_copies(list, 0, other);
+}
+
+void clist_array_add_all_index(Clist *list, size_t index, const Clist *other) {
+    assert(list != NULL);
+    assert(other != NULL);
+
+    if (index >= __clist_array_impl(list)->size) {
+        return;
+    }
+
+    __clist_array_insert_copies(list, index + 1, other);
+}
+
+void clist_array_add_batch(Clist *list, ClistItem **items, size_t count) {
+    assert(list != NULL);
+    assert(items != NULL);
+
+    memcpy(__clist_array_open(__clist_array_impl(list), 0, count), items, count * sizeof(ClistItem *));
+}
+
+void clist_array_add_batch_index(Clist *list, size_t index, ClistItem **items, size_t count) {
+    ClistArray *impl = NULL;
+
+    assert(list != NULL);
+    assert(items != NULL);
+
+    impl = __clist_array_impl(list);
+
+    if (index >= impl->size) {
+        return;
+    }
+
+    memcpy(__clist_array_open(impl, index + 1, count), items, count * sizeof(ClistItem *));
+}
+
+void clist_array_transfer(Clist *list, size_t index, Clist *other, size_t from, size_t count) {
+    ClistArray *impl = NULL, *other_impl = NULL;
+
+    assert(list != NULL);
+    assert(other != NULL);
+
+    impl = __clist_array_impl(list);
+    other_impl = __clist_array_impl(other);
+
+    assert(count > 0 && from + count <= other_impl->size);
+
+    /* only the item pointers move */
+    memcpy(__clist_array_open(impl, index, count), __clist_array_begin(other_impl) + from,
+           count * sizeof(ClistItem *));
+
+    __clist_array_close(other_impl, from, count);
+}
+
+void clist_array_clear(Clist *list) {
+    ClistArray *impl = NULL;
+    ClistItem **items = NULL;
+    size_t pos = 0;
+
+    assert(list != NULL);
+
+    impl = __clist_array_impl(list);
+
+    items = __clist_array_begin(impl);
+
+    for (pos = 0; pos < impl->size; pos++) {
+        clist_item_delete(items[pos]);
+    }
+
+    impl->size = 0;
+    impl->head = impl->capacity / 2;
+}
+
+int clist_array_contains(const Clist *list, const void *data) {
+    if (list == NULL) {
+        return 0;
+    }
+
+    return __clist_array_find_data(__clist_array_impl(list), data) != -1;
+}
+
+typedef struct __clist_array_count_arg {
+    const ClistArray *array;
+    int count;
+} ClistArrayCountArg;
+
+static ClistCallbackReturn __clist_array_count_found(ClistItem *item, void *arg) {
+    ClistArrayCountArg *params = (ClistArrayCountArg *) arg;
+
+    if (__clist_array_find_data(params->array, item->data) != -1) {
+        params->count++;
+    }
+    return ClistIterateNext;
+}
+
+int clist_array_contains_all(const Clist *list, const Clist *other) {
+    ClistArrayCountArg params;
+
+    if (list == NULL || other == NULL) {
+        return 0;
+    }
+
+    params.array = __clist_array_impl(list);
+    params.count = 0;
+
+    __clist_visit(other, __clist_array_count_found, &params);
+
+    return params.count;
+}
+
+ClistItem *clist_array_get_item(const Clist *list, size_t index) {
+    ClistArray *impl = NULL;
+
+    if (list == NULL) {
+        return NULL;
+    }
+
+    impl = __clist_array_impl(list);
+
+    if (index >= impl->size) {
+        return NULL;
+    }
+
+    return __clist_array_begin(impl)[index];
+}
+
+void *clist_array_get(const Clist *list, size_t index) {
+    ClistItem *item = clist_array_get_item(list, index);
+
+    if (item == NULL) {
+        return NULL;
+    }
+
+    return item->data;
+}
+
+int clist_array_remove_index(Clist *list, size_t index) {
+    ClistArray *impl = NULL;
+
+    if (list == NULL) {
+        return 0;
+    }
+
+    impl = __clist_array_impl(list);
+
+    if (index >= impl->size) {
+        return 0;
+    }
+
+    clist_item_delete(__clist_array_begin(impl)[index]);
+
+    __clist_array_close(impl, index, 1);
+
+    return 1;
+}
+
+int clist_array_remove(Clist *list, const void *data) {
+    int index = 0;
+
+    if (list == NULL) {
+        return 0;
+    }
+
+    index = __clist_array_find_data(__clist_array_impl(list), data);
+
+    if (index == -1) {
+        return 0;
+    }
+
+    return clist_array_remove_index(list, (size_t) index);
+}
+
+typedef struct __clist_array_remove_arg {
+    Clist *list;
+    int count;
+} ClistArrayRemoveArg;
+
+static ClistCallbackReturn __clist_array_remove_found(ClistItem *item, void *arg) {
+    ClistArrayRemoveArg *params = (ClistArrayRemoveArg *) arg;
+
+    if (clist_array_remove(params->list, item->data)) {
+        params->count++;
+    }
+    return ClistIterateNext;
+}
+
+int clist_array_remove_all(Clist *list, const Clist *other) {
+    ClistArrayRemoveArg params;
+    int result = 0;
+
+    if (list == NULL || other == NULL) {
+        return 0;
+    }
+
+    /* removing a list from itself empties it */
+    if (list == other) {
+        result = (int) __clist_array_impl(list)->size;
+        clist_array_clear(list);
+        return result;
+    }
+
+    params.list = list;
+    params.count = 0;
+
+    __clist_visit(other, __clist_array_remove_found, &params);
+
+    return params.count;
+}
+
+int clist_array_index_of(const Clist *list, const void *data) {
+    if (list == NULL) {
+        return -1;
+    }
+
+    return __clist_array_find_data(__clist_array_impl(list), data);
+}
+
+void clist_array_set(Clist *list, size_t index, ClistItem *item) {
+    ClistArray *impl = NULL;
+    ClistItem **items = NULL;
+
+    if (list == NULL) {
+        return;
+    }
+
+    impl = __clist_array_impl(list);
+
+    if (index >= impl->size) {
+        return;
+    }
+
+    items = __clist_array_begin(impl);
+
+    clist_item_delete(items[index]);
+
+    items[index] = item;
+}
+
+size_t clist_array_size(const Clist *list) {
+    if (list == NULL) {
+        return 0;
+    }
+
+    return __clist_array_impl(list)->size;
+}
+
+int clist_array_is_empty(const Clist *list) {
+    assert(list != NULL);
+    return __clist_array_impl(list)->size == 0;
+}
+
+void clist_array_sort_with(Clist *list, const ClistSortComparer *comparer) {
+    ClistArray *impl = NULL;
+
+    if (clist_size(list) <= 1) {
+        return;
+    }
+
+    impl = __clist_array_impl(list);
+
+    __clist_sort_items(__clist_array_begin(impl), impl->size, comparer);
+}
+
+void clist_array_sort(Clist *list) {
+    clist_array_sort_with(list, NULL);
+}
+
+void clist_array_sort_by_key(Clist *list, ClistKeyCallback key, void *ctx) {
+    ClistArray *impl = NULL;
+
+    if (clist_size(list) <= 1) {
+        return;
+    }
+
+    impl = __clist_array_impl(list);
+
+    __clist_sort_items_by_key(__clist_array_begin(impl), impl->size, key, ctx);
+}
+
+void clist_array_visit(Clist *list, ClistVisitCallback callback, void *arg) {
+    ClistArray *impl = NULL;
+    ClistItem **items = NULL;
+    size_t pos = 0, kept = 0;
+
+    assert(list != NULL);
+    assert(callback != NULL);
+
+    impl = __clist_array_impl(list);
+
+    items = __clist_array_begin(impl);
+
+    /* deleted items are compacted out as we go */
+    for (pos = 0; pos < impl->size; pos++) {
+        switch (callback(items[pos], arg)) {
+            case ClistIteratorBreak:
+                memmove(items + kept, items + pos, (impl->size - pos) * sizeof(ClistItem *));
+                impl->size -= pos - kept;
+                return;
+            case ClistIteratorDelete:
+                clist_item_delete(items[pos]);
+                break;
+            default:
+                items[kept++] = items[pos];
+                break;
+        }
+    }
+
+    impl->size = kept;
+}
+
+/*
+ * the iterator index is the position of the next item
+ */
+ClistItem *clist_array_iter_next(ClistIterator *iter) {
+    ClistArray *impl = __clist_array_impl(iter->list);
+
+    if (iter->index >= impl->size) {
+        return NULL;
+    }
+
+    return __clist_array_begin(impl)[iter->index++];
+}
+
+void clist_array_iter_remove(ClistIterator *iter) {
+    ClistArray *impl = __clist_array_impl(iter->list);
+
+    iter->index--;
+
+    clist_item_delete(__clist_array_begin(impl)[iter->index]);
+
+    __clist_array_close(impl, iter->index, 1);
+}
+
+int clist_array_iter_insert(ClistIterator *iter, ClistItem *item) {
+    *__clist_array_open(__clist_array_impl(iter->list), iter->index, 1) = item;
+
+    iter->index++;
+
+    return 1;
+}
+
+void clist_array_for_each(Clist *list, ClistCallback callback) {
+    ClistArray *impl = NULL;
+    ClistItem **items = NULL;
+    size_t pos = 0, kept = 0;
+
+    assert(list != NULL);
+    assert(callback != NULL);
+
+    impl = __clist_array_impl(list);
+
+    items = __clist_array_begin(impl);
+
+    for (pos = 0; pos < impl->size; pos++) {
+        switch (callback(list, pos, items[pos])) {
+            case ClistIteratorBreak:
+                memmove(items + kept, items + pos, (impl->size - pos) * sizeof(ClistItem *));
+                impl->size -= pos - kept;
+                return;
+            case ClistIteratorDelete:
+                clist_item_delete(items[pos]);
+                break;
+            default:
+                items[kept++] = items[pos];
+                break;
+        }
+    }
+
+    impl->size = kept;
+}
+
+static ClistVtable __clist_array_table = {.create = clist_array_new,
+        .destroy = clist_array_delete,
+        .add = clist_array_add,
+        .add_last = clist_array_add_last,
+        .pop_first = clist_array_pop_first,
+        .pop_last = clist_array_pop_last,
+        .add_all = clist_array_add_all,
+        .add_index = clist_array_add_index,
+        .add_all_index = clist_array_add_all_index,
+        .add_batch = clist_array_add_batch,
+        .add_batch_index = clist_array_add_batch_index,
+        .transfer = clist_array_transfer,
+        .clear = clist_array_clear,
+        .contains = clist_array_contains,
+        .contains_all = clist_array_contains_all,
+        .get = clist_array_get,
+        .get_item = clist_array_get_item,
+        .remove = clist_array_remove,
+        .remove_index = clist_array_remove_index,
+        .remove_all = clist_array_remove_all,
+        .index_of = clist_array_index_of,
+        .set = clist_array_set,
+        .size = clist_array_size,
+        .is_empty = clist_array_is_empty,
+        .sort = clist_array_sort,
+        .sort_with = clist_array_sort_with,
+        .sort_by_key = clist_array_sort_by_key,
+        .for_each = clist_array_for_each,
+        .iter_next = clist_array_iter_next,
+        .iter_remove = clist_array_iter_remove,
+        .iter_insert = clist_array_iter_insert,
+        .visit = clist_array_visit};
+
+ClistVtable *__clist_array_vtable() {
+    return &__clist_array_table;
+}
@@ -0,0 +1,254 @@
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include <clist/list.h>
+
+/*
+ * times contains_all and remove_all with each join strategy over growing lists,
+ * to find where hashing or sorting starts to beat a pairwise scan, with mostly distinct
+ * values, again with a few values repeated many times (the "dups" rows), and with
+ * many values each repeated in runs of equal items once sorted (the "runs" rows).
+ * then times pushing and popping from threads sharing a stack, lock free or locked,
+ * and sorting a large list with more threads.
+ */
+
+#define BENCH_MIN_SIZE 4
+
+#define BENCH_MAX_SIZE 16384
+
+/* the total number of items processed per measurement, so small sizes are repeated */
+#define BENCH_WORK 1000000
+
+/* the distinct values in the lists of the dups rows */
+#define BENCH_FEW_DISTINCT 16
+
+/* the items per distinct value in the lists of the runs rows */
+#define BENCH_RUN_LENGTH 64
+
+static const char *bench_strategy_names[] = {"auto", "scan", "hash", "sort"};
+
+#define BENCH_MAX_THREADS 32
+
+/* the pushes and pops per thread */
+#define BENCH_STACK_WORK 200000
+
+#define BENCH_SORT_SIZE 2000000
+
+static int bench_int_compare(const void *a, const void *b, size_t size) {
+    return *(const int *) a - *(const int *) b;
+}
+
+static size_t bench_int_hash(const void *data) {
+    return (size_t) * (const int *) data;
+}
+
+static double bench_now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/*
+ * creates a list of pseudo random values, about half of them shared with a list of another seed
+ * @param distinct the number of values to pick from, zero for twice the size
+ */
+static Clist *bench_create(size_t size, size_t distinct, unsigned int seed) {
+    Clist *list = clist_new_array();
+    size_t i = 0;
+
+    for (i = 0; i < size; i++) {
+        int value = 0;
+        seed = seed * 1103515245 + 12345;
+        value = (int) ((seed >> 8) % (distinct ? distinct : size * 2));
+        clist_add_value(list, &value, sizeof(int), bench_int_compare);
+    }
+
+    return list;
+}
+
+static double bench_contains_all(ClistJoinStrategy strategy, size_t size, size_t distinct, size_t rounds) {
+    Clist *list = bench_create(size, distinct, 0);
+    Clist *other = bench_create(size, distinct, 1);
+    double start = 0, elapsed = 0;
+    size_t i = 0;
+
+    clist_set_join_strategy(list, strategy, bench_int_hash);
+
+    start = bench_now();
+
+    for (i = 0; i < rounds; i++) {
+        clist_contains_all(list, other);
+    }
+
+    elapsed = bench_now() - start;
+
+    clist_delete(list);
+    clist_delete(other);
+
+    return elapsed / rounds;
+}
+
+static double bench_remove_all(ClistJoinStrategy strategy, size_t size, size_t distinct, size_t rounds) {
+    Clist *other = bench_create(size, distinct, 1);
+    Clist *list = NULL;
+    double elapsed = 0, start = 0;
+    size_t i = 0;
+
+    for (i = 0; i < rounds; i++) {
+        list = bench_create(size, distinct, 0);
+
+        clist_set_join_strategy(list, strategy, bench_int_hash);
+
+        start = bench_now();
+
+        clist_remove_all(list, other);
+
+        elapsed += bench_now() - start;
+
+        clist_delete(list);
+    }
+
+    clist_delete(other);
+
+    return elapsed / rounds;
+}
+
+static void *bench_stack_thread(void *arg) {
+    Clist *list = (Clist *) arg;
+    int value = 0;
+    size_t i = 0;
+
+    for (i = 0; i < BENCH_STACK_WORK; i++) {
+        clist_add(list, clist_item_new_static(&value, sizeof(int), NULL));
+
+        clist_item_delete(clist_pop_first(list));
+    }
+
+    return NULL;
+}
+
+/*
+ * @return the stack operations per second across all threads
+ */
+static double bench_stack(Clist *list, size_t nthreads) {
+    pthread_t threads[BENCH_MAX_THREADS];
+    double start = 0, elapsed = 0;
+    size_t i = 0;
+
+    start = bench_now();
+
+    for (i = 0; i < nthreads; i++) {
+        pthread_create(&threads[i], NULL, bench_stack_thread, list);
+    }
+
+    for (i = 0; i < nthreads; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    elapsed = bench_now() - start;
+
+    clist_delete(list);
+
+    return nthreads * BENCH_STACK_WORK * 2 / elapsed;
+}
+
+/*
+ * @return the seconds to sort a list of pseudo random values
+ */
+static double bench_sort(Clist *list, size_t nthreads) {
+    double start = 0, elapsed = 0;
+    unsigned int seed = 0;
+    size_t i = 0;
+    int value = 0;
+
+    for (i = 0; i < BENCH_SORT_SIZE; i++) {
+        seed = seed * 1103515245 + 12345;
+        value = (int) (seed >> 8);
+        clist_add_value(list, &value, sizeof(int), bench_int_compare);
+    }
+
+    start = bench_now();
+
+    clist_sort_parallel(list, nthreads);
+
+    elapsed = bench_now() - start;
+
+    clist_delete(list);
+
+    return elapsed;
+}
+
+int main() {
+    ClistJoinStrategy strategy = ClistJoinAuto;
+    size_t size = 0, rounds = 0, nthreads = 0;
+
+    printf("%-14s %8s", "operation", "size");
+    for (strategy = ClistJoinAuto; strategy <= ClistJoinSort; strategy++) {
+        printf(" %12s", bench_strategy_names[strategy]);
+    }
+    printf("   (microseconds per call)\n");
+
+    for (size = BENCH_MIN_SIZE; size <= BENCH_MAX_SIZE; size *= 2) {
+        rounds = BENCH_WORK / (size * size) + 1;
+
+        printf("%-14s %8zu", "contains_all", size);
+        for (strategy = ClistJoinAuto; strategy <= ClistJoinSort; strategy++) {
+            printf(" %12.2f", bench_contains_all(strategy, size, 0, rounds) * 1e6);
+        }
+        printf("\n");
+
+        printf("%-14s %8zu", "remove_all", size);
+        for (strategy = ClistJoinAuto; strategy <= ClistJoinSort; strategy++) {
+            printf(" %12.2f", bench_remove_all(strategy, size, 0, rounds) * 1e6);
+        }
+        printf("\n");
+
+        printf("%-14s %8zu", "contains_dups", size);
+        for (strategy = ClistJoinAuto; strategy <= ClistJoinSort; strategy++) {
+            printf(" %12.2f", bench_contains_all(strategy, size, BENCH_FEW_DISTINCT, rounds) * 1e6);
+        }
+        printf("\n");
+
+        printf("%-14s %8zu", "remove_dups", size);
+        for (strategy = ClistJoinAuto; strategy <= ClistJoinSort; strategy++) {
+            printf(" %12.2f", bench_remove_all(strategy, size, BENCH_FEW_DISTINCT, rounds) * 1e6);
+        }
+        printf("\n");
+
+        printf("%-14s %8zu", "contains_runs", size);
+        for (strategy = ClistJoinAuto; strategy <= ClistJoinSort; strategy++) {
+            printf(" %12.2f", bench_contains_all(strategy, size, size / BENCH_RUN_LENGTH + 1, rounds) * 1e6);
+        }
+        printf("\n");
+
+        printf("%-14s %8zu", "remove_runs", size);
+        for (strategy = ClistJoinAuto; strategy <= ClistJoinSort; strategy++) {
+            printf(" %12.2f", bench_remove_all(strategy, size, size / BENCH_RUN_LENGTH + 1, rounds) * 1e6);
+        }
+        printf("\n");
+    }
+
+    printf("\n%-14s %8s %12s %12s   (million operations per second)\n", "stack", "threads", "lockfree",
+           "locked");
+
+    for (nthreads = 1; nthreads <= BENCH_MAX_THREADS; nthreads *= 2) {
+        printf("%-14s %8zu", "add/pop_first", nthreads);
+        printf(" %12.2f", bench_stack(clist_new_lockfree_stack(), nthreads) / 1e6);
+        printf(" %12.2f", bench_stack(clist_new_concurrent(clist_new_single()), nthreads) / 1e6);
+        printf("\n");
+    }
+
+    printf("\n%-14s %8s %12s %12s   (milliseconds for %d items)\n", "sort", "threads", "array", "single",
+           BENCH_SORT_SIZE);
+
+    for (nthreads = 1; nthreads <= BENCH_MAX_THREADS; nthreads *= 2) {
+        printf("%-14s %8zu", "sort_parallel", nthreads);
+        printf(" %12.2f", bench_sort(clist_new_array(), nthreads) * 1e3);
+        printf(" %12.2f", bench_sort(clist_new_single(), nthreads) * 1e3);
+        printf("\n");
+    }
+
+    return 0;
+}
@@ -0,0 +1,546 @@
+#include <assert.h>
+#include <pthread.h>
+#include <stdlib.h>
+
+#include <clist/list-item.h>
+#include "list-vtable.h"
+#include "internal.h"
+
+typedef struct __clist_concurrent ClistConcurrent;
+
+/*
+ * wraps another list with a reader/writer lock.  each operation takes the lock once and
+ * calls the public function on the wrapped list, so its hash index and join strategy apply.
+ * lists that cache the last position found by index also change on get, so positional reads
+ * of those lists hold a mutex as well, other reads still run in parallel.
+ */
+struct __clist_concurrent {
+    Clist *inner;
+    pthread_rwlock_t lock;
+    pthread_mutex_t position;
+    /* positive if getting by index changes the wrapped list */
+    int caches_position;
+};
+
+extern void clist_concurrent_clear(Clist *list);
+
+static inline ClistConcurrent *__clist_concurrent_impl(const Clist *arg) {
+    assert(arg->impl != NULL);
+    return (ClistConcurrent *) arg->impl;
+}
+
+static inline void __clist_concurrent_read(const Clist *list) {
+    pthread_rwlock_rdlock(&__clist_concurrent_impl(list)->lock);
+}
+
+static inline void __clist_concurrent_write(const Clist *list) {
+    pthread_rwlock_wrlock(&__clist_concurrent_impl(list)->lock);
+}
+
+static inline void __clist_concurrent_unlock(const Clist *list) {
+    pthread_rwlock_unlock(&__clist_concurrent_impl(list)->lock);
+}
+
+static inline int __clist_concurrent_is(const Clist *list) {
+    return list->vtable == __clist_concurrent_vtable();
+}
+
+/*
+ * locks a list and another list it reads from, in address order so two threads
+ * joining the same lists the other way around can't deadlock
+ * @param write positive to lock the list for writing
+ * @return the list to read from, the wrapped list of another concurrent list
+ */
+static const Clist *__clist_concurrent_lock_pair(const Clist *list, const Clist *other, int write) {
+    if (other == NULL || other == list || !__clist_concurrent_is(other)) {
+        write ? __clist_concurrent_write(list) : __clist_concurrent_read(list);
+        return other == list ? __clist_concurrent_impl(list)->inner : other;
+    }
+
+    if (list < other) {
+        write ? __clist_concurrent_write(list) : __clist_concurrent_read(list);
+        __clist_concurrent_read(other);
+    } else {
+        __clist_concurrent_read(other);
+        write ? __clist_concurrent_write(list) : __clist_concurrent_read(list);
+    }
+
+    return __clist_concurrent_impl(other)->inner;
+}
+
+static void __clist_concurrent_unlock_pair(const Clist *list, const Clist *other) {
+    if (other != NULL && other != list && __clist_concurrent_is(other)) {
+        __clist_concurrent_unlock(other);
+    }
+
+    __clist_concurrent_unlock(list);
+}
+
+void *clist_concurrent_new() {
+    ClistConcurrent *impl = malloc(sizeof(ClistConcurrent));
+    assert(impl != NULL);
+    impl->inner = NULL;
+    impl->caches_position = 0;
+    pthread_rwlock_init(&impl->lock, NULL);
+    pthread_mutex_init(&impl->position, NULL);
+    return impl;
+}
+
+void __clist_concurrent_set_inner(Clist *list, Clist *inner) {
+    ClistConcurrent *impl = NULL;
+
+    assert(list != NULL);
+    assert(inner != NULL);
+    assert(inner != list);
+
+    impl = __clist_concurrent_impl(list);
+
+    assert(impl->inner == NULL);
+
+    impl->inner = inner;
+
+    impl->caches_position = inner->vtable == __clist_single_vtable() || inner->vtable == __clist_double_vtable() ||
+                            inner->vtable == __clist_unrolled_vtable();
+
+    /* joins are made by the wrapped list, with its strategy */
+    list->join = inner->join;
+    list->join_hash = inner->join_hash;
+}
+
+Clist *__clist_concurrent_inner(const Clist *list) {
+    assert(list != NULL);
+
+    return __clist_concurrent_impl(list)->inner;
+}
+
+void __clist_concurrent_set_hash_index(Clist *list, ClistHashCallback hash) {
+    Clist *inner = NULL;
+
+    assert(list != NULL);
+
+    __clist_concurrent_write(list);
+
+    inner = __clist_concurrent_impl(list)->inner;
+
+    if (hash != NULL) {
+        clist_enable_hash_index(inner, hash);
+    } else {
+        clist_disable_hash_index(inner);
+    }
+
+    __clist_concurrent_unlock(list);
+}
+
+int __clist_concurrent_apply(Clist *list, ClistApplyCallback callback, void *arg) {
+    int result = 0;
+
+    assert(list != NULL);
+    assert(callback != NULL);
+
+    __clist_concurrent_write(list);
+
+    result = callback(__clist_concurrent_impl(list)->inner, arg);
+
+    __clist_concurrent_unlock(list);
+
+    return result;
+}
+
+void clist_concurrent_delete(Clist *list) {
+    ClistConcurrent *impl = NULL;
+
+    assert(list != NULL);
+
+    impl = __clist_concurrent_impl(list);
+
+    if (impl->inner != NULL) {
+        clist_delete(impl->inner);
+    }
+
+    pthread_rwlock_destroy(&impl->lock);
+    pthread_mutex_destroy(&impl->position);
+
+    free(impl);
+}
+
+void clist_concurrent_add(Clist *list, ClistItem *item) {
+    __clist_concurrent_write(list);
+    clist_add(__clist_concurrent_impl(list)->inner, item);
+    __clist_concurrent_unlock(list);
+}
+
+void clist_concurrent_add_value(Clist *list, const void *data, size_t size, ClistCompareCallback comparer) {
+    __clist_concurrent_write(list);
+    clist_add_value(__clist_concurrent_impl(list)->inner, data, size, comparer);
+    __clist_concurrent_unlock(list);
+}
+
+void clist_concurrent_add_last(Clist *list, ClistItem *item) {
+    __clist_concurrent_write(list);
+    clist_add_last(__clist_concurrent_impl(list)->inner, item);
+    __clist_concurrent_unlock(list);
+}
+
+ClistItem *clist_concurrent_pop_first(Clist *list) {
+    ClistItem *item = NULL;
+
+    __clist_concurrent_write(list);
+    item = clist_pop_first(__clist_concurrent_impl(list)->inner);
+    __clist_concurrent_unlock(list);
+
+    return item;
+}
+
+ClistItem *clist_concurrent_pop_last(Clist *list) {
+    ClistItem *item = NULL;
+
+    __clist_concurrent_write(list);
+    item = clist_pop_last(__clist_concurrent_impl(list)->inner);
+    __clist_concurrent_unlock(list);
+
+    return item;
+}
+
+void clist_concurrent_add_all(Clist *list, const Clist *other) {
+    const Clist *source = __clist_concurrent_lock_pair(list, other, 1);
+
+    clist_add_all(__clist_concurrent_impl(list)->inner, source);
+
+    __clist_concurrent_unlock_pair(list, other);
+}
+
+void clist_concurrent_add_index(Clist *list, size_t index, ClistItem *item) {
+    __clist_concurrent_write(list);
+    clist_add_index(__clist_concurrent_impl(list)->inner, index, item);
+    __clist_concurrent_unlock(list);
+}
+
+void clist_concurrent_add_all_index(Clist *list, size_t index, const Clist *other) {
+    const Clist *source = __clist_concurrent_lock_pair(list, other, 1);
+
+    clist_add_all_index(__clist_concurrent_impl(list)->inner, index, source);
+
+    __clist_concurrent_unlock_pair(list, other);
+}
+
+void clist_concurrent_add_batch(Clist *list, ClistItem **items, size_t count) {
+    __clist_concurrent_write(list);
+    clist_add_batch(__clist_concurrent_impl(list)->inner, items, count);
+    __clist_concurrent_unlock(list);
+}
+
+void clist_concurrent_add_batch_index(Clist *list, size_t index, ClistItem **items, size_t count) {
+    __clist_concurrent_write(list);
+    clist_add_batch_index(__clist_concurrent_impl(list)->inner, index, items, count);
+    __clist_concurrent_unlock(list);
+}
+
+void clist_concurrent_transfer(Clist *list, size_t index, Clist *other, size_t from, size_t count) {
+    Clist *first = list < other ? list : other, *second = list < other ? other : list;
+
+    /* both lists change, so both are locked for writing in address order */
+    __clist_concurrent_write(first);
+    __clist_concurrent_write(second);
+
+    /* the range is checked again, the other list may have changed since it was clamped */
+    clist_transfer_range(__clist_concurrent_impl(list)->inner, index, __clist_concurrent_impl(other)->inner, from,
+                         count);
+
+    __clist_concurrent_unlock(second);
+    __clist_concurrent_unlock(first);
+}
+
+void clist_concurrent_clear(Clist *list) {
+    __clist_concurrent_write(list);
+    clist_clear(__clist_concurrent_impl(list)->inner);
+    __clist_concurrent_unlock(list);
+}
+
+int clist_concurrent_contains(const Clist *list, const void *data) {
+    int result = 0;
+
+    __clist_concurrent_read(list);
+    result = clist_contains(__clist_concurrent_impl(list)->inner, data);
+    __clist_concurrent_unlock(list);
+
+    return result;
+}
+
+int clist_concurrent_contains_all(const Clist *list, const Clist *other) {
+    const Clist *source = __clist_concurrent_lock_pair(list, other, 0);
+    int result = 0;
+
+    result = clist_contains_all(__clist_concurrent_impl(list)->inner, source);
+
+    __clist_concurrent_unlock_pair(list, other);
+
+    return result;
+}
+
+ClistItem *clist_concurrent_get_item(const Clist *list, size_t index) {
+    ClistConcurrent *impl = __clist_concurrent_impl(list);
+    ClistItem *item = NULL;
+
+    __clist_concurrent_read(list);
+
+    if (impl->caches_position) {
+        pthread_mutex_lock(&impl->position);
+    }
+
+    item = (impl->inner->vtable->get_item)(impl->inner, index);
+
+    if (impl->caches_position) {
+        pthread_mutex_unlock(&impl->position);
+    }
+
+    __clist_concurrent_unlock(list);
+
+    return item;
+}
+
+void *clist_concurrent_get(const Clist *list, size_t index) {
+    ClistItem *item = clist_concurrent_get_item(list, index);
+
+    if (item == NULL) {
+        return NULL;
+    }
+
+    return item->data;
+}
+
+int clist_concurrent_remove(Clist *list, const void *data) {
+    int result = 0;
+
+    __clist_concurrent_write(list);
+    result = clist_remove(__clist_concurrent_impl(list)->inner, data);
+    __clist_concurrent_unlock(list);
+
+    return result;
+}
+
+int clist_concurrent_remove_index(Clist *list, size_t index) {
+    int result = 0;
+
+    __clist_concurrent_write(list);
+    result = clist_remove_index(__clist_concurrent_impl(list)->inner, index);
+    __clist_concurrent_unlock(list);
+
+    return result;
+}
+
+int clist_concurrent_remove_all(Clist *list, const Clist *other) {
+    const Clist *source = __clist_concurrent_lock_pair(list, other, 1);
+    int result = 0;
+
+    result = clist_remove_all(__clist_concurrent_impl(list)->inner, source);
+
+    __clist_concurrent_unlock_pair(list, other);
+
+    return result;
+}
+
+int clist_concurrent_index_of(const Clist *list, const void *data) {
+    int result = 0;
+
+    __clist_concurrent_read(list);
+    result = clist_index_of(__clist_concurrent_impl(list)->inner, data);
+    __clist_concurrent_unlock(list);
+
+    return result;
+}
+
+void clist_concurrent_set(Clist *list, size_t index, ClistItem *item) {
+    __clist_concurrent_write(list);
+    clist_set(__clist_concurrent_impl(list)->inner, index, item);
+    __clist_concurrent_unlock(list);
+}
+
+size_t clist_concurrent_size(const Clist *list) {
+    size_t result = 0;
+
+    __clist_concurrent_read(list);
+    result = clist_size(__clist_concurrent_impl(list)->inner);
+    __clist_concurrent_unlock(list);
+
+    return result;
+}
+
+int clist_concurrent_is_empty(const Clist *list) {
+    int result = 0;
+
+    __clist_concurrent_read(list);
+    result = clist_is_empty(__clist_concurrent_impl(list)->inner);
+    __clist_concurrent_unlock(list);
+
+    return result;
+}
+
+void clist_concurrent_sort(Clist *list) {
+    __clist_concurrent_write(list);
+    clist_sort(__clist_concurrent_impl(list)->inner);
+    __clist_concurrent_unlock(list);
+}
+
+void clist_concurrent_sort_with(Clist *list, const ClistSortComparer *comparer) {
+    Clist *inner = NULL;
+
+    __clist_concurrent_write(list);
+
+    inner = __clist_concurrent_impl(list)->inner;
+
+    /* the comparer may be the item compare functions or take threads, so it's passed as is */
+    (inner->vtable->sort_with)(inner, comparer);
+
+    __clist_concurrent_unlock(list);
+}
+
+void clist_concurrent_sort_by_key(Clist *list, ClistKeyCallback key, void *ctx) {
+    __clist_concurrent_write(list);
+    clist_sort_by_key(__clist_concurrent_impl(list)->inner, key, ctx);
+    __clist_concurrent_unlock(list);
+}
+
+int clist_concurrent_pool_stats(const Clist *list, ClistPoolStats *stats) {
+    int result = 0;
+
+    __clist_concurrent_read(list);
+    result = clist_pool_stats(__clist_concurrent_impl(list)->inner, stats);
+    __clist_concurrent_unlock(list);
+
+    return result;
+}
+
+/*
+ * the callback is given the wrapped list, and must not use the concurrent list
+ */
+void clist_concurrent_for_each(Clist *list, ClistCallback callback) {
+    __clist_concurrent_write(list);
+    clist_for_each(__clist_concurrent_impl(list)->inner, callback);
+    __clist_concurrent_unlock(list);
+}
+
+/*
+ * each step locks the list on its own, iterate in clist_locked_apply when other threads change the list
+ */
+ClistItem *clist_concurrent_iter_next(ClistIterator *iter) {
+    Clist *list = iter->list;
+    ClistItem *item = NULL;
+
+    __clist_concurrent_write(list);
+
+    iter->list = __clist_concurrent_impl(list)->inner;
+    item = clist_iter_next(iter);
+    iter->list = list;
+
+    __clist_concurrent_unlock(list);
+
+    return item;
+}
+
+void clist_concurrent_iter_remove(ClistIterator *iter) {
+    Clist *list = iter->list;
+
+    __clist_concurrent_write(list);
+
+    iter->list = __clist_concurrent_impl(list)->inner;
+    clist_iter_remove(iter);
+    iter->list = list;
+
+    __clist_concurrent_unlock(list);
+}
+
+int clist_concurrent_iter_insert(ClistIterator *iter, ClistItem *item) {
+    Clist *list = iter->list;
+    int result;
+
+    __clist_concurrent_write(list);
+
+    iter->list = __clist_concurrent_impl(list)->inner;
+    result = clist_iter_insert_after(iter, item);
+    iter->list = list;
+
+    __clist_concurrent_unlock(list);
+
+    return result;
+}
+
+typedef struct __clist_concurrent_visit_arg {
+    ClistIndex *index;
+    ClistVisitCallback callback;
+    void *arg;
+} ClistConcurrentVisitArg;
+
+/*
+ * removes the items a visit deletes from the hash index of the wrapped list
+ */
+static ClistCallbackReturn __clist_concurrent_visit_item(ClistItem *item, void *arg) {
+    ClistConcurrentVisitArg *params = (ClistConcurrentVisitArg *) arg;
+    ClistCallbackReturn result = params->callback(item, params->arg);
+
+    if (result == ClistIteratorDelete) {
+        __clist_index_detach(params->index, item);
+    }
+
+    return result;
+}
+
+/*
+ * a visit callback may delete items, so visiting is writing
+ */
+void clist_concurrent_visit(Clist *list, ClistVisitCallback callback, void *arg) {
+    Clist *inner = __clist_concurrent_impl(list)->inner;
+    ClistConcurrentVisitArg params;
+
+    __clist_concurrent_write(list);
+
+    if (inner->index == NULL) {
+        __clist_visit(inner, callback, arg);
+    } else {
+        params.index = inner->index;
+        params.callback = callback;
+        params.arg = arg;
+
+        __clist_visit(inner, __clist_concurrent_visit_item, &params);
+    }
+
+    __clist_concurrent_unlock(list);
+}
+
+static ClistVtable __clist_concurrent_table = {.create = clist_concurrent_new,
+        .destroy = clist_concurrent_delete,
+        .add = clist_concurrent_add,
+        .add_value = clist_concurrent_add_value,
+        .add_last = clist_concurrent_add_last,
+        .pop_first = clist_concurrent_pop_first,
+        .pop_last = clist_concurrent_pop_last,
+        .add_all = clist_concurrent_add_all,
+        .add_index = clist_concurrent_add_index,
+        .add_all_index = clist_concurrent_add_all_index,
+        .add_batch = clist_concurrent_add_batch,
+        .add_batch_index = clist_concurrent_add_batch_index,
+        .transfer = clist_concurrent_transfer,
+        .clear = clist_concurrent_clear,
+        .contains = clist_concurrent_contains,
+        .contains_all = clist_concurrent_contains_all,
+        .get = clist_concurrent_get,
+        .get_item = clist_concurrent_get_item,
+        .remove = clist_concurrent_remove,
+        .remove_index = clist_concurrent_remove_index,
+        .remove_all = clist_concurrent_remove_all,
+        .index_of = clist_concurrent_index_of,
+        .set = clist_concurrent_set,
+        .size = clist_concurrent_size,
+        .is_empty = clist_concurrent_is_empty,
+        .sort = clist_concurrent_sort,
+        .sort_with = clist_concurrent_sort_with,
+        .sort_by_key = clist_concurrent_sort_by_key,
+        .pool_stats = clist_concurrent_pool_stats,
+        .for_each = clist_concurrent_for_each,
+        .iter_next = clist_concurrent_iter_next,
+        .iter_remove = clist_concurrent_iter_remove,
+        .iter_insert = clist_concurrent_iter_insert,
+        .visit = clist_concurrent_visit};
+
+ClistVtable *__clist_concurrent_vtable() {
+    return &__clist_concurrent_table;
+}
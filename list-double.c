@@ -0,0 +1,939 @@
+#include <assert.h>
+#include <stddef.h>
+#include <stdlib.h>
+
+#include <clist/list-item.h>
+#include "list-vtable.h"
+#include "internal.h"
+
+typedef struct __clist_dlist ClistDList;
+
+typedef struct __clist_dlist_node ClistDListNode;
+
+/*
+ * a node may be fused with its item (and the item data), in a single allocation:
+ * [ node | item | data ], in which case node->item points directly after the node.
+ */
+struct __clist_dlist_node {
+    ClistDListNode *next;
+    ClistDListNode *prev;
+    ClistItem *item;
+};
+
+struct __clist_dlist {
+    ClistDListNode *first;
+    ClistDListNode *last;
+    size_t size;
+    /* the last node found by index, so nearby access walks from it instead of an end */
+    ClistDListNode *cursor;
+    size_t cursor_index;
+};
+
+extern void clist_double_clear(Clist *list);
+
+/*
+ * invalidates the cursor after a change that may shift the nodes before it
+ */
+static inline void __clist_dlist_forget(ClistDList *list) {
+    list->cursor = NULL;
+    list->cursor_index = 0;
+}
+
+static inline ClistDList *__clist_dlist_impl(const Clist *arg) {
+    assert(arg->impl != NULL);
+    return (ClistDList *) arg->impl;
+}
+
+static ClistDListNode *__clist_dlist_node_create(ClistItem *item) {
+    ClistDListNode *node = NULL;
+    assert(item != NULL);
+    node = malloc(sizeof(ClistDListNode));
+    assert(node != NULL);
+    node->next = NULL;
+    node->prev = NULL;
+    node->item = item;
+    return node;
+}
+
+/*
+ * the memory after a node for a fused item
+ */
+static inline void *__clist_dlist_node_slot(const ClistDListNode *node) {
+    return (char *) node + CLIST_ALIGN_HEADER(sizeof(ClistDListNode));
+}
+
+static ClistDListNode *__clist_dlist_node_create_fused(const void *data, size_t size,
+                                                      const ClistItemType *type) {
+    ClistDListNode *node = NULL;
+    node = malloc(CLIST_ALIGN_HEADER(sizeof(ClistDListNode)) + __clist_item_inline_size(size));
+    assert(node != NULL);
+    node->next = NULL;
+    node->prev = NULL;
+    node->item = __clist_item_init_inline(__clist_dlist_node_slot(node), data, size, type);
+    return node;
+}
+
+/*
+ * creates a node with a copy of an item, small plain data is copied inline with the node
+ */
+static ClistDListNode *__clist_dlist_node_copy(const ClistItem *orig) {
+    ClistDListNode *node = NULL;
+
+    if (!__clist_item_copies_inline(orig)) {
+        return __clist_dlist_node_create(clist_item_copy(orig));
+    }
+
+    node = malloc(CLIST_ALIGN_HEADER(sizeof(ClistDListNode)) + __clist_item_inline_size(orig->size));
+    assert(node != NULL);
+    node->next = NULL;
+    node->prev = NULL;
+    node->item = __clist_item_init_copy(__clist_dlist_node_slot(node), orig);
+    return node;
+}
+
+static inline int __clist_dlist_node_is_fused(const ClistDListNode *node) {
+    return node->item == (const ClistItem *) __clist_dlist_node_slot(node);
+}
+
+static void __clist_dlist_node_delete_item(ClistDListNode *node) {
+    if (node->item == NULL) {
+        return;
+    }
+
+    if (__clist_dlist_node_is_fused(node)) {
+        __clist_item_release(node->item);
+    } else {
+        clist_item_delete(node->item);
+    }
+    node->item = NULL;
+}
+
+static void __clist_dlist_node_destroy(ClistDListNode *node) {
+    assert(node != NULL);
+
+    __clist_dlist_node_delete_item(node);
+
+    free(node);
+}
+
+/*
+ * links a node after another node, or at the start of the list if after is NULL
+ */
+static void __clist_dlist_node_link(ClistDList *list, ClistDListNode *after, ClistDListNode *node) {
+    assert(list != NULL);
+    assert(node != NULL);
+
+    node->prev = after;
+
+    if (after == NULL) {
+        node->next = list->first;
+        list->first = node;
+    } else {
+        node->next = after->next;
+        after->next = node;
+    }
+
+    if (node->next == NULL) {
+        list->last = node;
+    } else {
+        node->next->prev = node;
+    }
+
+    list->size++;
+
+    /* linking at the start, the end or after the cursor keeps it valid */
+    if (after == NULL) {
+        if (list->cursor != NULL) {
+            list->cursor_index++;
+        }
+    } else if (after != list->cursor && node->next != NULL) {
+        __clist_dlist_forget(list);
+    }
+}
+
+/*
+ * unlinks a node from the list in constant time
+ */
+static void __clist_dlist_node_unlink(ClistDList *list, ClistDListNode *node) {
+    assert(list != NULL);
+    assert(node != NULL);
+
+    if (list->cursor == node && node->prev != NULL) {
+        list->cursor = node->prev;
+        list->cursor_index--;
+    } else if (list->cursor == node) {
+        __clist_dlist_forget(list);
+    } else if (node->prev == NULL) {
+        if (list->cursor != NULL) {
+            list->cursor_index--;
+        }
+    } else if (list->cursor != NULL && node->next != NULL) {
+        /* only the last node is known to be after the cursor */
+        __clist_dlist_forget(list);
+    }
+
+    if (node->prev == NULL) {
+        list->first = node->next;
+    } else {
+        node->prev->next = node->next;
+    }
+
+    if (node->next == NULL) {
+        list->last = node->prev;
+    } else {
+        node->next->prev = node->prev;
+    }
+
+    node->next = NULL;
+    node->prev = NULL;
+    list->size--;
+}
+
+/*
+ * gets a node by index, walking from whichever of the ends or the cursor is closer
+ */
+static ClistDListNode *__clist_dlist_get_node(const ClistDList *list, size_t index) {
+    /* the cursor is a cache, updating it does not change the list */
+    ClistDList *impl = (ClistDList *) list;
+    ClistDListNode *node = NULL;
+    size_t pos = 0, distance = 0;
+
+    assert(list != NULL);
+
+    if (index >= list->size) {
+        return NULL;
+    }
+
+    if (index < list->size / 2) {
+        node = list->first;
+        distance = index;
+    } else {
+        node = list->last;
+        pos = list->size - 1;
+        distance = pos - index;
+    }
+
+    if (list->cursor != NULL) {
+        if (index >= list->cursor_index ? index - list->cursor_index < distance
+                                         : list->cursor_index - index < distance) {
+            node = list->cursor;
+            pos = list->cursor_index;
+        }
+    }
+
+    for (; pos < index; node = node->next, pos++)
+        ;
+    for (; pos > index; node = node->prev, pos--)
+        ;
+
+    impl->cursor = node;
+    impl->cursor_index = index;
+
+    return node;
+}
+
+static ClistDListNode *__clist_dlist_find_node_data(const ClistDList *list, const void *data) {
+    ClistDListNode *node = NULL;
+
+    assert(list != NULL);
+
+    for (node = list->first; node; node = node->next) {
+        if (clist_item_compare(node->item, data) == 0) {
+            return node;
+        }
+    }
+    return NULL;
+}
+
+static ClistItem *__clist_dlist_node_take(ClistDList *list, ClistDListNode *node) {
+    ClistItem *item = NULL;
+
+    if (node == NULL) {
+        return NULL;
+    }
+
+    __clist_dlist_node_unlink(list, node);
+
+    /* a fused item can't outlive its node */
+    if (__clist_dlist_node_is_fused(node)) {
+        item = clist_item_copy(node->item);
+    } else {
+        item = node->item;
+        node->item = NULL;
+    }
+
+    __clist_dlist_node_destroy(node);
+
+    return item;
+}
+
+void *clist_double_new() {
+    ClistDList *list = malloc(sizeof(ClistDList));
+    assert(list != NULL);
+    list->first = NULL;
+    list->last = NULL;
+    list->size = 0;
+    list->cursor = NULL;
+    list->cursor_index = 0;
+    return list;
+}
+
+void clist_double_delete(Clist *list) {
+    assert(list != NULL);
+
+    clist_double_clear(list);
+
+    free(__clist_dlist_impl(list));
+}
+
+void clist_double_add(Clist *list, ClistItem *item) {
+    assert(list != NULL);
+    assert(item != NULL);
+
+    __clist_dlist_node_link(__clist_dlist_impl(list), NULL, __clist_dlist_node_create(item));
+}
+
+void clist_double_add_value(Clist *list, const void *data, size_t size, ClistCompareCallback comparer) {
+    assert(list != NULL);
+
+    __clist_dlist_node_link(__clist_dlist_impl(list), NULL, __clist_dlist_node_create_fused(
+            data, size, __clist_item_type_intern(comparer, NULL, NULL, NULL)));
+}
+
+void clist_double_add_last(Clist *list, ClistItem *item) {
+    ClistDList *impl = NULL;
+
+    assert(list != NULL);
+    assert(item != NULL);
+
+    impl = __clist_dlist_impl(list);
+
+    __clist_dlist_node_link(impl, impl->last, __clist_dlist_node_create(item));
+}
+
+ClistItem *clist_double_pop_first(Clist *list) {
+    ClistDList *impl = NULL;
+
+    assert(list != NULL);
+
+    impl = __clist_dlist_impl(list);
+
+    return __clist_dlist_node_take(impl, impl->first);
+}
+
+ClistItem *clist_double_pop_last(Clist *list) {
+    ClistDList *impl = NULL;
+
+    assert(list != NULL);
+
+    impl = __clist_dlist_impl(list);
+
+    return __clist_dlist_node_take(impl, impl->last);
+}
+
+void clist_double_add_index(Clist *list, size_t index, ClistItem *item) {
+    ClistDList *impl = NULL;
+    ClistDListNode *node = NULL;
+
+    assert(list != NULL);
+    assert(item != NULL);
+
+    impl = __clist_dlist_impl(list);
+
+    node = __clist_dlist_get_node(impl, index);
+
+    if (node != NULL) {
+        __clist_dlist_node_link(impl, node, __clist_dlist_node_create(item));
+    }
+}
+
+typedef struct __clist_dlist_copy_arg {
+    ClistDList *list;
+    ClistDListNode *after;
+    size_t count;
+} ClistDListCopyArg;
+
+static ClistCallbackReturn __clist_dlist_copy_item(ClistItem *item, void *arg) {
+    ClistDListCopyArg *params = (ClistDListCopyArg *) arg;
+    ClistDListNode *node = NULL;
+
+    /* stop at the copies when adding a list to itself */
+    if (params->count-- == 0) {
+        return ClistIteratorBreak;
+    }
+
+    node = __clist_dlist_node_copy(item);
+
+    __clist_dlist_node_link(params->list, params->after, node);
+
+    params->after = node;
+
+    return ClistIterateNext;
+}
+
+void clist_double_add_all(Clist *list, const Clist *other) {
+    ClistDListCopyArg params;
+
+    assert(list != NULL);
+    assert(other != NULL);
+
+    params.list = __clist_dlist_impl(list);
+    params.after = NULL;
+    params.count = clist_size(other);
+
+    __clist_visit(other, __clist_dlist_copy_item, &params);
+}
+
+void clist_double_add_all_index(Clist *list, size_t index, const Clist *other) {
+    ClistDListCopyArg params;
+
+    assert(list != NULL);
+    assert(other != NULL);
+
+    params.list = __clist_dlist_impl(list);
+    params.after = __clist_dlist_get_node(params.list, index);
+    params.count = clist_size(other);
+
+    if (params.after == NULL) {
+        return;
+    }
+
+    __clist_visit(other, __clist_dlist_copy_item, &params);
+}
+
+/*
+ * links a chain of nodes after a node, or at the start of the list if after is NULL
+ */
+static void __clist_dlist_splice(ClistDList *list, ClistDListNode *after, ClistDListNode *first,
+                                 ClistDListNode *last, size_t count) {
+    first->prev = after;
+    last->next = after ? after->next : list->first;
+
+    if (after) {
+        after->next = first;
+    } else {
+        list->first = first;
+    }
+
+    if (last->next) {
+        last->next->prev = last;
+    } else {
+        list->last = last;
+    }
+
+    list->size += count;
+
+    if (after == NULL) {
+        if (list->cursor != NULL) {
+            list->cursor_index += count;
+        }
+    } else if (after != list->cursor && last->next != NULL) {
+        __clist_dlist_forget(list);
+    }
+}
+
+/*
+ * links nodes for some items after a node, or at the start of the list if after is NULL, in one pass
+ */
+static void __clist_dlist_link_batch(ClistDList *list, ClistDListNode *after, ClistItem **items, size_t count) {
+    ClistDListNode *first = NULL, *last = NULL, *node = NULL;
+    size_t i = 0;
+
+    for (i = 0; i < count; i++) {
+        node = __clist_dlist_node_create(items[i]);
+        node->prev = last;
+        if (last) {
+            last->next = node;
+        } else {
+            first = node;
+        }
+        last = node;
+    }
+
+    __clist_dlist_splice(list, after, first, last, count);
+}
+
+void clist_double_add_batch(Clist *list, ClistItem **items, size_t count) {
+    assert(list != NULL);
+    assert(items != NULL);
+
+    if (count > 0) {
+        __clist_dlist_link_batch(__clist_dlist_impl(list), NULL, items, count);
+    }
+}
+
+void clist_double_add_batch_index(Clist *list, size_t index, ClistItem **items, size_t count) {
+    ClistDList *impl = NULL;
+    ClistDListNode *node = NULL;
+
+    assert(list != NULL);
+    assert(items != NULL);
+
+    impl = __clist_dlist_impl(list);
+
+    node = __clist_dlist_get_node(impl, index);
+
+    if (node != NULL && count > 0) {
+        __clist_dlist_link_batch(impl, node, items, count);
+    }
+}
+
+void clist_double_transfer(Clist *list, size_t index, Clist *other, size_t from, size_t count) {
+    ClistDList *impl = NULL, *source = NULL;
+    ClistDListNode *first = NULL, *last = NULL;
+    size_t i = 0;
+
+    assert(list != NULL);
+    assert(other != NULL);
+
+    impl = __clist_dlist_impl(list);
+    source = __clist_dlist_impl(other);
+
+    assert(index <= impl->size);
+    assert(count > 0 && from + count <= source->size);
+
+    /* cut the range out of the other list */
+    first = __clist_dlist_get_node(source, from);
+
+    for (last = first, i = 1; i < count; i++) {
+        last = last->next;
+    }
+
+    if (first->prev) {
+        first->prev->next = last->next;
+    } else {
+        source->first = last->next;
+    }
+
+    if (last->next) {
+        last->next->prev = first->prev;
+    } else {
+        source->last = first->prev;
+    }
+
+    source->size -= count;
+
+    /* the cursor was left on the first node, resume from the one before it */
+    if (first->prev) {
+        source->cursor = first->prev;
+        source->cursor_index = from - 1;
+    } else {
+        __clist_dlist_forget(source);
+    }
+
+    __clist_dlist_splice(impl, index > 0 ? __clist_dlist_get_node(impl, index - 1) : NULL, first, last, count);
+}
+
+void clist_double_clear(Clist *list) {
+    ClistDList *impl = NULL;
+    ClistDListNode *node = NULL, *next_node = NULL;
+
+    assert(list != NULL);
+
+    impl = __clist_dlist_impl(list);
+
+    for (node = impl->first; node; node = next_node) {
+        next_node = node->next;
+        __clist_dlist_node_destroy(node);
+    }
+    impl->first = NULL;
+    impl->last = NULL;
+    impl->size = 0;
+
+    __clist_dlist_forget(impl);
+}
+
+int clist_double_contains(const Clist *list, const void *data) {
+    if (list == NULL) {
+        return 0;
+    }
+
+    return __clist_dlist_find_node_data(__clist_dlist_impl(list), data) != NULL;
+}
+
+typedef struct __clist_dlist_count_arg {
+    const ClistDList *list;
+    int count;
+} ClistDListCountArg;
+
+static ClistCallbackReturn __clist_dlist_count_found(ClistItem *item, void *arg) {
+    ClistDListCountArg *params = (ClistDListCountArg *) arg;
+
+    if (__clist_dlist_find_node_data(params->list, item->data) != NULL) {
+        params->count++;
+    }
+    return ClistIterateNext;
+}
+
+int clist_double_contains_all(const Clist *list, const Clist *other) {
+    ClistDListCountArg params;
+
+    if (list == NULL || other == NULL) {
+        return 0;
+    }
+
+    params.list = __clist_dlist_impl(list);
+    params.count = 0;
+
+    __clist_visit(other, __clist_dlist_count_found, &params);
+
+    return params.count;
+}
+
+ClistItem *clist_double_get_item(const Clist *list, size_t index) {
+    ClistDListNode *node = NULL;
+
+    if (list == NULL) {
+        return NULL;
+    }
+
+    node = __clist_dlist_get_node(__clist_dlist_impl(list), index);
+
+    if (node == NULL) {
+        return NULL;
+    }
+
+    return node->item;
+}
+
+void *clist_double_get(const Clist *list, size_t index) {
+    ClistItem *item = clist_double_get_item(list, index);
+
+    if (item == NULL) {
+        return NULL;
+    }
+
+    return item->data;
+}
+
+int clist_double_remove(Clist *list, const void *data) {
+    ClistDList *impl = NULL;
+    ClistDListNode *node = NULL;
+
+    if (list == NULL) {
+        return 0;
+    }
+
+    impl = __clist_dlist_impl(list);
+
+    node = __clist_dlist_find_node_data(impl, data);
+
+    if (node == NULL) {
+        return 0;
+    }
+
+    __clist_dlist_node_unlink(impl, node);
+
+    __clist_dlist_node_destroy(node);
+
+    return 1;
+}
+
+int clist_double_remove_item(Clist *list, ClistItem *item) {
+    ClistDList *impl = NULL;
+    ClistDListNode *node = NULL;
+
+    if (list == NULL) {
+        return 0;
+    }
+
+    impl = __clist_dlist_impl(list);
+
+    for (node = impl->first; node && node->item != item; node = node->next) {
+    }
+
+    if (node == NULL) {
+        return 0;
+    }
+
+    __clist_dlist_node_unlink(impl, node);
+
+    __clist_dlist_node_destroy(node);
+
+    return 1;
+}
+
+int clist_double_remove_index(Clist *list, size_t index) {
+    ClistDList *impl = NULL;
+    ClistDListNode *node = NULL;
+
+    if (list == NULL) {
+        return 0;
+    }
+
+    impl = __clist_dlist_impl(list);
+
+    node = __clist_dlist_get_node(impl, index);
+
+    if (node == NULL) {
+        return 0;
+    }
+
+    __clist_dlist_node_unlink(impl, node);
+
+    __clist_dlist_node_destroy(node);
+
+    return 1;
+}
+
+typedef struct __clist_dlist_remove_arg {
+    Clist *list;
+    int count;
+} ClistDListRemoveArg;
+
+static ClistCallbackReturn __clist_dlist_remove_found(ClistItem *item, void *arg) {
+    ClistDListRemoveArg *params = (ClistDListRemoveArg *) arg;
+
+    if (clist_double_remove(params->list, item->data)) {
+        params->count++;
+    }
+    return ClistIterateNext;
+}
+
+int clist_double_remove_all(Clist *list, const Clist *other) {
+    ClistDListRemoveArg params;
+    int result = 0;
+
+    if (list == NULL || other == NULL) {
+        return 0;
+    }
+
+    /* removing a list from itself empties it */
+    if (list == other) {
+        result = (int) __clist_dlist_impl(list)->size;
+        clist_double_clear(list);
+        return result;
+    }
+
+    params.list = list;
+    params.count = 0;
+
+    __clist_visit(other, __clist_dlist_remove_found, &params);
+
+    return params.count;
+}
+
+int clist_double_index_of(const Clist *list, const void *data) {
+    ClistDListNode *node = NULL;
+    int pos = 0;
+
+    if (list == NULL) {
+        return -1;
+    }
+
+    for (node = __clist_dlist_impl(list)->first; node; node = node->next, pos++) {
+        if (clist_item_compare(node->item, data) == 0) {
+            return pos;
+        }
+    }
+
+    return -1;
+}
+
+void clist_double_set(Clist *list, size_t index, ClistItem *item) {
+    ClistDListNode *node = NULL;
+
+    if (list == NULL) {
+        return;
+    }
+
+    node = __clist_dlist_get_node(__clist_dlist_impl(list), index);
+
+    if (node == NULL) {
+        return;
+    }
+
+    __clist_dlist_node_delete_item(node);
+
+    node->item = item;
+}
+
+size_t clist_double_size(const Clist *list) {
+    if (list == NULL) {
+        return 0;
+    }
+
+    return __clist_dlist_impl(list)->size;
+}
+
+int clist_double_is_empty(const Clist *list) {
+    assert(list != NULL);
+    return __clist_dlist_impl(list)->size == 0;
+}
+
+/*
+ * restores the prev links and the last node after sorting the next links
+ */
+static void __clist_dlist_relink(ClistDList *list) {
+    ClistDListNode *node = NULL, *prev = NULL;
+
+    for (node = list->first; node; prev = node, node = node->next) {
+        node->prev = prev;
+    }
+
+    list->last = prev;
+
+    __clist_dlist_forget(list);
+}
+
+void clist_double_sort_with(Clist *list, const ClistSortComparer *comparer) {
+    ClistDList *impl = NULL;
+
+    if (clist_size(list) <= 1) {
+        return;
+    }
+
+    impl = __clist_dlist_impl(list);
+
+    impl->first = __clist_sort_nodes(impl->first, offsetof(ClistDListNode, item), comparer);
+
+    __clist_dlist_relink(impl);
+}
+
+void clist_double_sort(Clist *list) {
+    clist_double_sort_with(list, NULL);
+}
+
+void clist_double_sort_by_key(Clist *list, ClistKeyCallback key, void *ctx) {
+    ClistDList *impl = NULL;
+
+    if (clist_size(list) <= 1) {
+        return;
+    }
+
+    impl = __clist_dlist_impl(list);
+
+    impl->first = __clist_sort_nodes_by_key(impl->first, impl->size, offsetof(ClistDListNode, item), key, ctx);
+
+    __clist_dlist_relink(impl);
+}
+
+void clist_double_for_each(Clist *list, ClistCallback callback) {
+    ClistDList *impl = NULL;
+    ClistDListNode *node = NULL, *next_node = NULL;
+    size_t index = 0;
+
+    assert(list != NULL);
+    assert(callback != NULL);
+
+    impl = __clist_dlist_impl(list);
+
+    for (node = impl->first; node; node = next_node) {
+        next_node = node->next;
+
+        switch (callback(list, index++, node->item)) {
+            case ClistIteratorBreak:
+                return;
+            case ClistIteratorDelete:
+                __clist_dlist_node_unlink(impl, node);
+                __clist_dlist_node_destroy(node);
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+/*
+ * the iterator node is the last node stepped over
+ */
+ClistItem *clist_double_iter_next(ClistIterator *iter) {
+    ClistDList *impl = __clist_dlist_impl(iter->list);
+    ClistDListNode *node = (ClistDListNode *) iter->node;
+
+    if (iter->index >= impl->size) {
+        return NULL;
+    }
+
+    node = node ? node->next : impl->first;
+    iter->node = node;
+    iter->index++;
+
+    return node->item;
+}
+
+void clist_double_iter_remove(ClistIterator *iter) {
+    ClistDList *impl = __clist_dlist_impl(iter->list);
+    ClistDListNode *node = (ClistDListNode *) iter->node;
+
+    iter->node = node->prev;
+    iter->index--;
+
+    __clist_dlist_node_unlink(impl, node);
+    __clist_dlist_node_destroy(node);
+}
+
+int clist_double_iter_insert(ClistIterator *iter, ClistItem *item) {
+    ClistDListNode *node = __clist_dlist_node_create(item);
+
+    __clist_dlist_node_link(__clist_dlist_impl(iter->list), (ClistDListNode *) iter->node, node);
+
+    iter->node = node;
+    iter->index++;
+
+    return 1;
+}
+
+void clist_double_visit(Clist *list, ClistVisitCallback callback, void *arg) {
+    ClistDList *impl = NULL;
+    ClistDListNode *node = NULL, *next_node = NULL;
+
+    assert(list != NULL);
+    assert(callback != NULL);
+
+    impl = __clist_dlist_impl(list);
+
+    for (node = impl->first; node; node = next_node) {
+        next_node = node->next;
+
+        switch (callback(node->item, arg)) {
+            case ClistIteratorBreak:
+                return;
+            case ClistIteratorDelete:
+                __clist_dlist_node_unlink(impl, node);
+                __clist_dlist_node_destroy(node);
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+static ClistVtable __clist_dlist_vtable = {.create = clist_double_new,
+        .destroy = clist_double_delete,
+        .add = clist_double_add,
+        .add_value = clist_double_add_value,
+        .add_last = clist_double_add_last,
+        .pop_first = clist_double_pop_first,
+        .pop_last = clist_double_pop_last,
+        .add_all = clist_double_add_all,
+        .add_index = clist_double_add_index,
+        .add_all_index = clist_double_add_all_index,
+        .add_batch = clist_double_add_batch,
+        .add_batch_index = clist_double_add_batch_index,
+        .transfer = clist_double_transfer,
+        .clear = clist_double_clear,
+        .contains = clist_double_contains,
+        .contains_all = clist_double_contains_all,
+        .get = clist_double_get,
+        .get_item = clist_double_get_item,
+        .remove = clist_double_remove,
+        .remove_item = clist_double_remove_item,
+        .remove_index = clist_double_remove_index,
+        .remove_all = clist_double_remove_all,
+        .index_of = clist_double_index_of,
+        .set = clist_double_set,
+        .size = clist_double_size,
+        .is_empty = clist_double_is_empty,
+        .sort = clist_double_sort,
+        .sort_with = clist_double_sort_with,
+        .sort_by_key = clist_double_sort_by_key,
+        .for_each = clist_double_for_each,
+        .iter_next = clist_double_iter_next,
+        .iter_remove = clist_double_iter_remove,
+        .iter_insert = clist_double_iter_insert,
+        .visit = clist_double_visit};
+
+ClistVtable *__clist_double_vtable() {
+    return &__clist_dlist_vtable;
+}
@@ -0,0 +1,309 @@
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <clist/list-item.h>
+#include "internal.h"
+
+#define CLIST_INDEX_MIN_CAPACITY 16
+
+/*
+ * the items with the same hash, chained through their entries
+ */
+typedef struct __clist_index_key {
+    size_t hash;
+    /* NULL for an empty slot */
+    ClistItem *first;
+    size_t count;
+} ClistIndexKey;
+
+typedef struct __clist_index_entry {
+    /* NULL for an empty slot */
+    ClistItem *item;
+    size_t hash;
+    ClistItem *prev;
+    ClistItem *next;
+} ClistIndexEntry;
+
+/*
+ * a multiset of the items in a list, keyed by the hash of their data.
+ * one table holds a slot per distinct hash, with the number of items and the first of a
+ * chain of them, so equal items don't crowd the table.  another holds a slot per item,
+ * found by its address, with its links in the chain, so an item is removed in constant time.
+ * both use open addressing with linear probing, removals shift the following slots back
+ * so no tombstones are needed, and both are kept at most half full.
+ */
+struct __clist_index {
+    ClistHashCallback hash;
+    ClistIndexKey *keys;
+    size_t key_capacity;
+    size_t key_size;
+    ClistIndexEntry *entries;
+    size_t capacity;
+    size_t size;
+};
+
+static inline size_t __clist_index_mix(uint64_t hash) {
+    hash *= UINT64_C(0x9E3779B97F4A7C15);
+
+    return (size_t) (hash ^ (hash >> 32));
+}
+
+static inline size_t __clist_index_hash(const ClistIndex *index, const void *data) {
+    if (data == NULL) {
+        return 0;
+    }
+
+    /* spread weak hashes, like the identity of an int, over the whole table */
+    return __clist_index_mix((uint64_t) (*index->hash)(data));
+}
+
+static inline size_t __clist_index_key_home(const ClistIndex *index, size_t hash) {
+    return hash & (index->key_capacity - 1);
+}
+
+static inline size_t __clist_index_entry_home(const ClistIndex *index, const ClistItem *item) {
+    return __clist_index_mix((uint64_t) (uintptr_t) item) & (index->capacity - 1);
+}
+
+ClistIndex *__clist_index_new(ClistHashCallback hash) {
+    ClistIndex *index = malloc(sizeof(ClistIndex));
+    assert(index != NULL);
+    assert(hash != NULL);
+    index->hash = hash;
+    index->key_capacity = CLIST_INDEX_MIN_CAPACITY;
+    index->key_size = 0;
+    index->keys = calloc(index->key_capacity, sizeof(ClistIndexKey));
+    assert(index->keys != NULL);
+    index->capacity = CLIST_INDEX_MIN_CAPACITY;
+    index->size = 0;
+    index->entries = calloc(index->capacity, sizeof(ClistIndexEntry));
+    assert(index->entries != NULL);
+    return index;
+}
+
+void __clist_index_delete(ClistIndex *index) {
+    if (index == NULL) {
+        return;
+    }
+
+    free(index->keys);
+    free(index->entries);
+    free(index);
+}
+
+ClistHashCallback __clist_index_hasher(const ClistIndex *index) {
+    assert(index != NULL);
+    return index->hash;
+}
+
+void __clist_index_clear(ClistIndex *index) {
+    assert(index != NULL);
+
+    memset(index->keys, 0, index->key_capacity * sizeof(ClistIndexKey));
+    index->key_size = 0;
+    memset(index->entries, 0, index->capacity * sizeof(ClistIndexEntry));
+    index->size = 0;
+}
+
+/*
+ * @return the slot of a hash, or of where it would go
+ */
+static ClistIndexKey *__clist_index_key(const ClistIndex *index, size_t hash) {
+    size_t pos = __clist_index_key_home(index, hash);
+
+    while (index->keys[pos].first != NULL && index->keys[pos].hash != hash) {
+        pos = (pos + 1) & (index->key_capacity - 1);
+    }
+
+    return index->keys + pos;
+}
+
+/*
+ * @return the slot of an item, or of where it would go
+ */
+static ClistIndexEntry *__clist_index_entry(const ClistIndex *index, const ClistItem *item) {
+    size_t pos = __clist_index_entry_home(index, item);
+
+    while (index->entries[pos].item != NULL && index->entries[pos].item != item) {
+        pos = (pos + 1) & (index->capacity - 1);
+    }
+
+    return index->entries + pos;
+}
+
+static void __clist_index_grow_keys(ClistIndex *index) {
+    ClistIndexKey *keys = index->keys;
+    size_t capacity = index->key_capacity, pos = 0;
+
+    index->key_capacity = capacity * 2;
+    index->keys = calloc(index->key_capacity, sizeof(ClistIndexKey));
+    assert(index->keys != NULL);
+
+    for (pos = 0; pos < capacity; pos++) {
+        if (keys[pos].first != NULL) {
+            *__clist_index_key(index, keys[pos].hash) = keys[pos];
+        }
+    }
+
+    free(keys);
+}
+
+static void __clist_index_grow_entries(ClistIndex *index) {
+    ClistIndexEntry *entries = index->entries;
+    size_t capacity = index->capacity, pos = 0;
+
+    index->capacity = capacity * 2;
+    index->entries = calloc(index->capacity, sizeof(ClistIndexEntry));
+    assert(index->entries != NULL);
+
+    /* the chains link items, not slots, so they survive the move */
+    for (pos = 0; pos < capacity; pos++) {
+        if (entries[pos].item != NULL) {
+            *__clist_index_entry(index, entries[pos].item) = entries[pos];
+        }
+    }
+
+    free(entries);
+}
+
+/*
+ * empties a key slot, shifting back the slots that probed past it
+ */
+static void __clist_index_remove_key(ClistIndex *index, ClistIndexKey *key) {
+    size_t mask = index->key_capacity - 1, pos = (size_t) (key - index->keys), next = 0, home = 0;
+
+    for (next = (pos + 1) & mask; index->keys[next].first != NULL; next = (next + 1) & mask) {
+        home = __clist_index_key_home(index, index->keys[next].hash);
+
+        if (((next - home) & mask) >= ((next - pos) & mask)) {
+            index->keys[pos] = index->keys[next];
+            pos = next;
+        }
+    }
+
+    index->keys[pos].first = NULL;
+    index->key_size--;
+}
+
+/*
+ * empties an item slot, shifting back the slots that probed past it
+ */
+static void __clist_index_remove_entry(ClistIndex *index, ClistIndexEntry *entry) {
+    size_t mask = index->capacity - 1, pos = (size_t) (entry - index->entries), next = 0, home = 0;
+
+    for (next = (pos + 1) & mask; index->entries[next].item != NULL; next = (next + 1) & mask) {
+        home = __clist_index_entry_home(index, index->entries[next].item);
+
+        if (((next - home) & mask) >= ((next - pos) & mask)) {
+            index->entries[pos] = index->entries[next];
+            pos = next;
+        }
+    }
+
+    index->entries[pos].item = NULL;
+    index->size--;
+}
+
+void __clist_index_attach(ClistIndex *index, ClistItem *item) {
+    ClistIndexEntry *entry = NULL;
+    ClistIndexKey *key = NULL;
+    size_t hash = 0;
+
+    assert(index != NULL);
+    assert(item != NULL);
+
+    if ((index->size + 1) * 2 > index->capacity) {
+        __clist_index_grow_entries(index);
+    }
+
+    if ((index->key_size + 1) * 2 > index->key_capacity) {
+        __clist_index_grow_keys(index);
+    }
+
+    hash = __clist_index_hash(index, item->data);
+
+    key = __clist_index_key(index, hash);
+
+    entry = __clist_index_entry(index, item);
+
+    assert(entry->item == NULL);
+
+    entry->item = item;
+    entry->hash = hash;
+    entry->prev = NULL;
+    entry->next = NULL;
+    index->size++;
+
+    if (key->first == NULL) {
+        key->hash = hash;
+        key->count = 0;
+        index->key_size++;
+    } else {
+        entry->next = key->first;
+        __clist_index_entry(index, key->first)->prev = item;
+    }
+
+    key->first = item;
+    key->count++;
+}
+
+void __clist_index_detach(ClistIndex *index, const ClistItem *item) {
+    ClistIndexEntry *entry = NULL;
+    ClistIndexKey *key = NULL;
+
+    assert(index != NULL);
+    assert(item != NULL);
+
+    entry = __clist_index_entry(index, item);
+
+    /* every item in the list should have been attached */
+    if (entry->item == NULL) {
+        return;
+    }
+
+    /* found by the hash it was attached with, the data may have changed since */
+    key = __clist_index_key(index, entry->hash);
+
+    if (entry->prev != NULL) {
+        __clist_index_entry(index, entry->prev)->next = entry->next;
+    } else {
+        key->first = entry->next;
+    }
+
+    if (entry->next != NULL) {
+        __clist_index_entry(index, entry->next)->prev = entry->prev;
+    }
+
+    if (--key->count == 0) {
+        __clist_index_remove_key(index, key);
+    }
+
+    __clist_index_remove_entry(index, entry);
+}
+
+size_t __clist_index_find(const ClistIndex *index, const void *data, ClistItem **found, size_t max) {
+    const ClistIndexKey *key = NULL;
+    ClistItem *item = NULL;
+    size_t count = 0;
+
+    assert(index != NULL);
+
+    key = __clist_index_key(index, __clist_index_hash(index, data));
+
+    /* equal data is in one chain, with any other data of the same hash */
+    for (item = key->first; item != NULL; item = __clist_index_entry(index, item)->next) {
+        if (clist_item_compare(item, data) != 0) {
+            continue;
+        }
+
+        if (count == max) {
+            return count + 1;
+        }
+
+        found[count++] = item;
+    }
+
+    return count;
+}
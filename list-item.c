@@ -1,11 +1,93 @@
-
 #include <assert.h>
+#include <stdatomic.h>
 #include <stdlib.h>
 #include <string.h>
 
 #include "internal.h"
 #include <clist/list-item.h>
 
+#define CLIST_ITEM_DEFAULT_INLINE_THRESHOLD 32
+
+/* copies of plain data up to this size are stored with their item, read by every thread copying */
+static _Atomic size_t __clist_item_inline_threshold = CLIST_ITEM_DEFAULT_INLINE_THRESHOLD;
+
+/*
+ * types for items created without one, shared by all items with the same callbacks.
+ * entries are only ever pushed onto the front, so readers need no lock.
+ */
+static _Atomic(ClistItemType *) __clist_item_types = NULL;
+
+static ClistItemType *__clist_item_type_find(ClistItemType *first, const ClistItemType *last,
+                                             const ClistItemType *type) {
+    ClistItemType *node = NULL;
+
+    for (node = first; node != last; node = node->next) {
+        if (node->comparer == type->comparer && node->allocator == type->allocator &&
+            node->destructor == type->destructor && node->copier == type->copier) {
+            return node;
+        }
+    }
+    return NULL;
+}
+
+const ClistItemType *__clist_item_type_intern(ClistCompareCallback comparer, ClistAllocCallback allocator,
+                                              ClistDestroyCallback destructor, ClistCopyCallback copier) {
+    ClistItemType key = {.allocator = allocator,
+            .destructor = destructor,
+            .copier = copier,
+            .comparer = comparer,
+            .next = NULL};
+    ClistItemType *first = NULL, *found = NULL, *type = NULL;
+
+    first = atomic_load_explicit(&__clist_item_types, memory_order_acquire);
+
+    found = __clist_item_type_find(first, NULL, &key);
+
+    if (found != NULL) {
+        return found;
+    }
+
+    type = malloc(sizeof(ClistItemType));
+    assert(type != NULL);
+    *type = key;
+    type->next = first;
+
+    while (!atomic_compare_exchange_weak_explicit(&__clist_item_types, &type->next, type, memory_order_release,
+                                                  memory_order_acquire)) {
+        /* another thread may have added the same type meanwhile */
+        found = __clist_item_type_find(type->next, first, &key);
+
+        if (found != NULL) {
+            free(type);
+            return found;
+        }
+        first = type->next;
+    }
+
+    return type;
+}
+
+ClistItemType *clist_item_type_new(ClistCompareCallback comparer, ClistAllocCallback allocator,
+                                   ClistDestroyCallback destructor, ClistCopyCallback copier) {
+    ClistItemType *type = malloc(sizeof(ClistItemType));
+    assert(type != NULL);
+    type->allocator = allocator;
+    type->destructor = destructor;
+    type->copier = copier;
+    type->comparer = comparer;
+    type->next = NULL;
+    return type;
+}
+
+void clist_item_type_delete(ClistItemType *type) {
+    free(type);
+}
+
+const ClistItemType *clist_item_type(const ClistItem *item) {
+    assert(item != NULL);
+    return item->type;
+}
+
 ClistItem *clist_item_new(void *data, size_t size, ClistCompareCallback comparer) {
     return clist_item_new_transient(data, size, comparer, malloc, free, memmove);
 }
@@ -18,25 +100,101 @@ ClistItem *clist_item_new_transient(void *data, size_t size,
                                            ClistCompareCallback comparer,
                                            ClistAllocCallback allocator, ClistDestroyCallback destructor,
                                            ClistCopyCallback copier) {
-    ClistItem *item = malloc(sizeof(*item));
+    return clist_item_new_typed(data, size, __clist_item_type_intern(comparer, allocator, destructor, copier));
+}
+
+ClistItem *clist_item_new_typed(void *data, size_t size, const ClistItemType *type) {
+    ClistItem *item = NULL;
+    assert(type != NULL);
+    item = malloc(sizeof(*item));
     assert(item != NULL);
     item->data = data;
     item->size = size;
-    item->allocator = allocator;
-    item->destructor = destructor;
-    item->copier = copier;
-    item->comparer = comparer;
+    item->type = type;
+    return item;
+}
+
+size_t __clist_item_inline_size(size_t size) {
+    return CLIST_ALIGN_HEADER(sizeof(ClistItem)) + size;
+}
+
+ClistItem *__clist_item_init_inline(void *block, const void *data, size_t size, const ClistItemType *type) {
+    ClistItem *item = (ClistItem *) block;
+    assert(item != NULL);
+    assert(type != NULL);
+    item->data = (char *) item + CLIST_ALIGN_HEADER(sizeof(ClistItem));
+    item->size = size;
+    item->type = type;
+    if (data != NULL && size > 0) {
+        memcpy(item->data, data, size);
+    }
     return item;
 }
 
+ClistItem *__clist_item_new_inline(const void *data, size_t size, const ClistItemType *type) {
+    void *block = malloc(__clist_item_inline_size(size));
+    assert(block != NULL);
+    return __clist_item_init_inline(block, data, size, type);
+}
+
+int __clist_item_is_inline(const ClistItem *item) {
+    return item->data == (const void *) ((const char *) item + CLIST_ALIGN_HEADER(sizeof(ClistItem)));
+}
+
+int __clist_item_is_plain(const ClistItem *item) {
+    const ClistItemType *type = item->type;
+
+    return type->allocator && type->copier && (type->destructor == NULL || type->destructor == free);
+}
+
+int __clist_item_copies_inline(const ClistItem *item) {
+    if (__clist_item_is_inline(item)) {
+        return 1;
+    }
+    return item->size <= atomic_load_explicit(&__clist_item_inline_threshold, memory_order_relaxed) &&
+           __clist_item_is_plain(item);
+}
+
+ClistItem *__clist_item_init_copy(void *block, const ClistItem *orig) {
+    ClistItem *item = NULL;
+
+    assert(orig != NULL);
+
+    if (__clist_item_is_inline(orig) || orig->type->copier == NULL) {
+        return __clist_item_init_inline(block, orig->data, orig->size, orig->type);
+    }
+
+    item = __clist_item_init_inline(block, NULL, orig->size, orig->type);
+    if (orig->data != NULL && orig->size > 0) {
+        (*orig->type->copier)(item->data, orig->data, orig->size);
+    }
+    return item;
+}
+
+void clist_item_set_inline_threshold(size_t size) {
+    atomic_store_explicit(&__clist_item_inline_threshold, size, memory_order_relaxed);
+}
+
+size_t clist_item_inline_threshold() {
+    return atomic_load_explicit(&__clist_item_inline_threshold, memory_order_relaxed);
+}
+
+void __clist_item_release(ClistItem *item) {
+    if (item == NULL || __clist_item_is_inline(item)) {
+        return;
+    }
+
+    if (item->data && item->type->destructor) {
+        (*item->type->destructor)(item->data);
+    }
+}
+
 void clist_item_delete(struct __clist_item *item) {
     if (item == NULL) {
         return;
     }
 
-    if (item->data && item->destructor) {
-        (*item->destructor)(item->data);
-    }
+    __clist_item_release(item);
 
     free(item);
 }
@@ -51,25 +209,32 @@ size_t clist_item_size(const ClistItem *item) {
 
 ClistItem *clist_item_copy(const ClistItem *orig) {
     ClistItem *item = NULL;
+    const ClistItemType *type = NULL;
 
     if (orig == NULL) {
         return NULL;
     }
 
+    /* small plain data, and inline data which lives with the original item, are copied inline */
+    if (__clist_item_copies_inline(orig)) {
+        item = malloc(__clist_item_inline_size(orig->size));
+        assert(item != NULL);
+        return __clist_item_init_copy(item, orig);
+    }
+
+    type = orig->type;
+
     item = malloc(sizeof(ClistItem));
     assert(item != NULL);
-    if (orig->copier && orig->allocator) {
-        item->data = (*orig->allocator)(orig->size);
+    if (type->copier && type->allocator) {
+        item->data = (*type->allocator)(orig->size);
         assert(item->data != NULL);
-        (*orig->copier)(item->data, orig->data, orig->size);
+        (*type->copier)(item->data, orig->data, orig->size);
     } else {
         item->data = orig->data;
     }
     item->size = orig->size;
-    item->allocator = orig->allocator;
-    item->destructor = orig->destructor;
-    item->copier = orig->copier;
-    item->comparer = orig->comparer;
+    item->type = type;
 
     return item;
 }
@@ -85,8 +250,8 @@ int clist_item_compare(const ClistItem *item, const void *data) {
         return -1;
     }
 
-    if (item->comparer) {
-        return (*item->comparer)(item->data, data, item->size);
+    if (item->type->comparer) {
+        return (*item->type->comparer)(item->data, data, item->size);
     } else {
         return memcmp(item->data, data, item->size);
     }
@@ -0,0 +1,315 @@
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <clist/list-item.h>
+#include "internal.h"
+
+typedef struct __clist_join_gather_arg {
+    ClistItem **slot;
+} ClistJoinGatherArg;
+
+static ClistCallbackReturn __clist_join_gather_item(ClistItem *item, void *arg) {
+    ClistJoinGatherArg *params = (ClistJoinGatherArg *) arg;
+    *params->slot++ = item;
+    return ClistIterateNext;
+}
+
+/*
+ * copies the item pointers of a list into an array, sorted if a comparison is needed
+ * @param size set to the number of items
+ */
+static ClistItem **__clist_join_gather(const Clist *list, size_t *size, int sorted) {
+    ClistJoinGatherArg params;
+    ClistItem **items = NULL;
+
+    *size = clist_size(list);
+
+    items = malloc((*size ? *size : 1) * sizeof(ClistItem *));
+    assert(items != NULL);
+
+    params.slot = items;
+
+    __clist_visit(list, __clist_join_gather_item, &params);
+
+    if (sorted) {
+        __clist_sort_items(items, *size, NULL);
+    }
+
+    return items;
+}
+
+/*
+ * finds the first of the sorted items matching some data
+ * @return the position of the item, or size if not found
+ */
+static size_t __clist_join_search(ClistItem **items, size_t size, const void *data) {
+    size_t lo = 0, hi = size, mid = 0;
+
+    while (lo < hi) {
+        mid = lo + (hi - lo) / 2;
+
+        if (clist_item_compare(items[mid], data) < 0) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    if (lo < size && clist_item_compare(items[lo], data) == 0) {
+        return lo;
+    }
+    return size;
+}
+
+static ClistCallbackReturn __clist_join_index_item(ClistItem *item, void *arg) {
+    __clist_index_attach((ClistIndex *) arg, item);
+    return ClistIterateNext;
+}
+
+typedef struct __clist_join_arg {
+    /* one of the lists, hashed or sorted */
+    ClistIndex *index;
+    ClistItem **items;
+    size_t size;
+    /* for sorted items, the number matched from the run of equal items starting at each position */
+    size_t *taken;
+    int count;
+} ClistJoinArg;
+
+static ClistCallbackReturn __clist_join_count_found(ClistItem *item, void *arg) {
+    ClistJoinArg *params = (ClistJoinArg *) arg;
+
+    if (params->index != NULL) {
+        if (__clist_index_find(params->index, item->data, NULL, 0) > 0) {
+            params->count++;
+        }
+    } else if (__clist_join_search(params->items, params->size, item->data) < params->size) {
+        params->count++;
+    }
+    return ClistIterateNext;
+}
+
+int __clist_join_contains_all(const Clist *list, const Clist *other, ClistHashCallback hash) {
+    ClistJoinArg params;
+
+    memset(&params, 0, sizeof(params));
+
+    /* hash or sort the list searched, then stream the other list through it */
+    if (hash != NULL) {
+        params.index = __clist_index_new(hash);
+        __clist_visit(list, __clist_join_index_item, params.index);
+    } else {
+        params.items = __clist_join_gather(list, &params.size, 1);
+    }
+
+    __clist_visit(other, __clist_join_count_found, &params);
+
+    __clist_index_delete(params.index);
+    free(params.items);
+
+    return params.count;
+}
+
+/*
+ * deletes an item matching one not yet matched in the other list
+ */
+static ClistCallbackReturn __clist_join_remove_found(ClistItem *item, void *arg) {
+    ClistJoinArg *params = (ClistJoinArg *) arg;
+    ClistItem *found = NULL;
+    size_t first = 0, pos = 0;
+
+    if (params->index != NULL) {
+        if (__clist_index_find(params->index, item->data, &found, 1) == 0) {
+            return ClistIterateNext;
+        }
+        __clist_index_detach(params->index, found);
+    } else {
+        first = __clist_join_search(params->items, params->size, item->data);
+
+        if (first == params->size) {
+            return ClistIterateNext;
+        }
+
+        /* the run is consumed in order, so the next unmatched item follows the matched ones */
+        pos = first + params->taken[first];
+
+        if (pos == params->size || clist_item_compare(params->items[pos], item->data) != 0) {
+            return ClistIterateNext;
+        }
+        params->taken[first]++;
+    }
+
+    params->count++;
+    return ClistIteratorDelete;
+}
+
+int __clist_join_remove_all(Clist *list, const Clist *other, ClistHashCallback hash) {
+    ClistJoinArg params;
+
+    assert(list != other);
+
+    memset(&params, 0, sizeof(params));
+
+    /*
+     * each item in the other list removes one match, so hash or sort the other list
+     * and consume its items as the list is walked, which removes the first matches
+     */
+    if (hash != NULL) {
+        params.index = __clist_index_new(hash);
+        __clist_visit(other, __clist_join_index_item, params.index);
+    } else {
+        params.items = __clist_join_gather(other, &params.size, 1);
+        params.taken = calloc(params.size ? params.size : 1, sizeof(size_t));
+        assert(params.taken != NULL);
+    }
+
+    __clist_visit(list, __clist_join_remove_found, &params);
+
+    __clist_index_delete(params.index);
+    free(params.items);
+    free(params.taken);
+
+    return params.count;
+}
+
+/*
+ * the first of each group of equal items in a list, hashed or sorted
+ */
+typedef struct __clist_join_set {
+    ClistIndex *index;
+    ClistItem **items;
+    size_t size;
+} ClistJoinSet;
+
+static ClistCallbackReturn __clist_join_set_add_item(ClistItem *item, void *arg) {
+    ClistIndex *index = (ClistIndex *) arg;
+
+    if (__clist_index_find(index, item->data, NULL, 0) == 0) {
+        __clist_index_attach(index, item);
+    }
+    return ClistIterateNext;
+}
+
+static void __clist_join_set_init(ClistJoinSet *set, const Clist *list, ClistHashCallback hash) {
+    size_t pos = 0, size = 0;
+
+    memset(set, 0, sizeof(ClistJoinSet));
+
+    if (hash != NULL) {
+        set->index = __clist_index_new(hash);
+        __clist_visit(list, __clist_join_set_add_item, set->index);
+        return;
+    }
+
+    /* the sort is stable, so the first of each run of equal items is the first in the list */
+    set->items = __clist_join_gather(list, &size, 1);
+
+    for (pos = 0; pos < size; pos++) {
+        if (set->size == 0 || clist_item_compare(set->items[set->size - 1], set->items[pos]->data) != 0) {
+            set->items[set->size++] = set->items[pos];
+        }
+    }
+}
+
+/*
+ * @return the first item in the list equal to some data, or NULL
+ */
+static ClistItem *__clist_join_set_find(const ClistJoinSet *set, const void *data) {
+    ClistItem *found = NULL;
+    size_t pos = 0;
+
+    if (set->index != NULL) {
+        __clist_index_find(set->index, data, &found, 1);
+        return found;
+    }
+
+    pos = __clist_join_search(set->items, set->size, data);
+
+    return pos < set->size ? set->items[pos] : NULL;
+}
+
+static void __clist_join_set_free(ClistJoinSet *set) {
+    __clist_index_delete(set->index);
+    free(set->items);
+}
+
+typedef struct __clist_join_select_arg {
+    ClistJoinSet *set;
+    ClistJoinSet *other;
+    /* when the other list is walked, only items not in the list are selected */
+    int exclude;
+    ClistSetOp op;
+    ClistItem **slot;
+} ClistJoinSelectArg;
+
+static ClistCallbackReturn __clist_join_select_item(ClistItem *item, void *arg) {
+    ClistJoinSelectArg *params = (ClistJoinSelectArg *) arg;
+
+    /* later equal items are duplicates */
+    if (__clist_join_set_find(params->set, item->data) != item) {
+        return ClistIterateNext;
+    }
+
+    if (params->exclude) {
+        if (__clist_join_set_find(params->other, item->data) != NULL) {
+            return ClistIterateNext;
+        }
+    } else if (params->op == ClistSetIntersection || params->op == ClistSetDifference) {
+        if ((__clist_join_set_find(params->other, item->data) != NULL) != (params->op == ClistSetIntersection)) {
+            return ClistIterateNext;
+        }
+    }
+
+    *params->slot++ = item;
+    return ClistIterateNext;
+}
+
+size_t __clist_join_select(const Clist *list, const Clist *other, ClistSetOp op, ClistHashCallback hash,
+                           ClistItem ***selected) {
+    ClistJoinSet set, other_set;
+    ClistJoinSelectArg params;
+    ClistItem **items = NULL;
+    size_t size = clist_size(list);
+
+    assert(op == ClistSetUnique || other != NULL);
+
+    if (op == ClistSetUnion) {
+        size += clist_size(other);
+    }
+
+    items = malloc((size ? size : 1) * sizeof(ClistItem *));
+    assert(items != NULL);
+
+    memset(&other_set, 0, sizeof(other_set));
+
+    __clist_join_set_init(&set, list, hash);
+
+    if (op != ClistSetUnique) {
+        __clist_join_set_init(&other_set, other, hash);
+    }
+
+    params.set = &set;
+    params.other = &other_set;
+    params.exclude = 0;
+    params.op = op;
+    params.slot = items;
+
+    __clist_visit(list, __clist_join_select_item, &params);
+
+    /* then the items only in the other list */
+    if (op == ClistSetUnion) {
+        params.set = &other_set;
+        params.other = &set;
+        params.exclude = 1;
+
+        __clist_visit(other, __clist_join_select_item, &params);
+    }
+
+    __clist_join_set_free(&set);
+    __clist_join_set_free(&other_set);
+
+    *selected = items;
+
+    return (size_t) (params.slot - items);
+}
@@ -0,0 +1,266 @@
+#include <assert.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <clist/list-item.h>
+#include "list-vtable.h"
+#include "internal.h"
+
+typedef struct __clist_lockfree_node ClistLockfreeNode;
+typedef struct __clist_lockfree ClistLockfree;
+
+/*
+ * a Treiber stack, items are pushed and popped at the top with a compare and swap.
+ * the top refers to a node by an index, with a count of the changes to the top in the high
+ * bits, so a node popped and pushed again between a thread reading the top and swapping it
+ * doesn't match (the ABA problem).  nodes are kept in blocks that live as long as the stack
+ * and popped nodes are reused through a second stack, so a thread still reading a node that
+ * another thread popped reads valid memory.
+ */
+struct __clist_lockfree_node {
+    ClistItem *item;
+    _Atomic uint64_t next;
+};
+
+/* the nodes in the first block, each block has twice the nodes of the one before */
+#define CLIST_LOCKFREE_BLOCK_SIZE 64
+
+/* enough blocks for every index */
+#define CLIST_LOCKFREE_BLOCKS 26
+
+/* the low bits of a reference are a node index, starting at one, or zero for none */
+#define CLIST_LOCKFREE_INDEX_MASK 0xFFFFFFFFu
+
+struct __clist_lockfree {
+    _Atomic uint64_t top;
+    /* the nodes to reuse */
+    _Atomic uint64_t free;
+    /* at least the number of items, exact when no thread is changing the stack */
+    _Atomic size_t size;
+    /* the number of node indices handed out */
+    _Atomic size_t allocated;
+    _Atomic(ClistLockfreeNode *) blocks[CLIST_LOCKFREE_BLOCKS];
+};
+
+extern void clist_lockfree_clear(Clist *list);
+
+static inline ClistLockfree *__clist_lockfree_impl(const Clist *arg) {
+    assert(arg->impl != NULL);
+    return (ClistLockfree *) arg->impl;
+}
+
+/*
+ * gets the block of a node index
+ * @param offset set to the position of the node in the block
+ */
+static size_t __clist_lockfree_block(uint64_t index, size_t *offset) {
+    size_t pos = (size_t) index - 1;
+    size_t chunks = pos / CLIST_LOCKFREE_BLOCK_SIZE + 1;
+    size_t block = 0;
+
+    while (chunks >> 1) {
+        chunks >>= 1;
+        block++;
+    }
+
+    *offset = pos - CLIST_LOCKFREE_BLOCK_SIZE * (((size_t) 1 << block) - 1);
+
+    return block;
+}
+
+static inline ClistLockfreeNode *__clist_lockfree_node(ClistLockfree *impl, uint64_t index) {
+    size_t offset = 0;
+    size_t block = __clist_lockfree_block(index, &offset);
+
+    return atomic_load_explicit(&impl->blocks[block], memory_order_acquire) + offset;
+}
+
+/*
+ * makes a reference to replace another, counting the change
+ */
+static inline uint64_t __clist_lockfree_ref(uint64_t old, uint64_t index) {
+    return (((old >> 32) + 1) << 32) | index;
+}
+
+static void __clist_lockfree_push(ClistLockfree *impl, _Atomic uint64_t *top, uint64_t index) {
+    ClistLockfreeNode *node = __clist_lockfree_node(impl, index);
+    uint64_t old = atomic_load_explicit(top, memory_order_relaxed);
+
+    do {
+        atomic_store_explicit(&node->next, old & CLIST_LOCKFREE_INDEX_MASK, memory_order_relaxed);
+    } while (!atomic_compare_exchange_weak_explicit(top, &old, __clist_lockfree_ref(old, index),
+                                                    memory_order_release, memory_order_relaxed));
+}
+
+/*
+ * @return the index of the popped node, or zero if there was none
+ */
+static uint64_t __clist_lockfree_pop(ClistLockfree *impl, _Atomic uint64_t *top) {
+    uint64_t old = atomic_load_explicit(top, memory_order_acquire);
+    uint64_t next = 0;
+
+    do {
+        if ((old & CLIST_LOCKFREE_INDEX_MASK) == 0) {
+            return 0;
+        }
+
+        /* the node may be popped and reused meanwhile, then the count no longer matches */
+        next = atomic_load_explicit(&__clist_lockfree_node(impl, old & CLIST_LOCKFREE_INDEX_MASK)->next,
+                                    memory_order_relaxed);
+    } while (!atomic_compare_exchange_weak_explicit(top, &old, __clist_lockfree_ref(old, next), memory_order_acquire,
+                                                    memory_order_acquire));
+
+    return old & CLIST_LOCKFREE_INDEX_MASK;
+}
+
+/*
+ * gets a node to push, reusing a popped node or making a new one
+ * @return the node index
+ */
+static uint64_t __clist_lockfree_alloc(ClistLockfree *impl) {
+    ClistLockfreeNode *nodes = NULL, *expected = NULL;
+    uint64_t index = __clist_lockfree_pop(impl, &impl->free);
+    size_t offset = 0, block = 0;
+
+    if (index != 0) {
+        return index;
+    }
+
+    index = atomic_fetch_add_explicit(&impl->allocated, 1, memory_order_relaxed) + 1;
+
+    assert(index <= CLIST_LOCKFREE_INDEX_MASK);
+
+    block = __clist_lockfree_block(index, &offset);
+
+    if (atomic_load_explicit(&impl->blocks[block], memory_order_acquire) != NULL) {
+        return index;
+    }
+
+    /* threads making nodes in a new block race to add it, the others free theirs */
+    nodes = calloc((size_t) CLIST_LOCKFREE_BLOCK_SIZE << block, sizeof(ClistLockfreeNode));
+    assert(nodes != NULL);
+
+    if (!atomic_compare_exchange_strong_explicit(&impl->blocks[block], &expected, nodes, memory_order_acq_rel,
+                                                 memory_order_acquire)) {
+        free(nodes);
+    }
+
+    return index;
+}
+
+void *clist_lockfree_new() {
+    ClistLockfree *impl = malloc(sizeof(ClistLockfree));
+    size_t i = 0;
+
+    assert(impl != NULL);
+
+    atomic_init(&impl->top, 0);
+    atomic_init(&impl->free, 0);
+    atomic_init(&impl->size, 0);
+    atomic_init(&impl->allocated, 0);
+
+    for (i = 0; i < CLIST_LOCKFREE_BLOCKS; i++) {
+        atomic_init(&impl->blocks[i], NULL);
+    }
+
+    return impl;
+}
+
+void clist_lockfree_delete(Clist *list) {
+    ClistLockfree *impl = NULL;
+    size_t i = 0;
+
+    assert(list != NULL);
+
+    clist_lockfree_clear(list);
+
+    impl = __clist_lockfree_impl(list);
+
+    for (i = 0; i < CLIST_LOCKFREE_BLOCKS; i++) {
+        free(atomic_load_explicit(&impl->blocks[i], memory_order_relaxed));
+    }
+
+    free(impl);
+}
+
+void clist_lockfree_add(Clist *list, ClistItem *item) {
+    ClistLockfree *impl = NULL;
+    uint64_t index = 0;
+
+    assert(list != NULL);
+
+    if (item == NULL) {
+        return;
+    }
+
+    impl = __clist_lockfree_impl(list);
+
+    index = __clist_lockfree_alloc(impl);
+
+    __clist_lockfree_node(impl, index)->item = item;
+
+    /* counted before the item can be popped, so the size never drops below zero */
+    atomic_fetch_add_explicit(&impl->size, 1, memory_order_relaxed);
+
+    __clist_lockfree_push(impl, &impl->top, index);
+}
+
+ClistItem *clist_lockfree_pop_first(Clist *list) {
+    ClistLockfree *impl = NULL;
+    ClistItem *item = NULL;
+    uint64_t index = 0;
+
+    assert(list != NULL);
+
+    impl = __clist_lockfree_impl(list);
+
+    index = __clist_lockfree_pop(impl, &impl->top);
+
+    if (index == 0) {
+        return NULL;
+    }
+
+    item = __clist_lockfree_node(impl, index)->item;
+
+    __clist_lockfree_push(impl, &impl->free, index);
+
+    atomic_fetch_sub_explicit(&impl->size, 1, memory_order_relaxed);
+
+    return item;
+}
+
+void clist_lockfree_clear(Clist *list) {
+    ClistItem *item = NULL;
+
+    while ((item = clist_lockfree_pop_first(list)) != NULL) {
+        clist_item_delete(item);
+    }
+}
+
+size_t clist_lockfree_size(const Clist *list) {
+    if (list == NULL) {
+        return 0;
+    }
+
+    return atomic_load_explicit(&__clist_lockfree_impl(list)->size, memory_order_relaxed);
+}
+
+int clist_lockfree_is_empty(const Clist *list) {
+    assert(list != NULL);
+
+    return (atomic_load_explicit(&__clist_lockfree_impl(list)->top, memory_order_acquire) &
+            CLIST_LOCKFREE_INDEX_MASK) == 0;
+}
+
+static ClistVtable __clist_lockfree_table = {.create = clist_lockfree_new,
+        .destroy = clist_lockfree_delete,
+        .add = clist_lockfree_add,
+        .pop_first = clist_lockfree_pop_first,
+        .clear = clist_lockfree_clear,
+        .size = clist_lockfree_size,
+        .is_empty = clist_lockfree_is_empty};
+
+ClistVtable *__clist_lockfree_vtable() {
+    return &__clist_lockfree_table;
+}
@@ -0,0 +1,810 @@
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <clist/list-item.h>
+#include "list-vtable.h"
+#include "internal.h"
+
+/*
+ * enough levels for any list, each level holds about a quarter of the nodes below it
+ */
+#define CLIST_ORDERED_MAX_LEVEL 32
+
+typedef struct __clist_ordered ClistOrdered;
+
+typedef struct __clist_ordered_node ClistOrderedNode;
+
+typedef struct __clist_ordered_link {
+    ClistOrderedNode *next;
+    /* the number of nodes moved past by following the link */
+    size_t span;
+} ClistOrderedLink;
+
+/*
+ * a skip list node, with one link per level.
+ * a node may be fused with its item (and the item data), in a single allocation:
+ * [ node | links | item | data ], in which case node->item points after the links, each part aligned for any type.
+ */
+struct __clist_ordered_node {
+    ClistItem *item;
+    size_t level;
+    ClistOrderedLink links[];
+};
+
+struct __clist_ordered {
+    /* the links at the start of the list, for each level in use */
+    ClistOrderedLink head[CLIST_ORDERED_MAX_LEVEL];
+    size_t level;
+    size_t size;
+    /* state for picking node levels */
+    uint64_t seed;
+};
+
+extern void clist_ordered_clear(Clist *list);
+
+static inline ClistOrdered *__clist_ordered_impl(const Clist *arg) {
+    assert(arg->impl != NULL);
+    return (ClistOrdered *) arg->impl;
+}
+
+/*
+ * picks the level of a new node, each level a quarter as likely as the one below
+ */
+static size_t __clist_ordered_random_level(ClistOrdered *list) {
+    uint64_t bits = list->seed;
+    size_t level = 1;
+
+    /* xorshift */
+    bits ^= bits << 13;
+    bits ^= bits >> 7;
+    bits ^= bits << 17;
+
+    list->seed = bits;
+
+    while (level < CLIST_ORDERED_MAX_LEVEL && (bits & 3) == 0) {
+        level++;
+        bits >>= 2;
+    }
+    return level;
+}
+
+/*
+ * the size of a node with its links, before a fused item
+ */
+static inline size_t __clist_ordered_node_header(size_t level) {
+    return CLIST_ALIGN_HEADER(sizeof(ClistOrderedNode) + level * sizeof(ClistOrderedLink));
+}
+
+/*
+ * the memory after the links of a node for a fused item
+ */
+static inline void *__clist_ordered_node_slot(const ClistOrderedNode *node) {
+    return (char *) node + __clist_ordered_node_header(node->level);
+}
+
+static ClistOrderedNode *__clist_ordered_node_alloc(ClistOrdered *list, size_t extra) {
+    ClistOrderedNode *node = NULL;
+    size_t level = __clist_ordered_random_level(list);
+
+    node = malloc(__clist_ordered_node_header(level) + extra);
+    assert(node != NULL);
+    node->item = NULL;
+    node->level = level;
+    return node;
+}
+
+static ClistOrderedNode *__clist_ordered_node_create(ClistOrdered *list, ClistItem *item) {
+    ClistOrderedNode *node = NULL;
+    assert(item != NULL);
+    node = __clist_ordered_node_alloc(list, 0);
+    node->item = item;
+    return node;
+}
+
+static ClistOrderedNode *__clist_ordered_node_create_fused(ClistOrdered *list, const void *data, size_t size,
+                                                          const ClistItemType *type) {
+    ClistOrderedNode *node = __clist_ordered_node_alloc(list, __clist_item_inline_size(size));
+    node->item = __clist_item_init_inline(__clist_ordered_node_slot(node), data, size, type);
+    return node;
+}
+
+/*
+ * creates a node with a copy of an item, small plain data is copied inline with the node
+ */
+static ClistOrderedNode *__clist_ordered_node_copy(ClistOrdered *list, const ClistItem *orig) {
+    ClistOrderedNode *node = NULL;
+
+    if (!__clist_item_copies_inline(orig)) {
+        return __clist_ordered_node_create(list, clist_item_copy(orig));
+    }
+
+    node = __clist_ordered_node_alloc(list, __clist_item_inline_size(orig->size));
+    node->item = __clist_item_init_copy(__clist_ordered_node_slot(node), orig);
+    return node;
+}
+
+static inline int __clist_ordered_node_is_fused(const ClistOrderedNode *node) {
+    return node->item == (const ClistItem *) __clist_ordered_node_slot(node);
+}
+
+static void __clist_ordered_node_destroy(ClistOrderedNode *node) {
+    assert(node != NULL);
+
+    if (__clist_ordered_node_is_fused(node)) {
+        __clist_item_release(node->item);
+    } else {
+        clist_item_delete(node->item);
+    }
+
+    free(node);
+}
+
+/*
+ * links a node after any equal items, so items keep the order they were added in
+ * @return the index of the node
+ */
+static size_t __clist_ordered_insert(ClistOrdered *list, ClistOrderedNode *node) {
+    ClistOrderedLink *update[CLIST_ORDERED_MAX_LEVEL];
+    size_t rank[CLIST_ORDERED_MAX_LEVEL];
+    ClistOrderedLink *links = list->head;
+    size_t i = 0, pos = 0;
+
+    for (i = list->level; i-- > 0;) {
+        while (links[i].next && clist_item_compare(links[i].next->item, node->item->data) <= 0) {
+            pos += links[i].span;
+            links = links[i].next->links;
+        }
+        update[i] = links;
+        rank[i] = pos;
+    }
+
+    for (i = list->level; i < node->level; i++) {
+        list->head[i].next = NULL;
+        list->head[i].span = list->size;
+        update[i] = list->head;
+        rank[i] = 0;
+    }
+
+    if (node->level > list->level) {
+        list->level = node->level;
+    }
+
+    for (i = 0; i < node->level; i++) {
+        node->links[i].next = update[i][i].next;
+        node->links[i].span = update[i][i].span - (pos - rank[i]);
+        update[i][i].next = node;
+        update[i][i].span = pos - rank[i] + 1;
+    }
+
+    /* the links passing over the node */
+    for (i = node->level; i < list->level; i++) {
+        update[i][i].span++;
+    }
+
+    list->size++;
+
+    return pos;
+}
+
+/*
+ * unlinks a node, given the links before it on each level
+ */
+static void __clist_ordered_unlink(ClistOrdered *list, ClistOrderedLink **update, ClistOrderedNode *node) {
+    size_t i = 0;
+
+    for (i = 0; i < list->level; i++) {
+        if (update[i][i].next == node) {
+            update[i][i].span += node->links[i].span - 1;
+            update[i][i].next = node->links[i].next;
+        } else {
+            update[i][i].span--;
+        }
+    }
+
+    while (list->level > 1 && list->head[list->level - 1].next == NULL) {
+        list->level--;
+    }
+
+    list->size--;
+}
+
+/*
+ * finds the node at an index in O(log n) by adding up the spans
+ * @param update filled with the links before the node on each level, can be NULL
+ */
+static ClistOrderedNode *__clist_ordered_find_index(const ClistOrdered *list, size_t index,
+                                                    ClistOrderedLink **update) {
+    ClistOrderedLink *links = (ClistOrderedLink *) list->head;
+    size_t i = 0, pos = 0;
+
+    if (index >= list->size) {
+        return NULL;
+    }
+
+    for (i = list->level; i-- > 0;) {
+        while (links[i].next && pos + links[i].span <= index) {
+            pos += links[i].span;
+            links = links[i].next->links;
+        }
+        if (update != NULL) {
+            update[i] = links;
+        }
+    }
+
+    return links[0].next;
+}
+
+/*
+ * finds the first node matching some data in O(log n)
+ * @param update filled with the links before the node on each level, can be NULL
+ * @param index set to the index of the node, can be NULL
+ */
+static ClistOrderedNode *__clist_ordered_find_data(const ClistOrdered *list, const void *data,
+                                                   ClistOrderedLink **update, size_t *index) {
+    ClistOrderedLink *links = (ClistOrderedLink *) list->head;
+    ClistOrderedNode *node = NULL;
+    size_t i = 0, pos = 0;
+
+    for (i = list->level; i-- > 0;) {
+        while (links[i].next && clist_item_compare(links[i].next->item, data) < 0) {
+            pos += links[i].span;
+            links = links[i].next->links;
+        }
+        if (update != NULL) {
+            update[i] = links;
+        }
+    }
+
+    node = links[0].next;
+
+    if (node == NULL || clist_item_compare(node->item, data) != 0) {
+        return NULL;
+    }
+
+    if (index != NULL) {
+        *index = pos;
+    }
+    return node;
+}
+
+/*
+ * removes and destroys the node at an index
+ */
+static int __clist_ordered_delete_index(ClistOrdered *list, size_t index) {
+    ClistOrderedLink *update[CLIST_ORDERED_MAX_LEVEL];
+    ClistOrderedNode *node = __clist_ordered_find_index(list, index, update);
+
+    if (node == NULL) {
+        return 0;
+    }
+
+    __clist_ordered_unlink(list, update, node);
+
+    __clist_ordered_node_destroy(node);
+
+    return 1;
+}
+
+static ClistItem *__clist_ordered_take_index(ClistOrdered *list, size_t index) {
+    ClistOrderedLink *update[CLIST_ORDERED_MAX_LEVEL];
+    ClistOrderedNode *node = __clist_ordered_find_index(list, index, update);
+    ClistItem *item = NULL;
+
+    if (node == NULL) {
+        return NULL;
+    }
+
+    __clist_ordered_unlink(list, update, node);
+
+    /* a fused item can't outlive its node */
+    if (__clist_ordered_node_is_fused(node)) {
+        item = clist_item_copy(node->item);
+        __clist_item_release(node->item);
+    } else {
+        item = node->item;
+    }
+
+    free(node);
+
+    return item;
+}
+
+void *clist_ordered_new() {
+    ClistOrdered *list = malloc(sizeof(ClistOrdered));
+    assert(list != NULL);
+    memset(list->head, 0, sizeof(list->head));
+    list->level = 1;
+    list->size = 0;
+    list->seed = UINT64_C(0x9E3779B97F4A7C15);
+    return list;
+}
+
+void clist_ordered_delete(Clist *list) {
+    assert(list != NULL);
+
+    clist_ordered_clear(list);
+
+    free(__clist_ordered_impl(list));
+}
+
+void clist_ordered_add(Clist *list, ClistItem *item) {
+    ClistOrdered *impl = NULL;
+
+    assert(list != NULL);
+    assert(item != NULL);
+
+    impl = __clist_ordered_impl(list);
+
+    __clist_ordered_insert(impl, __clist_ordered_node_create(impl, item));
+}
+
+void clist_ordered_add_value(Clist *list, const void *data, size_t size, ClistCompareCallback comparer) {
+    ClistOrdered *impl = NULL;
+
+    assert(list != NULL);
+
+    impl = __clist_ordered_impl(list);
+
+    __clist_ordered_insert(impl, __clist_ordered_node_create_fused(
+            impl, data, size, __clist_item_type_intern(comparer, NULL, NULL, NULL)));
+}
+
+ClistItem *clist_ordered_pop_first(Clist *list) {
+    assert(list != NULL);
+
+    return __clist_ordered_take_index(__clist_ordered_impl(list), 0);
+}
+
+ClistItem *clist_ordered_pop_last(Clist *list) {
+    ClistOrdered *impl = NULL;
+
+    assert(list != NULL);
+
+    impl = __clist_ordered_impl(list);
+
+    if (impl->size == 0) {
+        return NULL;
+    }
+
+    return __clist_ordered_take_index(impl, impl->size - 1);
+}
+
+void clist_ordered_add_index(Clist *list, size_t index, ClistItem *item) {
+    assert(list != NULL);
+    assert(item != NULL);
+
+    /* the position is decided by the item, but the index must still exist */
+    if (index < __clist_ordered_impl(list)->size) {
+        clist_ordered_add(list, item);
+    }
+}
+
+static ClistCallbackReturn __clist_ordered_gather_item(ClistItem *item, void *arg) {
+    ClistItem ***slot = (ClistItem ***) arg;
+    *(*slot)++ = item;
+    return ClistIterateNext;
+}
+
+void clist_ordered_add_all(Clist *list, const Clist *other) {
+    ClistOrdered *impl = NULL;
+    ClistItem **items = NULL, **slot = NULL;
+    size_t size = 0, pos = 0;
+
+    assert(list != NULL);
+    assert(other != NULL);
+
+    impl = __clist_ordered_impl(list);
+
+    /* the copies are inserted among the items, so take the items first in case it is the same list */
+    size = clist_size(other);
+
+    items = malloc((size ? size : 1) * sizeof(ClistItem *));
+    assert(items != NULL);
+
+    slot = items;
+
+    __clist_visit(other, __clist_ordered_gather_item, &slot);
+
+    for (pos = 0; pos < size; pos++) {
+        __clist_ordered_insert(impl, __clist_ordered_node_copy(impl, items[pos]));
+    }
+
+    free(items);
+}
+
+void clist_ordered_add_all_index(Clist *list, size_t index, const Clist *other) {
+    assert(list != NULL);
+    assert(other != NULL);
+
+    if (index < __clist_ordered_impl(list)->size) {
+        clist_ordered_add_all(list, other);
+    }
+}
+
+void clist_ordered_add_batch(Clist *list, ClistItem **items, size_t count) {
+    ClistOrdered *impl = NULL;
+    size_t pos = 0;
+
+    assert(list != NULL);
+    assert(items != NULL);
+
+    impl = __clist_ordered_impl(list);
+
+    /* each item goes where it belongs */
+    for (pos = 0; pos < count; pos++) {
+        __clist_ordered_insert(impl, __clist_ordered_node_create(impl, items[pos]));
+    }
+}
+
+void clist_ordered_add_batch_index(Clist *list, size_t index, ClistItem **items, size_t count) {
+    assert(list != NULL);
+    assert(items != NULL);
+
+    if (index < __clist_ordered_impl(list)->size) {
+        clist_ordered_add_batch(list, items, count);
+    }
+}
+
+void clist_ordered_transfer(Clist *list, size_t index, Clist *other, size_t from, size_t count) {
+    ClistOrderedLink *update[CLIST_ORDERED_MAX_LEVEL];
+    ClistOrdered *impl = NULL, *other_impl = NULL;
+    ClistOrderedNode *node = NULL;
+    size_t i = 0;
+
+    assert(list != NULL);
+    assert(other != NULL);
+
+    (void) index;
+
+    impl = __clist_ordered_impl(list);
+    other_impl = __clist_ordered_impl(other);
+
+    assert(count > 0 && from + count <= other_impl->size);
+
+    /* the nodes are relinked where they belong, regardless of the index */
+    for (i = 0; i < count; i++) {
+        node = __clist_ordered_find_index(other_impl, from, update);
+        __clist_ordered_unlink(other_impl, update, node);
+        __clist_ordered_insert(impl, node);
+    }
+}
+
+void clist_ordered_clear(Clist *list) {
+    ClistOrdered *impl = NULL;
+    ClistOrderedNode *node = NULL, *next_node = NULL;
+
+    assert(list != NULL);
+
+    impl = __clist_ordered_impl(list);
+
+    for (node = impl->head[0].next; node; node = next_node) {
+        next_node = node->links[0].next;
+        __clist_ordered_node_destroy(node);
+    }
+
+    memset(impl->head, 0, sizeof(impl->head));
+    impl->level = 1;
+    impl->size = 0;
+}
+
+int clist_ordered_contains(const Clist *list, const void *data) {
+    if (list == NULL) {
+        return 0;
+    }
+
+    return __clist_ordered_find_data(__clist_ordered_impl(list), data, NULL, NULL) != NULL;
+}
+
+typedef struct __clist_ordered_count_arg {
+    const ClistOrdered *list;
+    int count;
+} ClistOrderedCountArg;
+
+static ClistCallbackReturn __clist_ordered_count_found(ClistItem *item, void *arg) {
+    ClistOrderedCountArg *params = (ClistOrderedCountArg *) arg;
+
+    if (__clist_ordered_find_data(params->list, item->data, NULL, NULL) != NULL) {
+        params->count++;
+    }
+    return ClistIterateNext;
+}
+
+int clist_ordered_contains_all(const Clist *list, const Clist *other) {
+    ClistOrderedCountArg params;
+
+    if (list == NULL || other == NULL) {
+        return 0;
+    }
+
+    params.list = __clist_ordered_impl(list);
+    params.count = 0;
+
+    __clist_visit(other, __clist_ordered_count_found, &params);
+
+    return params.count;
+}
+
+ClistItem *clist_ordered_get_item(const Clist *list, size_t index) {
+    ClistOrderedNode *node = NULL;
+
+    if (list == NULL) {
+        return NULL;
+    }
+
+    node = __clist_ordered_find_index(__clist_ordered_impl(list), index, NULL);
+
+    if (node == NULL) {
+        return NULL;
+    }
+
+    return node->item;
+}
+
+void *clist_ordered_get(const Clist *list, size_t index) {
+    ClistItem *item = clist_ordered_get_item(list, index);
+
+    if (item == NULL) {
+        return NULL;
+    }
+
+    return item->data;
+}
+
+int clist_ordered_remove(Clist *list, const void *data) {
+    ClistOrderedLink *update[CLIST_ORDERED_MAX_LEVEL];
+    ClistOrdered *impl = NULL;
+    ClistOrderedNode *node = NULL;
+
+    if (list == NULL) {
+        return 0;
+    }
+
+    impl = __clist_ordered_impl(list);
+
+    node = __clist_ordered_find_data(impl, data, update, NULL);
+
+    if (node == NULL) {
+        return 0;
+    }
+
+    __clist_ordered_unlink(impl, update, node);
+
+    __clist_ordered_node_destroy(node);
+
+    return 1;
+}
+
+int clist_ordered_remove_index(Clist *list, size_t index) {
+    if (list == NULL) {
+        return 0;
+    }
+
+    return __clist_ordered_delete_index(__clist_ordered_impl(list), index);
+}
+
+typedef struct __clist_ordered_remove_arg {
+    Clist *list;
+    int count;
+} ClistOrderedRemoveArg;
+
+static ClistCallbackReturn __clist_ordered_remove_found(ClistItem *item, void *arg) {
+    ClistOrderedRemoveArg *params = (ClistOrderedRemoveArg *) arg;
+
+    if (clist_ordered_remove(params->list, item->data)) {
+        params->count++;
+    }
+    return ClistIterateNext;
+}
+
+int clist_ordered_remove_all(Clist *list, const Clist *other) {
+    ClistOrderedRemoveArg params;
+    int result = 0;
+
+    if (list == NULL || other == NULL) {
+        return 0;
+    }
+
+    /* removing a list from itself empties it */
+    if (list == other) {
+        result = (int) __clist_ordered_impl(list)->size;
+        clist_ordered_clear(list);
+        return result;
+    }
+
+    params.list = list;
+    params.count = 0;
+
+    __clist_visit(other, __clist_ordered_remove_found, &params);
+
+    return params.count;
+}
+
+int clist_ordered_index_of(const Clist *list, const void *data) {
+    size_t index = 0;
+
+    if (list == NULL) {
+        return -1;
+    }
+
+    if (__clist_ordered_find_data(__clist_ordered_impl(list), data, NULL, &index) == NULL) {
+        return -1;
+    }
+
+    return (int) index;
+}
+
+void clist_ordered_set(Clist *list, size_t index, ClistItem *item) {
+    if (list == NULL) {
+        return;
+    }
+
+    /* the new item takes its own place in the order */
+    if (__clist_ordered_delete_index(__clist_ordered_impl(list), index)) {
+        clist_ordered_add(list, item);
+    }
+}
+
+size_t clist_ordered_size(const Clist *list) {
+    if (list == NULL) {
+        return 0;
+    }
+
+    return __clist_ordered_impl(list)->size;
+}
+
+int clist_ordered_is_empty(const Clist *list) {
+    assert(list != NULL);
+    return __clist_ordered_impl(list)->size == 0;
+}
+
+/*
+ * the items are always in the order of their compare function
+ */
+void clist_ordered_sort(Clist *list) {
+    assert(list != NULL);
+}
+
+/*
+ * sorting an ordered list is deliberately a no-op, whatever the order asked for
+ */
+void clist_ordered_sort_with(Clist *list, const ClistSortComparer *comparer) {
+    assert(list != NULL);
+    (void) comparer;
+}
+
+void clist_ordered_sort_by_key(Clist *list, ClistKeyCallback key, void *ctx) {
+    assert(list != NULL);
+    (void) key;
+    (void) ctx;
+}
+
+void clist_ordered_for_each(Clist *list, ClistCallback callback) {
+    ClistOrdered *impl = NULL;
+    ClistOrderedNode *node = NULL, *next_node = NULL;
+    size_t index = 0, pos = 0;
+
+    assert(list != NULL);
+    assert(callback != NULL);
+
+    impl = __clist_ordered_impl(list);
+
+    for (node = impl->head[0].next; node; node = next_node) {
+        next_node = node->links[0].next;
+
+        switch (callback(list, index++, node->item)) {
+            case ClistIteratorBreak:
+                return;
+            case ClistIteratorDelete:
+                __clist_ordered_delete_index(impl, pos);
+                break;
+            default:
+                pos++;
+                break;
+        }
+    }
+}
+
+void clist_ordered_visit(Clist *list, ClistVisitCallback callback, void *arg) {
+    ClistOrdered *impl = NULL;
+    ClistOrderedNode *node = NULL, *next_node = NULL;
+    size_t pos = 0;
+
+    assert(list != NULL);
+    assert(callback != NULL);
+
+    impl = __clist_ordered_impl(list);
+
+    for (node = impl->head[0].next; node; node = next_node) {
+        next_node = node->links[0].next;
+
+        switch (callback(node->item, arg)) {
+            case ClistIteratorBreak:
+                return;
+            case ClistIteratorDelete:
+                __clist_ordered_delete_index(impl, pos);
+                break;
+            default:
+                pos++;
+                break;
+        }
+    }
+}
+
+/*
+ * the iterator node is the last node stepped over
+ */
+ClistItem *clist_ordered_iter_next(ClistIterator *iter) {
+    ClistOrdered *impl = __clist_ordered_impl(iter->list);
+    ClistOrderedNode *node = (ClistOrderedNode *) iter->node;
+
+    if (iter->index >= impl->size) {
+        return NULL;
+    }
+
+    node = node ? node->links[0].next : impl->head[0].next;
+    iter->node = node;
+    iter->index++;
+
+    return node->item;
+}
+
+void clist_ordered_iter_remove(ClistIterator *iter) {
+    ClistOrdered *impl = __clist_ordered_impl(iter->list);
+
+    iter->index--;
+
+    __clist_ordered_delete_index(impl, iter->index);
+
+    iter->node = iter->index > 0 ? __clist_ordered_find_index(impl, iter->index - 1, NULL) : NULL;
+}
+
+int clist_ordered_iter_insert(ClistIterator *iter, ClistItem *item) {
+    ClistOrdered *impl = __clist_ordered_impl(iter->list);
+
+    /* the item goes where it belongs, the iterator only moves past it if that is before the iterator */
+    if (__clist_ordered_insert(impl, __clist_ordered_node_create(impl, item)) < iter->index) {
+        iter->index++;
+    }
+
+    return 1;
+}
+
+static ClistVtable __clist_ordered_table = {.create = clist_ordered_new,
+        .destroy = clist_ordered_delete,
+        .add = clist_ordered_add,
+        .add_value = clist_ordered_add_value,
+        .add_last = clist_ordered_add,
+        .pop_first = clist_ordered_pop_first,
+        .pop_last = clist_ordered_pop_last,
+        .add_all = clist_ordered_add_all,
+        .add_index = clist_ordered_add_index,
+        .add_all_index = clist_ordered_add_all_index,
+        .add_batch = clist_ordered_add_batch,
+        .add_batch_index = clist_ordered_add_batch_index,
+        .transfer = clist_ordered_transfer,
+        .clear = clist_ordered_clear,
+        .contains = clist_ordered_contains,
+        .contains_all = clist_ordered_contains_all,
+        .get = clist_ordered_get,
+        .get_item = clist_ordered_get_item,
+        .remove = clist_ordered_remove,
+        .remove_index = clist_ordered_remove_index,
+        .remove_all = clist_ordered_remove_all,
+        .index_of = clist_ordered_index_of,
+        .set = clist_ordered_set,
+        .size = clist_ordered_size,
+        .is_empty = clist_ordered_is_empty,
+        .sort = clist_ordered_sort,
+        .sort_with = clist_ordered_sort_with,
+        .sort_by_key = clist_ordered_sort_by_key,
+        .for_each = clist_ordered_for_each,
+        .iter_next = clist_ordered_iter_next,
+        .iter_remove = clist_ordered_iter_remove,
+        .iter_insert = clist_ordered_iter_insert,
+        .visit = clist_ordered_visit};
+
+ClistVtable *__clist_ordered_vtable() {
+    return &__clist_ordered_table;
+}
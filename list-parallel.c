@@ -0,0 +1,156 @@
+#include <assert.h>
+#include <stdlib.h>
+
+#include <clist/list-item.h>
+#include "list-vtable.h"
+#include "internal.h"
+
+/*
+ * the fewest items given to a thread, a short list uses fewer threads
+ */
+#define CLIST_PARALLEL_MIN 64
+
+typedef struct __clist_parallel_op {
+    ClistParallelCallback callback;
+    void *ctx;
+    ClistMapCallback map;
+    ClistCombineCallback combine;
+    int64_t identity;
+    size_t threads;
+    int64_t result;
+} ClistParallelOp;
+
+/*
+ * a part of a list, the items after an iterator
+ */
+typedef struct __clist_parallel_task {
+    const ClistParallelOp *op;
+    ClistIterator iter;
+    size_t size;
+    int64_t result;
+} ClistParallelTask;
+
+static void __clist_parallel_task(void *arg) {
+    ClistParallelTask *task = (ClistParallelTask *) arg;
+    const ClistParallelOp *op = task->op;
+    ClistItem *item = NULL;
+    size_t i = 0;
+
+    task->result = op->identity;
+
+    for (i = 0; i < task->size; i++) {
+        item = clist_iter_next(&task->iter);
+
+        if (op->map != NULL) {
+            task->result = (*op->combine)(task->result, (*op->map)(item->data, item->size));
+        } else {
+            (*op->callback)(item->data, item->size, op->ctx);
+        }
+    }
+}
+
+/*
+ * cuts a list into a part per thread and runs them.  arrays and rings start each part
+ * at its index, other lists hop an iterator from the start of one part to the next.
+ * the results of the parts are combined in order, so combining needn't be commutative.
+ */
+static int __clist_parallel_run(Clist *list, void *arg) {
+    ClistParallelOp *op = (ClistParallelOp *) arg;
+    ClistParallelTask *tasks = NULL;
+    ClistIterator iter;
+    size_t size = clist_size(list), threads = op->threads, i = 0, j = 0;
+    int by_index = list->vtable == __clist_array_vtable() || list->vtable == __clist_ring_vtable();
+
+    if (threads > (size + CLIST_PARALLEL_MIN - 1) / CLIST_PARALLEL_MIN) {
+        threads = (size + CLIST_PARALLEL_MIN - 1) / CLIST_PARALLEL_MIN;
+    }
+
+    if (threads == 0) {
+        threads = 1;
+    }
+
+    tasks = malloc(threads * sizeof(ClistParallelTask));
+    assert(tasks != NULL);
+
+    clist_iter_begin(list, &iter);
+
+    for (i = 0; i < threads; i++) {
+        tasks[i].op = op;
+        tasks[i].iter = iter;
+        tasks[i].size = size / threads + (i < size % threads);
+
+        if (i + 1 == threads) {
+            break;
+        }
+
+        if (by_index) {
+            iter.index += tasks[i].size;
+        } else {
+            for (j = 0; j < tasks[i].size; j++) {
+                clist_iter_next(&iter);
+            }
+        }
+    }
+
+    __clist_threads_run(tasks, sizeof(ClistParallelTask), threads, __clist_parallel_task);
+
+    op->result = tasks[0].result;
+
+    for (i = 1; i < threads; i++) {
+        op->result = (*op->combine)(op->result, tasks[i].result);
+    }
+
+    free(tasks);
+
+    /* the callback may have changed the data the items are hashed by */
+    if (op->map == NULL) {
+        __clist_reindex(list);
+    }
+
+    return 0;
+}
+
+/*
+ * runs an operation over a list, over the wrapped list of a concurrent list with its lock held
+ */
+static void __clist_parallel_apply(Clist *list, ClistParallelOp *op) {
+    if (list->vtable == __clist_concurrent_vtable()) {
+        __clist_concurrent_apply(list, __clist_parallel_run, op);
+    } else {
+        __clist_parallel_run(list, op);
+    }
+}
+
+static int64_t __clist_parallel_none(int64_t a, int64_t b) {
+    (void) b;
+    return a;
+}
+
+void __clist_parallel_for_each(Clist *list, ClistParallelCallback callback, void *ctx, size_t nthreads) {
+    ClistParallelOp op;
+
+    op.callback = callback;
+    op.ctx = ctx;
+    op.map = NULL;
+    op.combine = __clist_parallel_none;
+    op.identity = 0;
+    op.threads = nthreads;
+
+    __clist_parallel_apply(list, &op);
+}
+
+int64_t __clist_parallel_reduce(Clist *list, ClistMapCallback map, ClistCombineCallback combine, int64_t identity,
+                                size_t nthreads) {
+    ClistParallelOp op;
+
+    op.callback = NULL;
+    op.ctx = NULL;
+    op.map = map;
+    op.combine = combine;
+    op.identity = identity;
+    op.threads = nthreads;
+
+    __clist_parallel_apply(list, &op);
+
+    return op.result;
+}
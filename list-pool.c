@@ -0,0 +1,207 @@
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "internal.h"
+
+#define CLIST_POOL_DEFAULT_BLOCK_SIZE 64
+
+typedef struct __clist_pool_block ClistPoolBlock;
+
+struct __clist_pool_block {
+    char *start;
+    char *end;
+};
+
+/*
+ * a pool of fixed size objects carved from larger blocks.
+ * freed objects are kept on a free list (linked through the object memory)
+ * and the blocks are only released when the pool is reset.
+ */
+struct __clist_pool {
+    size_t object_size;
+    size_t block_size;
+    void *free_list;
+    /* the unused part of the newest block */
+    char *cursor;
+    char *limit;
+    /* sorted by start address so ownership can be searched */
+    ClistPoolBlock *blocks;
+    size_t num_blocks;
+    size_t max_blocks;
+    size_t allocations;
+    size_t recycled;
+    size_t in_use;
+};
+
+ClistPool *__clist_pool_new(size_t object_size, size_t block_size) {
+    ClistPool *pool = malloc(sizeof(ClistPool));
+    assert(pool != NULL);
+
+    /* objects must be able to hold a free list link */
+    if (object_size < sizeof(void *)) {
+        object_size = sizeof(void *);
+    }
+
+    pool->object_size = (object_size + sizeof(void *) - 1) & ~(sizeof(void *) - 1);
+    pool->block_size = block_size > 0 ? block_size : CLIST_POOL_DEFAULT_BLOCK_SIZE;
+    pool->free_list = NULL;
+    pool->cursor = NULL;
+    pool->limit = NULL;
+    pool->blocks = NULL;
+    pool->num_blocks = 0;
+    pool->max_blocks = 0;
+    pool->allocations = 0;
+    pool->recycled = 0;
+    pool->in_use = 0;
+    return pool;
+}
+
+void __clist_pool_reset(ClistPool *pool) {
+    size_t i = 0;
+
+    assert(pool != NULL);
+
+    for (i = 0; i < pool->num_blocks; i++) {
+        free(pool->blocks[i].start);
+    }
+
+    pool->num_blocks = 0;
+    pool->free_list = NULL;
+    pool->cursor = NULL;
+    pool->limit = NULL;
+    pool->in_use = 0;
+}
+
+void __clist_pool_delete(ClistPool *pool) {
+    if (pool == NULL) {
+        return;
+    }
+
+    __clist_pool_reset(pool);
+
+    free(pool->blocks);
+    free(pool);
+}
+
+/*
+ * finds the position of the block at or before an address
+ */
+static size_t __clist_pool_search(const ClistPool *pool, const void *ptr) {
+    size_t lo = 0, hi = pool->num_blocks, mid = 0;
+
+    while (lo < hi) {
+        mid = lo + (hi - lo) / 2;
+
+        if ((const char *) ptr < pool->blocks[mid].start) {
+            hi = mid;
+        } else {
+            lo = mid + 1;
+        }
+    }
+    return lo;
+}
+
+/*
+ * allocates a block of a number of objects and registers it with the pool
+ */
+static char *__clist_pool_add_block(ClistPool *pool, size_t count) {
+    ClistPoolBlock *blocks = NULL;
+    char *start = NULL;
+    size_t pos = 0;
+
+    start = malloc(count * pool->object_size);
+    assert(start != NULL);
+
+    if (pool->num_blocks == pool->max_blocks) {
+        pool->max_blocks = pool->max_blocks ? pool->max_blocks * 2 : 8;
+        blocks = realloc(pool->blocks, pool->max_blocks * sizeof(ClistPoolBlock));
+        assert(blocks != NULL);
+        pool->blocks = blocks;
+    }
+
+    pos = __clist_pool_search(pool, start);
+
+    memmove(pool->blocks + pos + 1, pool->blocks + pos, (pool->num_blocks - pos) * sizeof(ClistPoolBlock));
+
+    pool->blocks[pos].start = start;
+    pool->blocks[pos].end = start + count * pool->object_size;
+    pool->num_blocks++;
+
+    return start;
+}
+
+void *__clist_pool_alloc(ClistPool *pool) {
+    void *ptr = NULL;
+
+    assert(pool != NULL);
+
+    pool->allocations++;
+    pool->in_use++;
+
+    if (pool->free_list != NULL) {
+        ptr = pool->free_list;
+        pool->free_list = *(void **) ptr;
+        pool->recycled++;
+        return ptr;
+    }
+
+    if (pool->cursor == pool->limit) {
+        pool->cursor = __clist_pool_add_block(pool, pool->block_size);
+        pool->limit = pool->cursor + pool->block_size * pool->object_size;
+    }
+
+    ptr = pool->cursor;
+    pool->cursor += pool->object_size;
+    return ptr;
+}
+
+void __clist_pool_reserve(ClistPool *pool, size_t count) {
+    size_t available = 0;
+
+    assert(pool != NULL);
+
+    available = (size_t) (pool->limit - pool->cursor) / pool->object_size;
+
+    if (available >= count) {
+        return;
+    }
+
+    /* the rest of the current block is left unused */
+    if (count < pool->block_size) {
+        count = pool->block_size;
+    }
+
+    pool->cursor = __clist_pool_add_block(pool, count);
+    pool->limit = pool->cursor + count * pool->object_size;
+}
+
+void __clist_pool_free(ClistPool *pool, void *ptr) {
+    assert(pool != NULL);
+    assert(ptr != NULL);
+
+    *(void **) ptr = pool->free_list;
+    pool->free_list = ptr;
+    pool->in_use--;
+}
+
+int __clist_pool_owns(const ClistPool *pool, const void *ptr) {
+    size_t pos = 0;
+
+    assert(pool != NULL);
+
+    pos = __clist_pool_search(pool, ptr);
+
+    return pos > 0 && (const char *) ptr < pool->blocks[pos - 1].end;
+}
+
+void __clist_pool_stats(const ClistPool *pool, ClistPoolStats *stats) {
+    assert(pool != NULL);
+    assert(stats != NULL);
+
+    stats->allocations = pool->allocations;
+    stats->recycled = pool->recycled;
+    stats->in_use = pool->in_use;
+    stats->blocks = pool->num_blocks;
+    stats->block_size = pool->block_size;
+}
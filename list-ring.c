@@ -0,0 +1,822 @@
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <clist/list-item.h>
+#include "list-vtable.h"
+#include "internal.h"
+
+typedef struct __clist_ring ClistRing;
+
+/*
+ * items are kept in a circular buffer of a fixed capacity, from head for size items,
+ * wrapping around to the start of the buffer.  nothing is allocated after the buffer.
+ * a full ring makes room for an item by the policy: dropping the item at the far end
+ * from the insert (the last for an insert at the front, the first otherwise) or
+ * rejecting the insert.  a dropped item is deleted, the list owns it, while a rejected
+ * item was never the list's and is left with the caller.
+ */
+struct __clist_ring {
+    ClistItem **items;
+    size_t head;
+    size_t size;
+    size_t capacity;
+    ClistRingPolicy policy;
+};
+
+extern void clist_ring_clear(Clist *list);
+
+static inline ClistRing *__clist_ring_impl(const Clist *arg) {
+    assert(arg->impl != NULL);
+    return (ClistRing *) arg->impl;
+}
+
+/*
+ * gets the slot of an index, which may be one past the items
+ */
+static inline ClistItem **__clist_ring_slot(const ClistRing *ring, size_t index) {
+    size_t pos = ring->head + index;
+
+    if (pos >= ring->capacity) {
+        pos -= ring->capacity;
+    }
+
+    return ring->items + pos;
+}
+
+/*
+ * opens a slot at a position, moving the smaller side of the ring
+ * @return the slot
+ */
+static ClistItem **__clist_ring_open(ClistRing *ring, size_t pos) {
+    size_t i = 0;
+
+    assert(ring->size < ring->capacity);
+    assert(pos <= ring->size);
+
+    if (pos < ring->size / 2) {
+        ring->head = ring->head == 0 ? ring->capacity - 1 : ring->head - 1;
+
+        for (i = 0; i < pos; i++) {
+            *__clist_ring_slot(ring, i) = *__clist_ring_slot(ring, i + 1);
+        }
+    } else {
+        for (i = ring->size; i > pos; i--) {
+            *__clist_ring_slot(ring, i) = *__clist_ring_slot(ring, i - 1);
+        }
+    }
+
+    ring->size++;
+
+    return __clist_ring_slot(ring, pos);
+}
+
+/*
+ * closes the slot at a position, moving the smaller side of the ring
+ */
+static void __clist_ring_close(ClistRing *ring, size_t pos) {
+    size_t i = 0;
+
+    assert(pos < ring->size);
+
+    if (pos < ring->size / 2) {
+        for (i = pos; i > 0; i--) {
+            *__clist_ring_slot(ring, i) = *__clist_ring_slot(ring, i - 1);
+        }
+
+        ring->head = ring->head + 1 == ring->capacity ? 0 : ring->head + 1;
+    } else {
+        for (i = pos; i + 1 < ring->size; i++) {
+            *__clist_ring_slot(ring, i) = *__clist_ring_slot(ring, i + 1);
+        }
+    }
+
+    ring->size--;
+}
+
+/*
+ * inserts an item at a position, making room by the policy when the ring is full
+ * @param pos the position, at most the size, set to where the item went
+ * @param indexed positive if the hash index holds the item and the items of the list,
+ *                otherwise the caller rebuilds the index
+ * @return positive if the item was inserted, zero if it was rejected and is left with the caller
+ */
+static int __clist_ring_insert(Clist *list, size_t *pos, ClistItem *item, int indexed) {
+    ClistRing *ring = __clist_ring_impl(list);
+    ClistItem *dropped = NULL;
+
+    if (ring->size == ring->capacity) {
+        if (ring->policy == ClistRingReject) {
+            if (indexed && list->index) {
+                __clist_index_detach(list->index, item);
+            }
+            return 0;
+        }
+
+        if (*pos == 0) {
+            dropped = *__clist_ring_slot(ring, ring->size - 1);
+            __clist_ring_close(ring, ring->size - 1);
+        } else {
+            dropped = *__clist_ring_slot(ring, 0);
+            __clist_ring_close(ring, 0);
+            (*pos)--;
+        }
+
+        if (indexed && list->index) {
+            __clist_index_detach(list->index, dropped);
+        }
+
+        clist_item_delete(dropped);
+    }
+
+    *__clist_ring_open(ring, *pos) = item;
+
+    return 1;
+}
+
+/*
+ * inserts some items at a position in order.  a rejecting ring inserts all of them or none.
+ * @param indexed as for __clist_ring_insert
+ * @return positive if the items were inserted, zero if they were rejected and are left with the caller
+ */
+static int __clist_ring_insert_all(Clist *list, size_t pos, ClistItem **items, size_t count, int indexed) {
+    ClistRing *ring = __clist_ring_impl(list);
+    size_t i = 0;
+
+    if (ring->policy == ClistRingReject && ring->size + count > ring->capacity) {
+        for (i = 0; indexed && list->index && i < count; i++) {
+            __clist_index_detach(list->index, items[i]);
+        }
+        return 0;
+    }
+
+    /* at the front the last item makes room, so add in reverse to drop the last of the items */
+    if (pos == 0) {
+        for (i = count; i > 0; i--) {
+            __clist_ring_insert(list, &pos, items[i - 1], indexed);
+        }
+        return 1;
+    }
+
+    for (i = 0; i < count; i++, pos++) {
+        __clist_ring_insert(list, &pos, items[i], indexed);
+    }
+
+    return 1;
+}
+
+static int __clist_ring_find_data(const ClistRing *ring, const void *data) {
+    size_t pos = 0;
+
+    for (pos = 0; pos < ring->size; pos++) {
+        if (clist_item_compare(*__clist_ring_slot(ring, pos), data) == 0) {
+            return (int) pos;
+        }
+    }
+    return -1;
+}
+
+static void __clist_ring_reverse(ClistItem **items, size_t size) {
+    ClistItem *item = NULL;
+    size_t i = 0;
+
+    for (i = 0; i < size / 2; i++) {
+        item = items[i];
+        items[i] = items[size - 1 - i];
+        items[size - 1 - i] = item;
+    }
+}
+
+/*
+ * rotates the buffer in place so the items start at the beginning of it
+ */
+static void __clist_ring_straighten(ClistRing *ring) {
+    if (ring->head == 0) {
+        return;
+    }
+
+    __clist_ring_reverse(ring->items, ring->head);
+    __clist_ring_reverse(ring->items + ring->head, ring->capacity - ring->head);
+    __clist_ring_reverse(ring->items, ring->capacity);
+
+    ring->head = 0;
+}
+
+void *clist_ring_new() {
+    ClistRing *ring = malloc(sizeof(ClistRing));
+    assert(ring != NULL);
+    ring->items = NULL;
+    ring->head = 0;
+    ring->size = 0;
+    ring->capacity = 0;
+    ring->policy = ClistRingOverwrite;
+    return ring;
+}
+
+void __clist_ring_set_capacity(Clist *list, size_t capacity, ClistRingPolicy policy) {
+    ClistRing *impl = NULL;
+
+    assert(list != NULL);
+    assert(capacity > 0);
+
+    impl = __clist_ring_impl(list);
+
+    assert(impl->items == NULL);
+
+    impl->items = malloc(capacity * sizeof(ClistItem *));
+    assert(impl->items != NULL);
+
+    impl->capacity = capacity;
+    impl->policy = policy;
+}
+
+size_t __clist_ring_room(const Clist *list) {
+    const ClistRing *impl = NULL;
+
+    assert(list != NULL);
+
+    if (list->vtable != __clist_ring_vtable()) {
+        return SIZE_MAX;
+    }
+
+    impl = __clist_ring_impl(list);
+
+    if (impl->policy != ClistRingReject) {
+        return SIZE_MAX;
+    }
+
+    return impl->capacity - impl->size;
+}
+
+void __clist_ring_copy_capacity(Clist *list, const Clist *other) {
+    const ClistRing *other_impl = NULL;
+
+    assert(other != NULL);
+
+    other_impl = __clist_ring_impl(other);
+
+    __clist_ring_set_capacity(list, other_impl->capacity, other_impl->policy);
+}
+
+void clist_ring_delete(Clist *list) {
+    ClistRing *impl = NULL;
+
+    assert(list != NULL);
+
+    clist_ring_clear(list);
+
+    impl = __clist_ring_impl(list);
+
+    free(impl->items);
+    free(impl);
+}
+
+void clist_ring_add(Clist *list, ClistItem *item) {
+    size_t pos = 0;
+
+    assert(list != NULL);
+    assert(item != NULL);
+
+    __clist_ring_insert(list, &pos, item, 1);
+}
+
+void clist_ring_add_last(Clist *list, ClistItem *item) {
+    size_t pos = 0;
+
+    assert(list != NULL);
+    assert(item != NULL);
+
+    pos = __clist_ring_impl(list)->size;
+
+    __clist_ring_insert(list, &pos, item, 1);
+}
+
+ClistItem *clist_ring_pop_first(Clist *list) {
+    ClistRing *impl = NULL;
+    ClistItem *item = NULL;
+
+    assert(list != NULL);
+
+    impl = __clist_ring_impl(list);
+
+    if (impl->size == 0) {
+        return NULL;
+    }
+
+    item = *__clist_ring_slot(impl, 0);
+
+    __clist_ring_close(impl, 0);
+
+    return item;
+}
+
+ClistItem *clist_ring_pop_last(Clist *list) {
+    ClistRing *impl = NULL;
+    ClistItem *item = NULL;
+
+    assert(list != NULL);
+
+    impl = __clist_ring_impl(list);
+
+    if (impl->size == 0) {
+        return NULL;
+    }
+
+    item = *__clist_ring_slot(impl, impl->size - 1);
+
+    __clist_ring_close(impl, impl->size - 1);
+
+    return item;
+}
+
+void clist_ring_add_index(Clist *list, size_t index, ClistItem *item) {
+    size_t pos = index + 1;
+
+    assert(list != NULL);
+    assert(item != NULL);
+
+    if (index >= __clist_ring_impl(list)->size) {
+        return;
+    }
+
+    __clist_ring_insert(list, &pos, item, 1);
+}
+
+typedef struct __clist_ring_copy_arg {
+    ClistItem **slot;
+} ClistRingCopyArg;
+
+static ClistCallbackReturn __clist_ring_copy_item(ClistItem *item, void *arg) {
+    ClistRingCopyArg *params = (ClistRingCopyArg *) arg;
+    *params->slot++ = clist_item_copy(item);
+    return ClistIterateNext;
+}
+
+/*
+ * inserts copies of the items in another list at a position, preserving their order.
+ * the hash index is rebuilt by the caller.
+ */
+static void __clist_ring_insert_copies(Clist *list, size_t pos, const Clist *other) {
+    ClistRingCopyArg params;
+    ClistItem **copies = NULL;
+    size_t count = 0, i = 0;
+
+    count = clist_size(other);
+
+    if (count == 0) {
+        return;
+    }
+
+    /* copy first, inserting would move the items being visited */
+    copies = malloc(count * sizeof(ClistItem *));
+    assert(copies != NULL);
+
+    params.slot = copies;
+
+    __clist_visit(other, __clist_ring_copy_item, &params);
+
+    /* the copies are the ring's own, so rejected ones are deleted here */
+    if (!__clist_ring_insert_all(list, pos, copies, count, 0)) {
+        for (i = 0; i < count; i++) {
+            clist_item_delete(copies[i]);
+        }
+    }
+
+    free(copies);
+}
+
+void clist_ring_add_all(Clist *list, const Clist *other) {
+    assert(list != NULL);
+    assert(other != NULL);
+
+    __clist_ring_insert_copies(list, 0, other);
+}
+
+void clist_ring_add_all_index(Clist *list, size_t index, const Clist *other) {
+    assert(list != NULL);
+    assert(other != NULL);
+
+    if (index >= __clist_ring_impl(list)->size) {
+        return;
+    }
+
+    __clist_ring_insert_copies(list, index + 1, other);
+}
+
+void clist_ring_add_batch(Clist *list, ClistItem **items, size_t count) {
+    assert(list != NULL);
+    assert(items != NULL);
+
+    __clist_ring_insert_all(list, 0, items, count, 1);
+}
+
+void clist_ring_add_batch_index(Clist *list, size_t index, ClistItem **items, size_t count) {
+    assert(list != NULL);
+    assert(items != NULL);
+
+    if (index >= __clist_ring_impl(list)->size) {
+        return;
+    }
+
+    __clist_ring_insert_all(list, index + 1, items, count, 1);
+}
+
+void clist_ring_transfer(Clist *list, size_t index, Clist *other, size_t from, size_t count) {
+    ClistRing *impl = NULL, *other_impl = NULL;
+    ClistItem **items = NULL;
+    size_t i = 0;
+
+    assert(list != NULL);
+    assert(other != NULL);
+
+    impl = __clist_ring_impl(list);
+    other_impl = __clist_ring_impl(other);
+
+    assert(index <= impl->size);
+    assert(count > 0 && from + count <= other_impl->size);
+
+    /* a rejecting ring moves all the items or none, leaving them in the other list */
+    if (impl->policy == ClistRingReject && impl->size + count > impl->capacity) {
+        return;
+    }
+
+    items = malloc(count * sizeof(ClistItem *));
+    assert(items != NULL);
+
+    for (i = 0; i < count; i++) {
+        items[i] = *__clist_ring_slot(other_impl, from);
+        __clist_ring_close(other_impl, from);
+    }
+
+    __clist_ring_insert_all(list, index, items, count, 0);
+
+    free(items);
+}
+
+void clist_ring_clear(Clist *list) {
+    ClistRing *impl = NULL;
+    size_t pos = 0;
+
+    assert(list != NULL);
+
+    impl = __clist_ring_impl(list);
+
+    for (pos = 0; pos < impl->size; pos++) {
+        clist_item_delete(*__clist_ring_slot(impl, pos));
+    }
+
+    impl->head = 0;
+    impl->size = 0;
+}
+
+int clist_ring_contains(const Clist *list, const void *data) {
+    if (list == NULL) {
+        return 0;
+    }
+
+    return __clist_ring_find_data(__clist_ring_impl(list), data) != -1;
+}
+
+typedef struct __clist_ring_count_arg {
+    const ClistRing *ring;
+    int count;
+} ClistRingCountArg;
+
+static ClistCallbackReturn __clist_ring_count_found(ClistItem *item, void *arg) {
+    ClistRingCountArg *params = (ClistRingCountArg *) arg;
+
+    if (__clist_ring_find_data(params->ring, item->data) != -1) {
+        params->count++;
+    }
+    return ClistIterateNext;
+}
+
+int clist_ring_contains_all(const Clist *list, const Clist *other) {
+    ClistRingCountArg params;
+
+    if (list == NULL || other == NULL) {
+        return 0;
+    }
+
+    params.ring = __clist_ring_impl(list);
+    params.count = 0;
+
+    __clist_visit(other, __clist_ring_count_found, &params);
+
+    return params.count;
+}
+
+ClistItem *clist_ring_get_item(const Clist *list, size_t index) {
+    ClistRing *impl = NULL;
+
+    if (list == NULL) {
+        return NULL;
+    }
+
+    impl = __clist_ring_impl(list);
+
+    if (index >= impl->size) {
+        return NULL;
+    }
+
+    return *__clist_ring_slot(impl, index);
+}
+
+void *clist_ring_get(const Clist *list, size_t index) {
+    ClistItem *item = clist_ring_get_item(list, index);
+
+    if (item == NULL) {
+        return NULL;
+    }
+
+    return item->data;
+}
+
+int clist_ring_remove_index(Clist *list, size_t index) {
+    ClistRing *impl = NULL;
+
+    if (list == NULL) {
+        return 0;
+    }
+
+    impl = __clist_ring_impl(list);
+
+    if (index >= impl->size) {
+        return 0;
+    }
+
+    clist_item_delete(*__clist_ring_slot(impl, index));
+
+    __clist_ring_close(impl, index);
+
+    return 1;
+}
+
+int clist_ring_remove(Clist *list, const void *data) {
+    int index = 0;
+
+    if (list == NULL) {
+        return 0;
+    }
+
+    index = __clist_ring_find_data(__clist_ring_impl(list), data);
+
+    if (index == -1) {
+        return 0;
+    }
+
+    return clist_ring_remove_index(list, (size_t) index);
+}
+
+typedef struct __clist_ring_remove_arg {
+    Clist *list;
+    int count;
+} ClistRingRemoveArg;
+
+static ClistCallbackReturn __clist_ring_remove_found(ClistItem *item, void *arg) {
+    ClistRingRemoveArg *params = (ClistRingRemoveArg *) arg;
+
+    if (clist_ring_remove(params->list, item->data)) {
+        params->count++;
+    }
+    return ClistIterateNext;
+}
+
+int clist_ring_remove_all(Clist *list, const Clist *other) {
+    ClistRingRemoveArg params;
+    int result = 0;
+
+    if (list == NULL || other == NULL) {
+        return 0;
+    }
+
+    /* removing a list from itself empties it */
+    if (list == other) {
+        result = (int) __clist_ring_impl(list)->size;
+        clist_ring_clear(list);
+        return result;
+    }
+
+    params.list = list;
+    params.count = 0;
+
+    __clist_visit(other, __clist_ring_remove_found, &params);
+
+    return params.count;
+}
+
+int clist_ring_index_of(const Clist *list, const void *data) {
+    if (list == NULL) {
+        return -1;
+    }
+
+    return __clist_ring_find_data(__clist_ring_impl(list), data);
+}
+
+void clist_ring_set(Clist *list, size_t index, ClistItem *item) {
+    ClistRing *impl = NULL;
+    ClistItem **slot = NULL;
+
+    if (list == NULL) {
+        return;
+    }
+
+    impl = __clist_ring_impl(list);
+
+    if (index >= impl->size) {
+        return;
+    }
+
+    slot = __clist_ring_slot(impl, index);
+
+    clist_item_delete(*slot);
+
+    *slot = item;
+}
+
+size_t clist_ring_size(const Clist *list) {
+    if (list == NULL) {
+        return 0;
+    }
+
+    return __clist_ring_impl(list)->size;
+}
+
+int clist_ring_is_empty(const Clist *list) {
+    assert(list != NULL);
+    return __clist_ring_impl(list)->size == 0;
+}
+
+void clist_ring_sort_with(Clist *list, const ClistSortComparer *comparer) {
+    ClistRing *impl = NULL;
+
+    if (clist_size(list) <= 1) {
+        return;
+    }
+
+    impl = __clist_ring_impl(list);
+
+    __clist_ring_straighten(impl);
+
+    __clist_sort_items(impl->items, impl->size, comparer);
+}
+
+void clist_ring_sort(Clist *list) {
+    clist_ring_sort_with(list, NULL);
+}
+
+void clist_ring_sort_by_key(Clist *list, ClistKeyCallback key, void *ctx) {
+    ClistRing *impl = NULL;
+
+    if (clist_size(list) <= 1) {
+        return;
+    }
+
+    impl = __clist_ring_impl(list);
+
+    __clist_ring_straighten(impl);
+
+    __clist_sort_items_by_key(impl->items, impl->size, key, ctx);
+}
+
+/*
+ * moves the items from a position down to another, after the items between were deleted
+ */
+static void __clist_ring_compact(ClistRing *ring, size_t kept, size_t pos) {
+    for (; pos < ring->size; pos++, kept++) {
+        *__clist_ring_slot(ring, kept) = *__clist_ring_slot(ring, pos);
+    }
+
+    ring->size = kept;
+}
+
+void clist_ring_visit(Clist *list, ClistVisitCallback callback, void *arg) {
+    ClistRing *impl = NULL;
+    ClistItem *item = NULL;
+    size_t pos = 0, kept = 0;
+
+    assert(list != NULL);
+    assert(callback != NULL);
+
+    impl = __clist_ring_impl(list);
+
+    /* deleted items are compacted out as we go */
+    for (pos = 0; pos < impl->size; pos++) {
+        item = *__clist_ring_slot(impl, pos);
+
+        switch (callback(item, arg)) {
+            case ClistIteratorBreak:
+                __clist_ring_compact(impl, kept, pos);
+                return;
+            case ClistIteratorDelete:
+                clist_item_delete(item);
+                break;
+            default:
+                *__clist_ring_slot(impl, kept++) = item;
+                break;
+        }
+    }
+
+    impl->size = kept;
+}
+
+/*
+ * the iterator index is the position of the next item
+ */
+ClistItem *clist_ring_iter_next(ClistIterator *iter) {
+    ClistRing *impl = __clist_ring_impl(iter->list);
+
+    if (iter->index >= impl->size) {
+        return NULL;
+    }
+
+    return *__clist_ring_slot(impl, iter->index++);
+}
+
+void clist_ring_iter_remove(ClistIterator *iter) {
+    ClistRing *impl = __clist_ring_impl(iter->list);
+
+    iter->index--;
+
+    clist_item_delete(*__clist_ring_slot(impl, iter->index));
+
+    __clist_ring_close(impl, iter->index);
+}
+
+int clist_ring_iter_insert(ClistIterator *iter, ClistItem *item) {
+    size_t pos = iter->index;
+
+    if (__clist_ring_insert(iter->list, &pos, item, 1) == 0) {
+        return 0;
+    }
+
+    iter->index = pos + 1;
+
+    return 1;
+}
+
+void clist_ring_for_each(Clist *list, ClistCallback callback) {
+    ClistRing *impl = NULL;
+    ClistItem *item = NULL;
+    size_t pos = 0, kept = 0;
+
+    assert(list != NULL);
+    assert(callback != NULL);
+
+    impl = __clist_ring_impl(list);
+
+    for (pos = 0; pos < impl->size; pos++) {
+        item = *__clist_ring_slot(impl, pos);
+
+        switch (callback(list, pos, item)) {
+            case ClistIteratorBreak:
+                __clist_ring_compact(impl, kept, pos);
+                return;
+            case ClistIteratorDelete:
+                clist_item_delete(item);
+                break;
+            default:
+                *__clist_ring_slot(impl, kept++) = item;
+                break;
+        }
+    }
+
+    impl->size = kept;
+}
+
+static ClistVtable __clist_ring_table = {.create = clist_ring_new,
+        .destroy = clist_ring_delete,
+        .add = clist_ring_add,
+        .add_last = clist_ring_add_last,
+        .pop_first = clist_ring_pop_first,
+        .pop_last = clist_ring_pop_last,
+        .add_all = clist_ring_add_all,
+        .add_index = clist_ring_add_index,
+        .add_all_index = clist_ring_add_all_index,
+        .add_batch = clist_ring_add_batch,
+        .add_batch_index = clist_ring_add_batch_index,
+        .transfer = clist_ring_transfer,
+        .clear = clist_ring_clear,
+        .contains = clist_ring_contains,
+        .contains_all = clist_ring_contains_all,
+        .get = clist_ring_get,
+        .get_item = clist_ring_get_item,
+        .remove = clist_ring_remove,
+        .remove_index = clist_ring_remove_index,
+        .remove_all = clist_ring_remove_all,
+        .index_of = clist_ring_index_of,
+        .set = clist_ring_set,
+        .size = clist_ring_size,
+        .is_empty = clist_ring_is_empty,
+        .sort = clist_ring_sort,
+        .sort_with = clist_ring_sort_with,
+        .sort_by_key = clist_ring_sort_by_key,
+        .for_each = clist_ring_for_each,
+        .iter_next = clist_ring_iter_next,
+        .iter_remove = clist_ring_iter_remove,
+        .iter_insert = clist_ring_iter_insert,
+        .visit = clist_ring_visit};
+
+ClistVtable *__clist_ring_vtable() {
+    return &__clist_ring_table;
+}
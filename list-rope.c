@@ -0,0 +1,990 @@
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <clist/list-item.h>
+#include "list-vtable.h"
+#include "internal.h"
+
+typedef struct __clist_rope ClistRope;
+
+typedef struct __clist_rope_node ClistRopeNode;
+
+/*
+ * a node in a treap ordered by position: the tree is in list order from left to right,
+ * and each node has a higher priority than its children, which keeps it balanced.
+ * a node may be fused with its item (and the item data), in a single allocation:
+ * [ node | item | data ], in which case node->item points directly after the node.
+ */
+struct __clist_rope_node {
+    /* first, so a sort can chain the nodes through it */
+    ClistRopeNode *left;
+    ClistRopeNode *right;
+    ClistRopeNode *parent;
+    ClistItem *item;
+    /* the number of nodes in the subtree */
+    size_t size;
+    uint32_t priority;
+};
+
+struct __clist_rope {
+    ClistRopeNode *root;
+    /* state for picking node priorities */
+    uint64_t seed;
+};
+
+extern void clist_rope_clear(Clist *list);
+
+static inline ClistRope *__clist_rope_impl(const Clist *arg) {
+    assert(arg->impl != NULL);
+    return (ClistRope *) arg->impl;
+}
+
+static inline size_t __clist_rope_size(const ClistRopeNode *node) {
+    return node ? node->size : 0;
+}
+
+static uint32_t __clist_rope_random(ClistRope *list) {
+    uint64_t bits = list->seed;
+
+    /* xorshift */
+    bits ^= bits << 13;
+    bits ^= bits >> 7;
+    bits ^= bits << 17;
+
+    list->seed = bits;
+
+    return (uint32_t) (bits >> 32);
+}
+
+/*
+ * the memory after a node for a fused item
+ */
+static inline void *__clist_rope_node_slot(const ClistRopeNode *node) {
+    return (char *) node + CLIST_ALIGN_HEADER(sizeof(ClistRopeNode));
+}
+
+static ClistRopeNode *__clist_rope_node_alloc(ClistRope *list, size_t extra) {
+    ClistRopeNode *node = malloc(CLIST_ALIGN_HEADER(sizeof(ClistRopeNode)) + extra);
+    assert(node != NULL);
+    node->left = NULL;
+    node->right = NULL;
+    node->parent = NULL;
+    node->item = NULL;
+    node->size = 1;
+    node->priority = __clist_rope_random(list);
+    return node;
+}
+
+static ClistRopeNode *__clist_rope_node_create(ClistRope *list, ClistItem *item) {
+    ClistRopeNode *node = NULL;
+    assert(item != NULL);
+    node = __clist_rope_node_alloc(list, 0);
+    node->item = item;
+    return node;
+}
+
+static ClistRopeNode *__clist_rope_node_create_fused(ClistRope *list, const void *data, size_t size,
+                                                    const ClistItemType *type) {
+    ClistRopeNode *node = __clist_rope_node_alloc(list, __clist_item_inline_size(size));
+    node->item = __clist_item_init_inline(__clist_rope_node_slot(node), data, size, type);
+    return node;
+}
+
+/*
+ * creates a node with a copy of an item, small plain data is copied inline with the node
+ */
+static ClistRopeNode *__clist_rope_node_copy(ClistRope *list, const ClistItem *orig) {
+    ClistRopeNode *node = NULL;
+
+    if (!__clist_item_copies_inline(orig)) {
+        return __clist_rope_node_create(list, clist_item_copy(orig));
+    }
+
+    node = __clist_rope_node_alloc(list, __clist_item_inline_size(orig->size));
+    node->item = __clist_item_init_copy(__clist_rope_node_slot(node), orig);
+    return node;
+}
+
+static inline int __clist_rope_node_is_fused(const ClistRopeNode *node) {
+    return node->item == (const ClistItem *) __clist_rope_node_slot(node);
+}
+
+static void __clist_rope_node_delete_item(ClistRopeNode *node) {
+    if (node->item == NULL) {
+        return;
+    }
+
+    if (__clist_rope_node_is_fused(node)) {
+        __clist_item_release(node->item);
+    } else {
+        clist_item_delete(node->item);
+    }
+    node->item = NULL;
+}
+
+static void __clist_rope_node_destroy(ClistRopeNode *node) {
+    assert(node != NULL);
+
+    __clist_rope_node_delete_item(node);
+
+    free(node);
+}
+
+/*
+ * recomputes the size of a node after its children changed
+ */
+static inline ClistRopeNode *__clist_rope_update(ClistRopeNode *node) {
+    if (node == NULL) {
+        return NULL;
+    }
+
+    node->size = 1 + __clist_rope_size(node->left) + __clist_rope_size(node->right);
+
+    if (node->left) {
+        node->left->parent = node;
+    }
+    if (node->right) {
+        node->right->parent = node;
+    }
+    return node;
+}
+
+static inline ClistRopeNode *__clist_rope_root(ClistRopeNode *node) {
+    if (node != NULL) {
+        node->parent = NULL;
+    }
+    return node;
+}
+
+/*
+ * joins two trees, every node of the left one before every node of the right one
+ */
+static ClistRopeNode *__clist_rope_merge(ClistRopeNode *left, ClistRopeNode *right) {
+    if (left == NULL) {
+        return right;
+    }
+
+    if (right == NULL) {
+        return left;
+    }
+
+    if (left->priority > right->priority) {
+        left->right = __clist_rope_merge(left->right, right);
+        return __clist_rope_update(left);
+    }
+
+    right->left = __clist_rope_merge(left, right->left);
+    return __clist_rope_update(right);
+}
+
+/*
+ * splits a tree into the first count nodes and the rest
+ */
+static void __clist_rope_split(ClistRopeNode *node, size_t count, ClistRopeNode **left, ClistRopeNode **right) {
+    if (node == NULL) {
+        *left = NULL;
+        *right = NULL;
+        return;
+    }
+
+    if (__clist_rope_size(node->left) < count) {
+        __clist_rope_split(node->right, count - __clist_rope_size(node->left) - 1, &node->right, right);
+        *left = __clist_rope_update(node);
+    } else {
+        __clist_rope_split(node->left, count, left, &node->left);
+        *right = __clist_rope_update(node);
+    }
+}
+
+/*
+ * inserts a tree at an index, which must be at most the size
+ */
+static void __clist_rope_insert(ClistRope *list, size_t index, ClistRopeNode *node) {
+    ClistRopeNode *left = NULL, *right = NULL;
+
+    __clist_rope_split(list->root, index, &left, &right);
+
+    list->root = __clist_rope_root(__clist_rope_merge(__clist_rope_merge(left, node), right));
+}
+
+/*
+ * inserts a single node at an index, which must be at most the size.
+ * the node only displaces the subtree where its priority belongs, which is expected to be small.
+ */
+static void __clist_rope_insert_node(ClistRope *list, size_t index, ClistRopeNode *node) {
+    ClistRopeNode **link = &list->root, *parent = NULL;
+    size_t left = 0;
+
+    while (*link && (*link)->priority >= node->priority) {
+        parent = *link;
+        parent->size++;
+
+        left = __clist_rope_size(parent->left);
+
+        if (index <= left) {
+            link = &parent->left;
+        } else {
+            index -= left + 1;
+            link = &parent->right;
+        }
+    }
+
+    __clist_rope_split(*link, index, &node->left, &node->right);
+
+    *link = __clist_rope_update(node);
+
+    node->parent = parent;
+}
+
+/*
+ * finds the node at an index in O(log n)
+ */
+static ClistRopeNode *__clist_rope_get_node(const ClistRope *list, size_t index) {
+    ClistRopeNode *node = list->root;
+    size_t left = 0;
+
+    if (index >= __clist_rope_size(node)) {
+        return NULL;
+    }
+
+    while (node) {
+        left = __clist_rope_size(node->left);
+
+        if (index < left) {
+            node = node->left;
+        } else if (index == left) {
+            return node;
+        } else {
+            index -= left + 1;
+            node = node->right;
+        }
+    }
+    return NULL;
+}
+
+/*
+ * unlinks a node from the tree, replacing it with its children merged together
+ */
+static void __clist_rope_unlink(ClistRope *list, ClistRopeNode *node) {
+    ClistRopeNode *parent = node->parent, *children = NULL;
+
+
+    children = __clist_rope_merge(node->left, node->right);
+
+    if (children) {
+        children->parent = parent;
+    }
+
+    if (parent == NULL) {
+        list->root = children;
+    } else if (parent->left == node) {
+        parent->left = children;
+    } else {
+        parent->right = children;
+    }
+
+    for (; parent; parent = parent->parent) {
+        parent->size--;
+    }
+
+    node->left = NULL;
+    node->right = NULL;
+    node->parent = NULL;
+}
+
+/*
+ * detaches the node at an index
+ */
+static ClistRopeNode *__clist_rope_detach(ClistRope *list, size_t index) {
+    ClistRopeNode *node = __clist_rope_get_node(list, index);
+
+    if (node != NULL) {
+        __clist_rope_unlink(list, node);
+    }
+    return node;
+}
+
+static ClistRopeNode *__clist_rope_first(ClistRopeNode *node) {
+    while (node && node->left) {
+        node = node->left;
+    }
+    return node;
+}
+
+/*
+ * the node after another in list order, in amortized constant time
+ */
+static ClistRopeNode *__clist_rope_next(ClistRopeNode *node) {
+    if (node->right) {
+        return __clist_rope_first(node->right);
+    }
+
+    while (node->parent && node->parent->right == node) {
+        node = node->parent;
+    }
+    return node->parent;
+}
+
+static ClistRopeNode *__clist_rope_last(ClistRopeNode *node) {
+    while (node && node->right) {
+        node = node->right;
+    }
+    return node;
+}
+
+/*
+ * the node before another in list order
+ */
+static ClistRopeNode *__clist_rope_prev(ClistRopeNode *node) {
+    if (node->left) {
+        return __clist_rope_last(node->left);
+    }
+
+    while (node->parent && node->parent->left == node) {
+        node = node->parent;
+    }
+    return node->parent;
+}
+
+static ClistRopeNode *__clist_rope_find_node_data(const ClistRope *list, const void *data, size_t *index) {
+    ClistRopeNode *node = NULL;
+    size_t pos = 0;
+
+    for (node = __clist_rope_first(list->root); node; node = __clist_rope_next(node), pos++) {
+        if (clist_item_compare(node->item, data) == 0) {
+            if (index != NULL) {
+                *index = pos;
+            }
+            return node;
+        }
+    }
+    return NULL;
+}
+
+/*
+ * builds a tree from a chain of nodes linked through their left child, in O(n).
+ * each node keeps its priority, parents are kept on a stack until their right subtree is complete.
+ */
+static ClistRopeNode *__clist_rope_build(ClistRopeNode *chain) {
+    ClistRopeNode *spine = NULL, *node = NULL, *next = NULL, *last = NULL;
+
+    for (node = chain; node; node = next) {
+        next = node->left;
+
+        /* the spine is linked through the parents, lowest node first */
+        for (last = NULL; spine && spine->priority < node->priority; spine = spine->parent) {
+            last = __clist_rope_update(spine);
+        }
+
+        node->left = last;
+        node->right = NULL;
+
+        if (spine) {
+            spine->right = node;
+        }
+
+        node->parent = spine;
+        spine = node;
+    }
+
+    for (last = NULL; spine; spine = spine->parent) {
+        last = __clist_rope_update(spine);
+    }
+
+    return __clist_rope_root(last);
+}
+
+/*
+ * links the nodes of a tree, in list order, through their left child
+ */
+static ClistRopeNode *__clist_rope_chain(ClistRopeNode *root) {
+    ClistRopeNode *node = NULL, *next = NULL;
+
+    node = __clist_rope_first(root);
+
+    root = node;
+
+    for (; node; node = next) {
+        next = __clist_rope_next(node);
+        node->left = next;
+    }
+
+    return root;
+}
+
+typedef struct __clist_rope_copy_arg {
+    ClistRope *list;
+    ClistRopeNode *first;
+    ClistRopeNode **tail;
+} ClistRopeCopyArg;
+
+static ClistCallbackReturn __clist_rope_copy_item(ClistItem *item, void *arg) {
+    ClistRopeCopyArg *params = (ClistRopeCopyArg *) arg;
+    ClistRopeNode *node = __clist_rope_node_copy(params->list, item);
+
+    *params->tail = node;
+    params->tail = &node->left;
+
+    return ClistIterateNext;
+}
+
+/*
+ * builds a tree with copies of the items in a list
+ */
+static ClistRopeNode *__clist_rope_copy_list(ClistRope *list, const Clist *other) {
+    ClistRopeCopyArg params;
+
+    params.list = list;
+    params.first = NULL;
+    params.tail = &params.first;
+
+    __clist_visit(other, __clist_rope_copy_item, &params);
+
+    return __clist_rope_build(params.first);
+}
+
+void *clist_rope_new() {
+    ClistRope *list = malloc(sizeof(ClistRope));
+    assert(list != NULL);
+    list->root = NULL;
+    list->seed = UINT64_C(0x9E3779B97F4A7C15);
+    return list;
+}
+
+void clist_rope_delete(Clist *list) {
+    assert(list != NULL);
+
+    clist_rope_clear(list);
+
+    free(__clist_rope_impl(list));
+}
+
+void clist_rope_add(Clist *list, ClistItem *item) {
+    ClistRope *impl = NULL;
+
+    assert(list != NULL);
+    assert(item != NULL);
+
+    impl = __clist_rope_impl(list);
+
+    __clist_rope_insert_node(impl, 0, __clist_rope_node_create(impl, item));
+}
+
+void clist_rope_add_value(Clist *list, const void *data, size_t size, ClistCompareCallback comparer) {
+    ClistRope *impl = NULL;
+
+    assert(list != NULL);
+
+    impl = __clist_rope_impl(list);
+
+    __clist_rope_insert_node(impl, 0, __clist_rope_node_create_fused(
+            impl, data, size, __clist_item_type_intern(comparer, NULL, NULL, NULL)));
+}
+
+void clist_rope_add_last(Clist *list, ClistItem *item) {
+    ClistRope *impl = NULL;
+
+    assert(list != NULL);
+    assert(item != NULL);
+
+    impl = __clist_rope_impl(list);
+
+    __clist_rope_insert_node(impl, __clist_rope_size(impl->root), __clist_rope_node_create(impl, item));
+}
+
+static ClistItem *__clist_rope_take(ClistRope *list, size_t index) {
+    ClistRopeNode *node = __clist_rope_detach(list, index);
+    ClistItem *item = NULL;
+
+    if (node == NULL) {
+        return NULL;
+    }
+
+    /* a fused item can't outlive its node */
+    if (__clist_rope_node_is_fused(node)) {
+        item = clist_item_copy(node->item);
+    } else {
+        item = node->item;
+        node->item = NULL;
+    }
+
+    __clist_rope_node_destroy(node);
+
+    return item;
+}
+
+ClistItem *clist_rope_pop_first(Clist *list) {
+    assert(list != NULL);
+
+    return __clist_rope_take(__clist_rope_impl(list), 0);
+}
+
+ClistItem *clist_rope_pop_last(Clist *list) {
+    ClistRope *impl = NULL;
+
+    assert(list != NULL);
+
+    impl = __clist_rope_impl(list);
+
+    if (impl->root == NULL) {
+        return NULL;
+    }
+
+    return __clist_rope_take(impl, impl->root->size - 1);
+}
+
+void clist_rope_add_index(Clist *list, size_t index, ClistItem *item) {
+    ClistRope *impl = NULL;
+
+    assert(list != NULL);
+    assert(item != NULL);
+
+    impl = __clist_rope_impl(list);
+
+    if (index < __clist_rope_size(impl->root)) {
+        __clist_rope_insert_node(impl, index + 1, __clist_rope_node_create(impl, item));
+    }
+}
+
+void clist_rope_add_all(Clist *list, const Clist *other) {
+    ClistRope *impl = NULL;
+
+    assert(list != NULL);
+    assert(other != NULL);
+
+    impl = __clist_rope_impl(list);
+
+    __clist_rope_insert(impl, 0, __clist_rope_copy_list(impl, other));
+}
+
+void clist_rope_add_all_index(Clist *list, size_t index, const Clist *other) {
+    ClistRope *impl = NULL;
+
+    assert(list != NULL);
+    assert(other != NULL);
+
+    impl = __clist_rope_impl(list);
+
+    if (index < __clist_rope_size(impl->root)) {
+        __clist_rope_insert(impl, index + 1, __clist_rope_copy_list(impl, other));
+    }
+}
+
+/*
+ * builds a tree of nodes for some items, in O(n)
+ */
+static ClistRopeNode *__clist_rope_build_batch(ClistRope *list, ClistItem **items, size_t count) {
+    ClistRopeNode *first = NULL, **tail = &first;
+    size_t i = 0;
+
+    for (i = 0; i < count; i++) {
+        *tail = __clist_rope_node_create(list, items[i]);
+        tail = &(*tail)->left;
+    }
+
+    return __clist_rope_build(first);
+}
+
+void clist_rope_add_batch(Clist *list, ClistItem **items, size_t count) {
+    ClistRope *impl = NULL;
+
+    assert(list != NULL);
+    assert(items != NULL);
+
+    impl = __clist_rope_impl(list);
+
+    __clist_rope_insert(impl, 0, __clist_rope_build_batch(impl, items, count));
+}
+
+void clist_rope_add_batch_index(Clist *list, size_t index, ClistItem **items, size_t count) {
+    ClistRope *impl = NULL;
+
+    assert(list != NULL);
+    assert(items != NULL);
+
+    impl = __clist_rope_impl(list);
+
+    if (index < __clist_rope_size(impl->root)) {
+        __clist_rope_insert(impl, index + 1, __clist_rope_build_batch(impl, items, count));
+    }
+}
+
+void clist_rope_clear(Clist *list) {
+    ClistRope *impl = NULL;
+    ClistRopeNode *node = NULL, *next = NULL;
+
+    assert(list != NULL);
+
+    impl = __clist_rope_impl(list);
+
+    for (node = __clist_rope_chain(impl->root); node; node = next) {
+        next = node->left;
+        __clist_rope_node_destroy(node);
+    }
+
+    impl->root = NULL;
+}
+
+int clist_rope_contains(const Clist *list, const void *data) {
+    if (list == NULL) {
+        return 0;
+    }
+
+    return __clist_rope_find_node_data(__clist_rope_impl(list), data, NULL) != NULL;
+}
+
+typedef struct __clist_rope_count_arg {
+    const ClistRope *list;
+    int count;
+} ClistRopeCountArg;
+
+static ClistCallbackReturn __clist_rope_count_found(ClistItem *item, void *arg) {
+    ClistRopeCountArg *params = (ClistRopeCountArg *) arg;
+
+    if (__clist_rope_find_node_data(params->list, item->data, NULL) != NULL) {
+        params->count++;
+    }
+    return ClistIterateNext;
+}
+
+int clist_rope_contains_all(const Clist *list, const Clist *other) {
+    ClistRopeCountArg params;
+
+    if (list == NULL || other == NULL) {
+        return 0;
+    }
+
+    params.list = __clist_rope_impl(list);
+    params.count = 0;
+
+    __clist_visit(other, __clist_rope_count_found, &params);
+
+    return params.count;
+}
+
+ClistItem *clist_rope_get_item(const Clist *list, size_t index) {
+    ClistRopeNode *node = NULL;
+
+    if (list == NULL) {
+        return NULL;
+    }
+
+    node = __clist_rope_get_node(__clist_rope_impl(list), index);
+
+    if (node == NULL) {
+        return NULL;
+    }
+
+    return node->item;
+}
+
+void *clist_rope_get(const Clist *list, size_t index) {
+    ClistItem *item = clist_rope_get_item(list, index);
+
+    if (item == NULL) {
+        return NULL;
+    }
+
+    return item->data;
+}
+
+int clist_rope_remove_index(Clist *list, size_t index) {
+    ClistRopeNode *node = NULL;
+
+    if (list == NULL) {
+        return 0;
+    }
+
+    node = __clist_rope_detach(__clist_rope_impl(list), index);
+
+    if (node == NULL) {
+        return 0;
+    }
+
+    __clist_rope_node_destroy(node);
+
+    return 1;
+}
+
+int clist_rope_remove(Clist *list, const void *data) {
+    size_t index = 0;
+
+    if (list == NULL) {
+        return 0;
+    }
+
+    if (__clist_rope_find_node_data(__clist_rope_impl(list), data, &index) == NULL) {
+        return 0;
+    }
+
+    return clist_rope_remove_index(list, index);
+}
+
+typedef struct __clist_rope_remove_arg {
+    Clist *list;
+    int count;
+} ClistRopeRemoveArg;
+
+static ClistCallbackReturn __clist_rope_remove_found(ClistItem *item, void *arg) {
+    ClistRopeRemoveArg *params = (ClistRopeRemoveArg *) arg;
+
+    if (clist_rope_remove(params->list, item->data)) {
+        params->count++;
+    }
+    return ClistIterateNext;
+}
+
+int clist_rope_remove_all(Clist *list, const Clist *other) {
+    ClistRopeRemoveArg params;
+    int result = 0;
+
+    if (list == NULL || other == NULL) {
+        return 0;
+    }
+
+    /* removing a list from itself empties it */
+    if (list == other) {
+        result = (int) __clist_rope_size(__clist_rope_impl(list)->root);
+        clist_rope_clear(list);
+        return result;
+    }
+
+    params.list = list;
+    params.count = 0;
+
+    __clist_visit(other, __clist_rope_remove_found, &params);
+
+    return params.count;
+}
+
+int clist_rope_index_of(const Clist *list, const void *data) {
+    size_t index = 0;
+
+    if (list == NULL) {
+        return -1;
+    }
+
+    if (__clist_rope_find_node_data(__clist_rope_impl(list), data, &index) == NULL) {
+        return -1;
+    }
+
+    return (int) index;
+}
+
+void clist_rope_set(Clist *list, size_t index, ClistItem *item) {
+    ClistRopeNode *node = NULL;
+
+    if (list == NULL) {
+        return;
+    }
+
+    node = __clist_rope_get_node(__clist_rope_impl(list), index);
+
+    if (node == NULL) {
+        return;
+    }
+
+    __clist_rope_node_delete_item(node);
+
+    node->item = item;
+}
+
+size_t clist_rope_size(const Clist *list) {
+    if (list == NULL) {
+        return 0;
+    }
+
+    return __clist_rope_size(__clist_rope_impl(list)->root);
+}
+
+int clist_rope_is_empty(const Clist *list) {
+    assert(list != NULL);
+    return __clist_rope_impl(list)->root == NULL;
+}
+
+void clist_rope_sort_with(Clist *list, const ClistSortComparer *comparer) {
+    ClistRope *impl = NULL;
+
+    if (clist_size(list) <= 1) {
+        return;
+    }
+
+    impl = __clist_rope_impl(list);
+
+    /* the nodes keep their priorities, so the sorted tree is as balanced as before */
+    impl->root = __clist_rope_build(
+            __clist_sort_nodes(__clist_rope_chain(impl->root), offsetof(ClistRopeNode, item), comparer));
+}
+
+void clist_rope_sort(Clist *list) {
+    clist_rope_sort_with(list, NULL);
+}
+
+void clist_rope_sort_by_key(Clist *list, ClistKeyCallback key, void *ctx) {
+    ClistRope *impl = NULL;
+    size_t size = 0;
+
+    if ((size = clist_size(list)) <= 1) {
+        return;
+    }
+
+    impl = __clist_rope_impl(list);
+
+    impl->root = __clist_rope_build(__clist_sort_nodes_by_key(__clist_rope_chain(impl->root), size,
+                                                              offsetof(ClistRopeNode, item), key, ctx));
+}
+
+void clist_rope_transfer(Clist *list, size_t index, Clist *other, size_t from, size_t count) {
+    ClistRope *impl = NULL, *other_impl = NULL;
+    ClistRopeNode *left = NULL, *middle = NULL, *right = NULL;
+
+    assert(list != NULL);
+    assert(other != NULL);
+
+    impl = __clist_rope_impl(list);
+    other_impl = __clist_rope_impl(other);
+
+    assert(index <= __clist_rope_size(impl->root));
+    assert(count > 0 && from + count <= __clist_rope_size(other_impl->root));
+
+    __clist_rope_split(other_impl->root, from, &left, &middle);
+    __clist_rope_split(middle, count, &middle, &right);
+
+    other_impl->root = __clist_rope_root(__clist_rope_merge(left, right));
+
+    __clist_rope_insert(impl, index, __clist_rope_root(middle));
+}
+
+void clist_rope_for_each(Clist *list, ClistCallback callback) {
+    ClistRope *impl = NULL;
+    ClistRopeNode *node = NULL;
+    size_t index = 0, pos = 0;
+
+    assert(list != NULL);
+    assert(callback != NULL);
+
+    impl = __clist_rope_impl(list);
+
+    for (node = __clist_rope_first(impl->root); node;) {
+        switch (callback(list, index++, node->item)) {
+            case ClistIteratorBreak:
+                return;
+            case ClistIteratorDelete:
+                /* removing reshapes the tree, so find the next node by position */
+                __clist_rope_node_destroy(__clist_rope_detach(impl, pos));
+                node = __clist_rope_get_node(impl, pos);
+                break;
+            default:
+                node = __clist_rope_next(node);
+                pos++;
+                break;
+        }
+    }
+}
+
+/*
+ * the iterator node is the last node stepped over
+ */
+ClistItem *clist_rope_iter_next(ClistIterator *iter) {
+    ClistRope *impl = __clist_rope_impl(iter->list);
+    ClistRopeNode *node = (ClistRopeNode *) iter->node;
+
+    if (iter->index >= __clist_rope_size(impl->root)) {
+        return NULL;
+    }
+
+    node = node ? __clist_rope_next(node) : __clist_rope_first(impl->root);
+    iter->node = node;
+    iter->index++;
+
+    return node->item;
+}
+
+void clist_rope_iter_remove(ClistIterator *iter) {
+    ClistRopeNode *node = (ClistRopeNode *) iter->node;
+
+    iter->node = __clist_rope_prev(node);
+    iter->index--;
+
+    __clist_rope_unlink(__clist_rope_impl(iter->list), node);
+    __clist_rope_node_destroy(node);
+}
+
+int clist_rope_iter_insert(ClistIterator *iter, ClistItem *item) {
+    ClistRope *impl = __clist_rope_impl(iter->list);
+    ClistRopeNode *node = __clist_rope_node_create(impl, item);
+
+    __clist_rope_insert_node(impl, iter->index, node);
+
+    iter->node = node;
+    iter->index++;
+
+    return 1;
+}
+
+void clist_rope_visit(Clist *list, ClistVisitCallback callback, void *arg) {
+    ClistRope *impl = NULL;
+    ClistRopeNode *node = NULL;
+    size_t pos = 0;
+
+    assert(list != NULL);
+    assert(callback != NULL);
+
+    impl = __clist_rope_impl(list);
+
+    for (node = __clist_rope_first(impl->root); node;) {
+        switch (callback(node->item, arg)) {
+            case ClistIteratorBreak:
+                return;
+            case ClistIteratorDelete:
+                /* removing reshapes the tree, so find the next node by position */
+                __clist_rope_node_destroy(__clist_rope_detach(impl, pos));
+                node = __clist_rope_get_node(impl, pos);
+                break;
+            default:
+                node = __clist_rope_next(node);
+                pos++;
+                break;
+        }
+    }
+}
+
+static ClistVtable __clist_rope_table = {.create = clist_rope_new,
+        .destroy = clist_rope_delete,
+        .add = clist_rope_add,
+        .add_value = clist_rope_add_value,
+        .add_last = clist_rope_add_last,
+        .pop_first = clist_rope_pop_first,
+        .pop_last = clist_rope_pop_last,
+        .add_all = clist_rope_add_all,
+        .add_index = clist_rope_add_index,
+        .add_all_index = clist_rope_add_all_index,
+        .add_batch = clist_rope_add_batch,
+        .add_batch_index = clist_rope_add_batch_index,
+        .transfer = clist_rope_transfer,
+        .clear = clist_rope_clear,
+        .contains = clist_rope_contains,
+        .contains_all = clist_rope_contains_all,
+        .get = clist_rope_get,
+        .get_item = clist_rope_get_item,
+        .remove = clist_rope_remove,
+        .remove_index = clist_rope_remove_index,
+        .remove_all = clist_rope_remove_all,
+        .index_of = clist_rope_index_of,
+        .set = clist_rope_set,
+        .size = clist_rope_size,
+        .is_empty = clist_rope_is_empty,
+        .sort = clist_rope_sort,
+        .sort_with = clist_rope_sort_with,
+        .sort_by_key = clist_rope_sort_by_key,
+        .for_each = clist_rope_for_each,
+        .iter_next = clist_rope_iter_next,
+        .iter_remove = clist_rope_iter_remove,
+        .iter_insert = clist_rope_iter_insert,
+        .visit = clist_rope_visit};
+
+ClistVtable *__clist_rope_vtable() {
+    return &__clist_rope_table;
+}
@@ -1,4 +1,5 @@
 #include <assert.h>
+#include <stddef.h>
 #include <stdio.h>
 #include <stdlib.h>
 
@@ -10,41 +11,194 @@ typedef struct __clist_slist ClistSList;
 
 typedef struct __clist_slist_node ClistSListNode;
 
+/*
+ * a node may be fused with its item (and the item data), in a single allocation:
+ * [ node | item | data ], in which case node->item points after the node, each part aligned for any type.
+ */
 struct __clist_slist_node {
     ClistSListNode *next;
     ClistItem *item;
 };
 
+/*
+ * nodes are allocated with malloc by default, or from either a pool or an arena.
+ */
 struct __clist_slist {
     ClistSListNode *first;
     size_t size;
+    /* optional node allocator, fused nodes are never pooled */
+    ClistPool *pool;
+    /* the number of fused nodes added */
+    size_t fused;
+    /* optional allocator for all nodes, released only on clear */
+    ClistArena *arena;
+    /* the number of nodes with an item that is not fused, and must be deleted */
+    size_t owned;
+    /* the nodes added in batches, when there is no pool or arena */
+    ClistPool *batch;
+    /* the last node found by index, so sequential access resumes instead of restarting from first */
+    ClistSListNode *cursor;
+    size_t cursor_index;
 };
 
 extern void clist_single_clear(Clist *list);
 
+/*
+ * invalidates the cursor after a change that may shift the nodes before it
+ */
+static inline void __clist_slist_forget(ClistSList *list) {
+    list->cursor = NULL;
+    list->cursor_index = 0;
+}
+
 static inline ClistSList *__clist_slist_impl(const Clist *arg) {
     assert(arg->impl != NULL);
     return (ClistSList *) arg->impl;
 }
 
-static ClistSListNode *__clist_slist_node_create(ClistItem *item) {
+static ClistSListNode *__clist_slist_node_create(ClistSList *list, ClistItem *item) {
     ClistSListNode *node = NULL;
     assert(item != NULL);
-    node = malloc(sizeof(ClistSListNode));
+    if (list->arena != NULL) {
+        node = __clist_arena_alloc(list->arena, sizeof(ClistSListNode));
+    } else if (list->pool != NULL) {
+        node = __clist_pool_alloc(list->pool);
+    } else {
+        node = malloc(sizeof(ClistSListNode));
+    }
     assert(node != NULL);
     node->next = NULL;
     node->item = item;
+    list->owned++;
     return node;
 }
 
-static void __clist_slist_node_destroy(ClistSListNode *node) {
+/*
+ * the memory after a node for a fused item
+ */
+static inline void *__clist_slist_node_slot(const ClistSListNode *node) {
+    return (char *) node + CLIST_ALIGN_HEADER(sizeof(ClistSListNode));
+}
+
+static ClistSListNode *__clist_slist_node_alloc_fused(ClistSList *list, size_t size) {
+    ClistSListNode *node = NULL;
+    if (list->arena != NULL) {
+        node = __clist_arena_alloc(list->arena, CLIST_ALIGN_HEADER(sizeof(ClistSListNode)) + size);
+    } else {
+        node = malloc(CLIST_ALIGN_HEADER(sizeof(ClistSListNode)) + size);
+        list->fused++;
+    }
     assert(node != NULL);
+    node->next = NULL;
+    return node;
+}
+
+static ClistSListNode *__clist_slist_node_create_fused(ClistSList *list, const void *data, size_t size,
+                                                      const ClistItemType *type) {
+    ClistSListNode *node = NULL;
+    node = __clist_slist_node_alloc_fused(list, __clist_item_inline_size(size));
+    node->item = __clist_item_init_inline(__clist_slist_node_slot(node), data, size, type);
+    return node;
+}
+
+/*
+ * creates a node with a copy of an item.
+ * small plain data is copied inline with the node, in an arena list plain data of any size is
+ */
+static ClistSListNode *__clist_slist_node_copy(ClistSList *list, const ClistItem *orig) {
+    ClistSListNode *node = NULL;
+
+    assert(orig != NULL);
+
+    if (__clist_item_copies_inline(orig) || (list->arena != NULL && __clist_item_is_plain(orig))) {
+        node = __clist_slist_node_alloc_fused(list, __clist_item_inline_size(orig->size));
+        node->item = __clist_item_init_copy(__clist_slist_node_slot(node), orig);
+        return node;
+    }
+
+    if (list->arena == NULL) {
+        return __clist_slist_node_create(list, clist_item_copy(orig));
+    }
 
-    if (node->item != NULL) {
+    /* shared memory, copy the item only */
+    if ((orig->type->allocator == NULL || orig->type->copier == NULL) && orig->type->destructor == NULL) {
+        node = __clist_slist_node_alloc_fused(list, sizeof(ClistItem));
+        node->item = (ClistItem *) __clist_slist_node_slot(node);
+        *node->item = *orig;
+        return node;
+    }
+
+    return __clist_slist_node_create(list, clist_item_copy(orig));
+}
+
+static inline int __clist_slist_node_is_fused(const ClistSListNode *node) {
+    return node->item == (const ClistItem *) __clist_slist_node_slot(node);
+}
+
+static void __clist_slist_node_delete_item(ClistSList *list, ClistSListNode *node) {
+    if (node->item == NULL) {
+        return;
+    }
+
+    if (__clist_slist_node_is_fused(node)) {
+        __clist_item_release(node->item);
+    } else {
         clist_item_delete(node->item);
+        list->owned--;
+    }
+    node->item = NULL;
+}
+
+/*
+ * tests if a node came from the list pool
+ * when no fused nodes were added, every node in a pooled list is from the pool
+ */
+static inline int __clist_slist_node_is_pooled(const ClistSList *list, const ClistSListNode *node) {
+    return list->pool != NULL && (list->fused == 0 || __clist_pool_owns(list->pool, node));
+}
+
+static void __clist_slist_node_free(ClistSList *list, ClistSListNode *node) {
+    if (list->arena != NULL) {
+        return;
+    }
+
+    if (__clist_slist_node_is_pooled(list, node)) {
+        __clist_pool_free(list->pool, node);
+    } else if (list->batch != NULL && __clist_pool_owns(list->batch, node)) {
+        __clist_pool_free(list->batch, node);
+    } else {
+        free(node);
+    }
+}
+
+static void __clist_slist_node_destroy(ClistSList *list, ClistSListNode *node) {
+    assert(node != NULL);
+
+    __clist_slist_node_delete_item(list, node);
+
+    __clist_slist_node_free(list, node);
+}
+
+/*
+ * destroys a node, returning its item to be owned by the caller
+ */
+static ClistItem *__clist_slist_node_take(ClistSList *list, ClistSListNode *node) {
+    ClistItem *item = NULL;
+
+    assert(node != NULL);
+
+    /* a fused item can't outlive its node */
+    if (__clist_slist_node_is_fused(node)) {
+        item = clist_item_copy(node->item);
+    } else {
+        item = node->item;
+        node->item = NULL;
+        list->owned--;
     }
 
-    free(node);
+    __clist_slist_node_destroy(list, node);
+
+    return item;
 }
 
 void *clist_single_new() {
@@ -52,41 +206,105 @@ void *clist_single_new() {
     assert(list != NULL);
     list->first = NULL;
     list->size = 0;
+    list->pool = NULL;
+    list->fused = 0;
+    list->arena = NULL;
+    list->owned = 0;
+    list->batch = NULL;
+    list->cursor = NULL;
+    list->cursor_index = 0;
     return list;
 }
 
+void __clist_single_set_pool(Clist *list, size_t block_size) {
+    ClistSList *impl = NULL;
+
+    assert(list != NULL);
+
+    impl = __clist_slist_impl(list);
+
+    assert(impl->first == NULL);
+    assert(impl->pool == NULL && impl->arena == NULL);
+
+    impl->pool = __clist_pool_new(sizeof(ClistSListNode), block_size);
+}
+
+void __clist_single_set_arena(Clist *list, size_t block_size) {
+    ClistSList *impl = NULL;
+
+    assert(list != NULL);
+
+    impl = __clist_slist_impl(list);
+
+    assert(impl->first == NULL);
+    assert(impl->pool == NULL && impl->arena == NULL);
+
+    impl->arena = __clist_arena_new(block_size);
+}
+
 void clist_single_delete(Clist *list) {
+    ClistSList *impl = NULL;
+
     assert(list != NULL);
 
     clist_single_clear(list);
 
-    free(__clist_slist_impl(list));
+    impl = __clist_slist_impl(list);
+
+    __clist_pool_delete(impl->pool);
+
+    __clist_pool_delete(impl->batch);
+
+    __clist_arena_delete(impl->arena);
+
+    free(impl);
 }
 
-static void __clist_slist_node_insert_after(ClistSListNode *node, ClistItem *item) {
+/*
+ * inserts an item after a node.  the node is the last one or was just found by index,
+ * so it is never before the cursor and the cursor stays valid.
+ */
+static void __clist_slist_node_insert_after(ClistSList *list, ClistSListNode *node, ClistItem *item) {
     ClistSListNode *other = NULL;
 
     assert(node != NULL);
     assert(item != NULL);
 
-    other = __clist_slist_node_create(item);
+    other = __clist_slist_node_create(list, item);
 
     other->next = node->next;
     node->next = other;
 }
 
+/*
+ * gets a node by index, resuming from the cursor when the index is at or after it
+ */
 static ClistSListNode *__clist_slist_get_node(const ClistSList *list, size_t index) {
+    /* the cursor is a cache, updating it does not change the list */
+    ClistSList *impl = (ClistSList *) list;
     ClistSListNode *node = NULL;
     size_t pos = 0;
 
     assert(list != NULL);
 
-    for (node = list->first; node; node = node->next, pos++) {
-        if (index == pos) {
-            return node;
-        }
+    if (index >= list->size) {
+        return NULL;
     }
-    return NULL;
+
+    if (list->cursor != NULL && index >= list->cursor_index) {
+        node = list->cursor;
+        pos = list->cursor_index;
+    } else {
+        node = list->first;
+    }
+
+    for (; pos < index; node = node->next, pos++)
+        ;
+
+    impl->cursor = node;
+    impl->cursor_index = index;
+
+    return node;
 }
 
 static void __clist_slist_add_node(ClistSList *list, ClistSListNode *node) {
@@ -96,17 +314,59 @@ static void __clist_slist_add_node(ClistSList *list, ClistSListNode *node) {
     node->next = list->first;
     list->first = node;
     list->size++;
+
+    if (list->cursor != NULL) {
+        list->cursor_index++;
+    }
 }
 
 void clist_single_add(Clist *list, ClistItem *item) {
+    ClistSList *impl = NULL;
     ClistSListNode *node = NULL;
 
     assert(list != NULL);
     assert(item != NULL);
 
-    node = __clist_slist_node_create(item);
+    impl = __clist_slist_impl(list);
+
+    node = __clist_slist_node_create(impl, item);
 
-    __clist_slist_add_node(__clist_slist_impl(list), node);
+    __clist_slist_add_node(impl, node);
+}
+
+void clist_single_add_value(Clist *list, const void *data, size_t size, ClistCompareCallback comparer) {
+    ClistSList *impl = NULL;
+    const ClistItemType *type = NULL;
+
+    assert(list != NULL);
+
+    impl = __clist_slist_impl(list);
+
+    type = __clist_item_type_intern(comparer, NULL, NULL, NULL);
+
+    __clist_slist_add_node(impl, __clist_slist_node_create_fused(impl, data, size, type));
+}
+
+void clist_single_add_last(Clist *list, ClistItem *item) {
+    ClistSList *impl = NULL;
+    ClistSListNode *node = NULL;
+
+    assert(list != NULL);
+    assert(item != NULL);
+
+    impl = __clist_slist_impl(list);
+
+    if (impl->first == NULL) {
+        clist_single_add(list, item);
+        return;
+    }
+
+    /* no tail pointer, so this is a linear walk */
+    for (node = impl->first; node->next; node = node->next)
+        ;
+
+    __clist_slist_node_insert_after(impl, node, item);
+    impl->size++;
 }
 
 void clist_single_add_index(Clist *list, size_t index, ClistItem *item) {
@@ -121,43 +381,269 @@ void clist_single_add_index(Clist *list, size_t index, ClistItem *item) {
     node = __clist_slist_get_node(impl, index);
 
     if (node != NULL) {
-        __clist_slist_node_insert_after(node, item);
+        __clist_slist_node_insert_after(impl, node, item);
         impl->size++;
     }
 }
 
-void clist_single_add_all(Clist *list, const Clist *other) {
+/*
+ * links a chain of nodes after a node, or at the start of the list if after is NULL.
+ * the node is found by index, so it is the cursor and the cursor stays valid.
+ */
+static void __clist_slist_splice(ClistSList *list, ClistSListNode *after, ClistSListNode *first,
+                                 ClistSListNode *last, size_t count) {
+    if (after == NULL) {
+        last->next = list->first;
+        list->first = first;
+
+        if (list->cursor != NULL) {
+            list->cursor_index += count;
+        }
+    } else {
+        last->next = after->next;
+        after->next = first;
+    }
+
+    list->size += count;
+}
+
+/*
+ * creates a chain of nodes for some items, allocated together
+ * @param last set to the last node of the chain
+ * @return the first node of the chain
+ */
+static ClistSListNode *__clist_slist_chain_batch(ClistSList *list, ClistItem **items, size_t count,
+                                                 ClistSListNode **last) {
+    ClistSListNode *first = NULL, *node = NULL, **link = &first;
+    ClistPool *pool = list->pool;
+    char *block = NULL;
+    size_t i = 0;
+
+    assert(count > 0);
+
+    if (list->arena != NULL) {
+        block = __clist_arena_alloc(list->arena, count * sizeof(ClistSListNode));
+    } else {
+        if (pool == NULL) {
+            if (list->batch == NULL) {
+                list->batch = __clist_pool_new(sizeof(ClistSListNode), 0);
+            }
+            pool = list->batch;
+        }
+        __clist_pool_reserve(pool, count);
+    }
+
+    for (i = 0; i < count; i++) {
+        assert(items[i] != NULL);
+
+        node = block ? (ClistSListNode *) (block + i * sizeof(ClistSListNode)) : __clist_pool_alloc(pool);
+        node->item = items[i];
+        *link = node;
+        link = &node->next;
+    }
+
+    node->next = NULL;
+    list->owned += count;
+
+    *last = node;
+    return first;
+}
+
+void clist_single_add_batch(Clist *list, ClistItem **items, size_t count) {
     ClistSList *impl = NULL;
-    ClistSListNode *node = NULL;
+    ClistSListNode *first = NULL, *last = NULL;
+
+    assert(list != NULL);
+    assert(items != NULL);
+
+    if (count == 0) {
+        return;
+    }
+
+    impl = __clist_slist_impl(list);
+
+    first = __clist_slist_chain_batch(impl, items, count, &last);
+
+    __clist_slist_splice(impl, NULL, first, last, count);
+}
+
+void clist_single_add_batch_index(Clist *list, size_t index, ClistItem **items, size_t count) {
+    ClistSList *impl = NULL;
+    ClistSListNode *node = NULL, *first = NULL, *last = NULL;
+
+    assert(list != NULL);
+    assert(items != NULL);
+
+    impl = __clist_slist_impl(list);
+
+    node = __clist_slist_get_node(impl, index);
+
+    if (node == NULL || count == 0) {
+        return;
+    }
+
+    first = __clist_slist_chain_batch(impl, items, count, &last);
+
+    __clist_slist_splice(impl, node, first, last, count);
+}
+
+typedef struct __clist_slist_chain_arg {
+    ClistSList *list;
+    ClistSListNode *first;
+    ClistSListNode *last;
+    size_t count;
+} ClistSListChainArg;
+
+static ClistCallbackReturn __clist_slist_chain_copy(ClistItem *item, void *arg) {
+    ClistSListChainArg *params = (ClistSListChainArg *) arg;
+    ClistSListNode *node = __clist_slist_node_copy(params->list, item);
+
+    if (params->last) {
+        params->last->next = node;
+    } else {
+        params->first = node;
+    }
+
+    params->last = node;
+    params->count++;
+
+    return ClistIterateNext;
+}
+
+/*
+ * copies the items of another list into a detached chain of nodes, in order.
+ * nothing is linked into the list until the copy is done, so the other list can be the list.
+ */
+static void __clist_slist_copy_chain(ClistSList *list, const Clist *other, ClistSListChainArg *chain) {
+    chain->list = list;
+    chain->first = NULL;
+    chain->last = NULL;
+    chain->count = 0;
+
+    __clist_visit(other, __clist_slist_chain_copy, chain);
+}
+
+void clist_single_add_all(Clist *list, const Clist *other) {
+    ClistSListChainArg chain;
 
     assert(list != NULL);
     assert(other != NULL);
 
-    impl = __clist_slist_impl(other);
+    __clist_slist_copy_chain(__clist_slist_impl(list), other, &chain);
 
-    for (node = impl->first; node; node = node->next) {
-        clist_single_add(list, clist_item_copy(node->item));
+    if (chain.count > 0) {
+        __clist_slist_splice(chain.list, NULL, chain.first, chain.last, chain.count);
     }
 }
 
 void clist_single_add_all_index(Clist *list, size_t index, const Clist *other) {
     ClistSList *impl = NULL;
-    ClistSListNode *node = NULL, *other_node = NULL;
+    ClistSListNode *node = NULL;
+    ClistSListChainArg chain;
 
     assert(list != NULL);
     assert(other != NULL);
 
-    node = __clist_slist_get_node(__clist_slist_impl(list), index);
+    impl = __clist_slist_impl(list);
+
+    node = __clist_slist_get_node(impl, index);
 
     if (node == NULL) {
         return;
     }
 
-    impl = __clist_slist_impl(other);
+    __clist_slist_copy_chain(impl, other, &chain);
+
+    if (chain.count > 0) {
+        __clist_slist_splice(impl, node, chain.first, chain.last, chain.count);
+    }
+}
+
+/*
+ * moves a node unlinked from another list into the list.
+ * a node is relinked as is when both lists free it the same way, otherwise the item
+ * is moved to a new node of the list, copying only items fused with an arena node.
+ * @return the node to link into the list
+ */
+static ClistSListNode *__clist_slist_adopt(ClistSList *list, ClistSList *other, ClistSListNode *node) {
+    ClistSListNode *adopted = NULL;
+
+    if (list->pool == NULL && list->arena == NULL && other->arena == NULL &&
+        !__clist_slist_node_is_pooled(other, node) &&
+        (other->batch == NULL || !__clist_pool_owns(other->batch, node))) {
+        if (__clist_slist_node_is_fused(node)) {
+            list->fused++;
+        } else {
+            other->owned--;
+            list->owned++;
+        }
+        node->next = NULL;
+        return node;
+    }
+
+    if (__clist_slist_node_is_fused(node)) {
+        adopted = __clist_slist_node_copy(list, node->item);
+        __clist_slist_node_destroy(other, node);
+        return adopted;
+    }
+
+    adopted = __clist_slist_node_create(list, node->item);
+    node->item = NULL;
+    other->owned--;
+    __clist_slist_node_free(other, node);
+    return adopted;
+}
+
+void clist_single_transfer(Clist *list, size_t index, Clist *other, size_t from, size_t count) {
+    ClistSList *impl = NULL, *source = NULL;
+    ClistSListNode *before = NULL, *node = NULL, *next_node = NULL, *first = NULL, *last = NULL;
+    size_t i = 0;
+
+    assert(list != NULL);
+    assert(other != NULL);
+
+    impl = __clist_slist_impl(list);
+    source = __clist_slist_impl(other);
+
+    assert(index <= impl->size);
+    assert(count > 0 && from + count <= source->size);
+
+    /* cut the range out of the other list */
+    if (from > 0) {
+        before = __clist_slist_get_node(source, from - 1);
+        node = before->next;
+    } else {
+        node = source->first;
+    }
+
+    for (i = 0; i < count; i++) {
+        next_node = node->next;
+        node = __clist_slist_adopt(impl, source, node);
+
+        if (last) {
+            last->next = node;
+        } else {
+            first = node;
+        }
+        last = node;
+        node = next_node;
+    }
+
+    if (before) {
+        before->next = next_node;
+    } else {
+        source->first = next_node;
+    }
+
+    source->size -= count;
 
-    for (other_node = impl->first; other_node; other_node = other_node->next) {
-        clist_single_add_index(list, index, clist_item_copy(other_node->item));
+    if (source->cursor != NULL && source->cursor_index >= from + count) {
+        source->cursor_index -= count;
+    } else if (source->cursor != NULL && source->cursor_index >= from) {
+        __clist_slist_forget(source);
     }
+
+    __clist_slist_splice(impl, index > 0 ? __clist_slist_get_node(impl, index - 1) : NULL, first, last, count);
 }
 
 void clist_single_clear(Clist *list) {
@@ -168,12 +654,37 @@ void clist_single_clear(Clist *list) {
 
     impl = __clist_slist_impl(list);
 
-    for (node = impl->first; node; node = next_node) {
-        next_node = node->next;
-        __clist_slist_node_destroy(node);
+    if (impl->arena != NULL) {
+        /* arena memory is released all at once, only unfused items need deleting */
+        for (node = impl->first; node && impl->owned > 0; node = node->next) {
+            __clist_slist_node_delete_item(impl, node);
+        }
+        __clist_arena_reset(impl->arena);
+    } else if (impl->pool != NULL) {
+        /* pooled nodes are released with their blocks */
+        for (node = impl->first; node; node = next_node) {
+            next_node = node->next;
+            __clist_slist_node_delete_item(impl, node);
+            if (!__clist_slist_node_is_pooled(impl, node)) {
+                free(node);
+            }
+        }
+        __clist_pool_reset(impl->pool);
+        impl->fused = 0;
+    } else {
+        for (node = impl->first; node; node = next_node) {
+            next_node = node->next;
+            __clist_slist_node_destroy(impl, node);
+        }
+        if (impl->batch != NULL) {
+            __clist_pool_reset(impl->batch);
+        }
     }
     impl->first = NULL;
     impl->size = 0;
+    impl->owned = 0;
+
+    __clist_slist_forget(impl);
 }
 
 static ClistSListNode *__clist_slist_find_node_data(const ClistSList *list, const void *data) {
@@ -200,9 +711,7 @@ static ClistSListNode *__clist_slist_find_node_data(const ClistSList *list, cons
 }
 
 int clist_single_contains(const Clist *list, const void *data) {
-    ClistSList *impl = NULL;
     ClistSListNode *node = NULL;
-    ClistItem *item = NULL;
 
     if (list == NULL) {
         return 0;
@@ -217,30 +726,36 @@ int clist_single_contains(const Clist *list, const void *data) {
     return 1;
 }
 
-int clist_single_contains_all(const Clist *list, const Clist *other) {
-    ClistSList *impl = NULL;
-    ClistSListNode *node = NULL;
+typedef struct __clist_slist_count_arg {
+    const ClistSList *list;
+    int count;
+} ClistSListCountArg;
 
-    if (list == NULL || other == NULL) {
-        return 0;
+static ClistCallbackReturn __clist_slist_count_found(ClistItem *item, void *arg) {
+    ClistSListCountArg *params = (ClistSListCountArg *) arg;
+
+    if (__clist_slist_find_node_data(params->list, item->data) != NULL) {
+        params->count++;
     }
+    return ClistIterateNext;
+}
 
-    impl = __clist_slist_impl(other);
+int clist_single_contains_all(const Clist *list, const Clist *other) {
+    ClistSListCountArg params;
 
-    if (impl->first == NULL) {
+    if (list == NULL || other == NULL) {
         return 0;
     }
 
-    for (node = impl->first; node; node = node->next) {
-        if (clist_contains(list, node->item->data)) {
-            return 1;
-        }
-    }
+    params.list = __clist_slist_impl(list);
+    params.count = 0;
 
-    return 0;
+    __clist_visit(other, __clist_slist_count_found, &params);
+
+    return params.count;
 }
 
-void *clist_single_get(const Clist *list, size_t index) {
+ClistItem *clist_single_get_item(const Clist *list, size_t index) {
     ClistSListNode *node = NULL;
 
     if (list == NULL) {
@@ -248,11 +763,21 @@ void *clist_single_get(const Clist *list, size_t index) {
     }
     node = __clist_slist_get_node(__clist_slist_impl(list), index);
 
-    if (node == NULL || node->item == NULL) {
+    if (node == NULL) {
         return NULL;
     }
 
-    return node->item->data;
+    return node->item;
+}
+
+void *clist_single_get(const Clist *list, size_t index) {
+    ClistItem *item = clist_single_get_item(list, index);
+
+    if (item == NULL) {
+        return NULL;
+    }
+
+    return item->data;
 }
 
 static void __clist_slist_node_unlink(ClistSList *list, ClistSListNode *node, ClistSListNode *prev) {
@@ -264,6 +789,12 @@ static void __clist_slist_node_unlink(ClistSList *list, ClistSListNode *node, Cl
         list->first = node->next;
         node->next = NULL;
         list->size--;
+
+        if (list->cursor == node) {
+            __clist_slist_forget(list);
+        } else if (list->cursor != NULL) {
+            list->cursor_index--;
+        }
         return;
     }
 
@@ -279,9 +810,57 @@ static void __clist_slist_node_unlink(ClistSList *list, ClistSListNode *node, Cl
         prev->next = node->next;
         node->next = NULL;
         list->size--;
+
+        /* the position of an unlinked node is unknown, unless it was the cursor */
+        if (list->cursor == node) {
+            list->cursor = prev;
+            list->cursor_index--;
+        } else {
+            __clist_slist_forget(list);
+        }
     }
 }
 
+ClistItem *clist_single_pop_first(Clist *list) {
+    ClistSList *impl = NULL;
+    ClistSListNode *node = NULL;
+
+    assert(list != NULL);
+
+    impl = __clist_slist_impl(list);
+
+    node = impl->first;
+
+    if (node == NULL) {
+        return NULL;
+    }
+
+    __clist_slist_node_unlink(impl, node, NULL);
+
+    return __clist_slist_node_take(impl, node);
+}
+
+ClistItem *clist_single_pop_last(Clist *list) {
+    ClistSList *impl = NULL;
+    ClistSListNode *node = NULL, *prev = NULL;
+
+    assert(list != NULL);
+
+    impl = __clist_slist_impl(list);
+
+    if (impl->first == NULL) {
+        return NULL;
+    }
+
+    /* no tail pointer, so this is a linear walk */
+    for (node = impl->first; node->next; prev = node, node = node->next)
+        ;
+
+    __clist_slist_node_unlink(impl, node, prev);
+
+    return __clist_slist_node_take(impl, node);
+}
+
 int clist_single_remove(Clist *list, const void *item) {
     ClistSList *impl = NULL;
     ClistSListNode *node = NULL;
@@ -300,7 +879,33 @@ int clist_single_remove(Clist *list, const void *item) {
 
     __clist_slist_node_unlink(impl, node, NULL);
 
-    __clist_slist_node_destroy(node);
+    __clist_slist_node_destroy(impl, node);
+
+    return 1;
+}
+
+int clist_single_remove_item(Clist *list, ClistItem *item) {
+    ClistSList *impl = NULL;
+    ClistSListNode *node = NULL, *prev = NULL;
+
+    if (list == NULL) {
+        return 0;
+    }
+
+    impl = __clist_slist_impl(list);
+
+    /* found by identity, keeping the node before it to unlink without a second walk */
+    for (node = impl->first; node && node->item != item; node = node->next) {
+        prev = node;
+    }
+
+    if (node == NULL) {
+        return 0;
+    }
+
+    __clist_slist_node_unlink(impl, node, prev);
+
+    __clist_slist_node_destroy(impl, node);
 
     return 1;
 }
@@ -323,40 +928,53 @@ int clist_single_remove_index(Clist *list, size_t index) {
 
     __clist_slist_node_unlink(impl, node, NULL);
 
-    __clist_slist_node_destroy(node);
+    __clist_slist_node_destroy(impl, node);
 
     return 1;
 }
 
+typedef struct __clist_slist_remove_arg {
+    ClistSList *list;
+    int count;
+} ClistSListRemoveArg;
+
+static ClistCallbackReturn __clist_slist_remove_found(ClistItem *item, void *arg) {
+    ClistSListRemoveArg *params = (ClistSListRemoveArg *) arg;
+    ClistSListNode *found = NULL;
+
+    found = __clist_slist_find_node_data(params->list, item->data);
+
+    if (found) {
+        __clist_slist_node_unlink(params->list, found, NULL);
+
+        __clist_slist_node_destroy(params->list, found);
+
+        params->count++;
+    }
+    return ClistIterateNext;
+}
+
 int clist_single_remove_all(Clist *list, const Clist *other) {
-    ClistSList *impl = NULL, *oimpl = NULL;
-    ClistSListNode *node = NULL, *found = NULL, *prev = NULL;
+    ClistSListRemoveArg params;
     int result = 0;
 
     if (list == NULL || other == NULL) {
         return 0;
     }
 
-    impl = __clist_slist_impl(list);
-    oimpl = __clist_slist_impl(other);
-
-    for (node = oimpl->first; node; prev = node, node = node->next) {
-        if (node->item == NULL) {
-            continue;
-        }
-
-        found = __clist_slist_find_node_data(impl, node->item->data);
-
-        if (found) {
-            __clist_slist_node_unlink(impl, found, prev);
-
-            __clist_slist_node_destroy(found);
+    params.list = __clist_slist_impl(list);
+    params.count = 0;
 
-            result++;
-        }
+    /* removing a list from itself empties it */
+    if (list == other) {
+        result = (int) params.list->size;
+        clist_single_clear(list);
+        return result;
     }
 
-    return result;
+    __clist_visit(other, __clist_slist_remove_found, &params);
+
+    return params.count;
 }
 
 int clist_single_index_of(const Clist *list, const void *data) {
@@ -386,21 +1004,25 @@ int clist_single_index_of(const Clist *list, const void *data) {
 }
 
 void clist_single_set(Clist *list, size_t index, ClistItem *item) {
+    ClistSList *impl = NULL;
     ClistSListNode *node = NULL;
 
     if (list == NULL) {
         return;
     }
 
-    node = __clist_slist_get_node(__clist_slist_impl(list), index);
+    impl = __clist_slist_impl(list);
+
+    node = __clist_slist_get_node(impl, index);
 
     if (node == NULL) {
         return;
     }
 
-    clist_item_delete(node->item);
+    __clist_slist_node_delete_item(impl, node);
 
     node->item = item;
+    impl->owned++;
 }
 
 size_t clist_single_size(const Clist *list) {
@@ -422,127 +1044,158 @@ int clist_single_is_empty(const Clist *list) {
     return impl->size == 0 || impl->first == NULL;
 }
 
-static ClistSListNode *__clist_slist_merge_nodes(ClistSListNode *left, ClistSListNode *right) {
-    ClistSListNode *result = NULL, *last = NULL;
-    ClistSListNode *next = NULL;
-
-    while (left && right) {
-        // compare the two nodes
-        if (clist_item_compare(left->item, right->item->data) <= 0) {
-            // move the left up
-            next = left->next;
-            if (last == NULL) {
-                left->next = result;
-                result = left;
-            } else {
-                left->next = NULL;
-                last->next = left;
-            }
-            last = left;
-            left = next;
-        } else {
-            // move the right up
-            next = right->next;
-            if (last == NULL) {
-                right->next = result;
-                result = right;
-            } else {
-                right->next = NULL;
-                last->next = right;
-            }
-            last = right;
-            right = next;
-        }
+void clist_single_sort_with(Clist *list, const ClistSortComparer *comparer) {
+    ClistSList *impl = NULL;
+
+    // Base case. A list of zero or one elements is sorted, by definition.
+    if (clist_size(list) <= 1) {
+        return;
     }
 
-    if (left) {
-        // ensure left ends meet
-        if (last == NULL) {
-            result = left;
-        } else {
-            last->next = left;
-        }
-        // last might be needed in the next comparison
-        last = left;
+    impl = __clist_slist_impl(list);
+
+    impl->first = __clist_sort_nodes(impl->first, offsetof(ClistSListNode, item), comparer);
+
+    __clist_slist_forget(impl);
+}
+
+void clist_single_sort(Clist *list) {
+    clist_single_sort_with(list, NULL);
+}
+
+void clist_single_sort_by_key(Clist *list, ClistKeyCallback key, void *ctx) {
+    ClistSList *impl = NULL;
+
+    if (clist_size(list) <= 1) {
+        return;
     }
 
-    if (right) {
-        // ensure right ends meet
-        if (last == NULL) {
-            result = left;
-        } else {
-            last->next = right;
+    impl = __clist_slist_impl(list);
+
+    impl->first = __clist_sort_nodes_by_key(impl->first, impl->size, offsetof(ClistSListNode, item), key, ctx);
+
+    __clist_slist_forget(impl);
+}
+
+void clist_single_for_each(Clist *list, ClistCallback callback) {
+    ClistSListNode *node = NULL, *next_node = NULL;
+    ClistSListNode *prev = NULL;
+    ClistSList *impl = NULL;
+    size_t index = 0;
+
+    assert(list != NULL);
+    assert(callback != NULL);
+
+    impl = __clist_slist_impl(list);
+
+    for (node = impl->first; node; node = next_node) {
+        next_node = node->next;
+
+        switch (callback(list, index++, node->item)) {
+            case ClistIteratorBreak:
+                return;
+            case ClistIteratorDelete:
+                __clist_slist_node_unlink(impl, node, prev);
+                __clist_slist_node_destroy(impl, node);
+                break;
+            default:
+                prev = node;
+                break;
         }
-        last = right;
     }
-
-    return result;
 }
 
-/**
- * standard merge sort, O(n log n)
- * TODO: more efficient algorithm
+/*
+ * the iterator node is the last node stepped over, and prev the node before it
  */
-static ClistSListNode *__clist_slist_merge_sort(ClistSListNode *first) {
-    ClistSListNode *left = NULL;
-    ClistSListNode *right = NULL;
-    ClistSListNode *node = NULL, *node_next = NULL;
-    size_t pos = 0;
+ClistItem *clist_single_iter_next(ClistIterator *iter) {
+    ClistSList *impl = __clist_slist_impl(iter->list);
+    ClistSListNode *node = (ClistSListNode *) iter->node;
 
-    /* make sure we have 2 items at least */
-    if (first == NULL || first->next == NULL) {
-        return first;
+    if (iter->index >= impl->size) {
+        return NULL;
     }
 
-    /* this divides the list into two seperate lists.
-     * just alternating each consecutive item
-     */
-    for (node = first; node; node = node_next, pos++) {
-        node_next = node->next;
-        if (pos % 2 != 0) {
-            node->next = left;
-            left = node;
-        } else {
-            node->next = right;
-            right = node;
-        }
+    iter->prev = node;
+    node = node ? node->next : impl->first;
+    iter->node = node;
+    iter->index++;
+
+    return node->item;
+}
+
+void clist_single_iter_remove(ClistIterator *iter) {
+    ClistSList *impl = __clist_slist_impl(iter->list);
+    ClistSListNode *node = (ClistSListNode *) iter->node;
+
+    __clist_slist_node_unlink(impl, node, (ClistSListNode *) iter->prev);
+    __clist_slist_node_destroy(impl, node);
+
+    iter->node = iter->prev;
+    iter->index--;
+}
+
+int clist_single_iter_insert(ClistIterator *iter, ClistItem *item) {
+    ClistSList *impl = __clist_slist_impl(iter->list);
+    ClistSListNode *node = (ClistSListNode *) iter->node;
+
+    if (node == NULL) {
+        __clist_slist_add_node(impl, __clist_slist_node_create(impl, item));
+        node = impl->first;
+    } else {
+        /* the node may be before the cursor */
+        __clist_slist_forget(impl);
+        __clist_slist_node_insert_after(impl, node, item);
+        impl->size++;
+        node = node->next;
     }
 
-    left = __clist_slist_merge_sort(left);
-    right = __clist_slist_merge_sort(right);
+    iter->prev = NULL;
+    iter->node = node;
+    iter->index++;
 
-    return __clist_slist_merge_nodes(left, right);
+    return 1;
 }
 
-void clist_single_sort(Clist *list) {
+int clist_single_pool_stats(const Clist *list, ClistPoolStats *stats) {
     ClistSList *impl = NULL;
 
-    // Base case. A list of zero or one elements is sorted, by definition.
-    if (clist_size(list) <= 1) {
-        return;
-    }
+    assert(list != NULL);
 
     impl = __clist_slist_impl(list);
 
-    impl->first = __clist_slist_merge_sort(impl->first);
+    if (impl->pool == NULL) {
+        return 0;
+    }
+
+    __clist_pool_stats(impl->pool, stats);
+
+    return 1;
 }
 
-void clist_single_for_each(Clist *list, ClistCallback callback) {
-    ClistSListNode *node = NULL;
+void clist_single_visit(Clist *list, ClistVisitCallback callback, void *arg) {
+    ClistSListNode *node = NULL, *next_node = NULL;
     ClistSListNode *prev = NULL;
     ClistSList *impl = NULL;
-    size_t index = 0;
 
     assert(list != NULL);
     assert(callback != NULL);
 
     impl = __clist_slist_impl(list);
 
-    for (node = impl->first; node; prev = node, node = node->next) {
-        if (callback(list, index++, node->item) == ClistIteratorDelete) {
-            __clist_slist_node_unlink(impl, node, prev);
+    for (node = impl->first; node; node = next_node) {
+        next_node = node->next;
 
-            __clist_slist_node_destroy(node);
+        switch (callback(node->item, arg)) {
+            case ClistIteratorBreak:
+                return;
+            case ClistIteratorDelete:
+                __clist_slist_node_unlink(impl, node, prev);
+                __clist_slist_node_destroy(impl, node);
+                break;
+            default:
+                prev = node;
+                break;
         }
     }
 }
@@ -550,14 +1203,23 @@ void clist_single_for_each(Clist *list, ClistCallback callback) {
 static ClistVtable __clist_slist_vtable = {.create = clist_single_new,
         .destroy = clist_single_delete,
         .add = clist_single_add,
+        .add_value = clist_single_add_value,
+        .add_last = clist_single_add_last,
+        .pop_first = clist_single_pop_first,
+        .pop_last = clist_single_pop_last,
         .add_all = clist_single_add_all,
         .add_index = clist_single_add_index,
         .add_all_index = clist_single_add_all_index,
+        .add_batch = clist_single_add_batch,
+        .add_batch_index = clist_single_add_batch_index,
+        .transfer = clist_single_transfer,
         .clear = clist_single_clear,
         .contains = clist_single_contains,
         .contains_all = clist_single_contains_all,
         .get = clist_single_get,
+        .get_item = clist_single_get_item,
         .remove = clist_single_remove,
+        .remove_item = clist_single_remove_item,
         .remove_index = clist_single_remove_index,
         .remove_all = clist_single_remove_all,
         .index_of = clist_single_index_of,
@@ -565,8 +1227,15 @@ static ClistVtable __clist_slist_vtable = {.create = clist_single_new,
         .size = clist_single_size,
         .is_empty = clist_single_is_empty,
         .sort = clist_single_sort,
-        .for_each = clist_single_for_each};
-
-ClistVtable *clist_single_vtable() {
+        .sort_with = clist_single_sort_with,
+        .sort_by_key = clist_single_sort_by_key,
+        .pool_stats = clist_single_pool_stats,
+        .for_each = clist_single_for_each,
+        .iter_next = clist_single_iter_next,
+        .iter_remove = clist_single_iter_remove,
+        .iter_insert = clist_single_iter_insert,
+        .visit = clist_single_visit};
+
+ClistVtable *__clist_single_vtable() {
     return &__clist_slist_vtable;
 }
@@ -0,0 +1,563 @@
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <clist/list-item.h>
+#include "internal.h"
+
+/*
+ * enough pending runs for any list, the run lengths grow at least as fast as the fibonacci numbers
+ */
+#define CLIST_SORT_MAX_RUNS 96
+
+/*
+ * the fewest items each thread of a parallel sort is given, smaller sorts use fewer threads
+ */
+#define CLIST_SORT_PARALLEL_MIN 4096
+
+/*
+ * a node in a chain, the next link must be its first member
+ */
+typedef struct __clist_sort_link ClistSortLink;
+
+struct __clist_sort_link {
+    ClistSortLink *next;
+};
+
+typedef struct __clist_sort_run {
+    ClistSortLink *first;
+    size_t size;
+} ClistSortRun;
+
+static inline ClistItem *__clist_sort_item(const ClistSortLink *node, size_t item_offset) {
+    return *(ClistItem **) ((char *) node + item_offset);
+}
+
+static inline int __clist_sort_compare(const ClistItem *a, const ClistItem *b, const ClistSortComparer *comparer) {
+    if (comparer == NULL || comparer->compare == NULL) {
+        return clist_item_compare(a, b->data);
+    }
+    return (*comparer->compare)(a->data, b->data, a->size, comparer->ctx);
+}
+
+static inline int __clist_sort_compare_nodes(const ClistSortLink *a, const ClistSortLink *b, size_t item_offset,
+                                             const ClistSortComparer *comparer) {
+    return __clist_sort_compare(__clist_sort_item(a, item_offset), __clist_sort_item(b, item_offset), comparer);
+}
+
+/*
+ * detaches the next run from a chain, reversing it if it is strictly descending
+ * @param chain the chain, set to the rest of the chain
+ */
+static ClistSortRun __clist_sort_next_run(ClistSortLink **chain, size_t item_offset,
+                                          const ClistSortComparer *comparer) {
+    ClistSortRun run;
+    ClistSortLink *node = *chain, *next = node->next;
+
+    run.first = node;
+    run.size = 1;
+
+    if (next && __clist_sort_compare_nodes(next, node, item_offset, comparer) < 0) {
+        /* strictly, so that reversing keeps equal items in order */
+        node->next = NULL;
+
+        while (next && __clist_sort_compare_nodes(next, node, item_offset, comparer) < 0) {
+            node = next;
+            next = node->next;
+            node->next = run.first;
+            run.first = node;
+            run.size++;
+        }
+    } else {
+        while (next && __clist_sort_compare_nodes(next, node, item_offset, comparer) >= 0) {
+            node = next;
+            next = node->next;
+            run.size++;
+        }
+        node->next = NULL;
+    }
+
+    *chain = next;
+    return run;
+}
+
+/*
+ * merges two adjacent runs, taking from the left on ties
+ */
+static ClistSortRun __clist_sort_merge_runs(ClistSortRun left, ClistSortRun right, size_t item_offset,
+                                           const ClistSortComparer *comparer) {
+    ClistSortRun run;
+    ClistSortLink *a = left.first, *b = right.first;
+    ClistSortLink **tail = &run.first;
+
+    while (a && b) {
+        if (__clist_sort_compare_nodes(a, b, item_offset, comparer) <= 0) {
+            *tail = a;
+            a = a->next;
+        } else {
+            *tail = b;
+            b = b->next;
+        }
+        tail = &(*tail)->next;
+    }
+
+    *tail = a ? a : b;
+
+    run.size = left.size + right.size;
+    return run;
+}
+
+/*
+ * merges the pending run at a position with the one after it
+ */
+static void __clist_sort_merge_at(ClistSortRun *runs, size_t *count, size_t pos, size_t item_offset,
+                                  const ClistSortComparer *comparer) {
+    runs[pos] = __clist_sort_merge_runs(runs[pos], runs[pos + 1], item_offset, comparer);
+
+    memmove(runs + pos + 1, runs + pos + 2, (*count - pos - 2) * sizeof(ClistSortRun));
+
+    (*count)--;
+}
+
+/*
+ * merges pending runs until their sizes shrink faster than the fibonacci numbers
+ */
+static void __clist_sort_collapse(ClistSortRun *runs, size_t *count, size_t item_offset,
+                                  const ClistSortComparer *comparer) {
+    size_t n = 0;
+
+    while ((n = *count) > 1) {
+        if ((n >= 3 && runs[n - 3].size <= runs[n - 2].size + runs[n - 1].size) ||
+            (n >= 4 && runs[n - 4].size <= runs[n - 3].size + runs[n - 2].size)) {
+            if (runs[n - 3].size < runs[n - 1].size) {
+                __clist_sort_merge_at(runs, count, n - 3, item_offset, comparer);
+            } else {
+                __clist_sort_merge_at(runs, count, n - 2, item_offset, comparer);
+            }
+        } else if (runs[n - 2].size <= runs[n - 1].size) {
+            __clist_sort_merge_at(runs, count, n - 2, item_offset, comparer);
+        } else {
+            break;
+        }
+    }
+}
+
+/*
+ * part of a parallel sort, done by one thread
+ */
+typedef struct __clist_sort_task {
+    size_t item_offset;
+    const ClistSortComparer *comparer;
+    /* a chain to sort, or two adjacent chains to merge into the left */
+    ClistSortRun left;
+    ClistSortRun right;
+    /* a range of items to sort, or two adjacent ranges to merge with a buffer the size of the left */
+    ClistItem **items;
+    ClistItem **buf;
+    size_t left_size;
+    size_t right_size;
+} ClistSortTask;
+
+/*
+ * the number of threads to sort some items with, fewer than two to sort on the calling thread
+ */
+static size_t __clist_sort_threads(size_t size, const ClistSortComparer *comparer) {
+    size_t threads = comparer == NULL ? 1 : comparer->threads;
+
+    if (threads > size / CLIST_SORT_PARALLEL_MIN) {
+        threads = size / CLIST_SORT_PARALLEL_MIN;
+    }
+
+    return threads;
+}
+
+static ClistSortLink *__clist_sort_chain(ClistSortLink *chain, size_t item_offset, const ClistSortComparer *comparer) {
+    ClistSortRun runs[CLIST_SORT_MAX_RUNS];
+    size_t count = 0;
+
+    if (chain == NULL) {
+        return NULL;
+    }
+
+    while (chain) {
+        assert(count < CLIST_SORT_MAX_RUNS);
+
+        runs[count++] = __clist_sort_next_run(&chain, item_offset, comparer);
+
+        __clist_sort_collapse(runs, &count, item_offset, comparer);
+    }
+
+    while (count > 1) {
+        __clist_sort_merge_at(runs, &count, count - 2, item_offset, comparer);
+    }
+
+    return runs[0].first;
+}
+
+static void __clist_sort_chain_task(void *arg) {
+    ClistSortTask *task = (ClistSortTask *) arg;
+
+    task->left.first = __clist_sort_chain(task->left.first, task->item_offset, task->comparer);
+}
+
+static void __clist_sort_merge_task(void *arg) {
+    ClistSortTask *task = (ClistSortTask *) arg;
+
+    task->left = __clist_sort_merge_runs(task->left, task->right, task->item_offset, task->comparer);
+}
+
+/*
+ * cuts a chain into a part per thread, sorts the parts at the same time, then merges
+ * neighbouring parts in rounds, each round merging its pairs at the same time
+ */
+static ClistSortLink *__clist_sort_chain_parallel(ClistSortLink *chain, size_t item_offset,
+                                                  const ClistSortComparer *comparer) {
+    ClistSortTask *tasks = NULL;
+    ClistSortLink *node = NULL;
+    size_t size = 0, threads = 0, count = 0, part = 0, i = 0, j = 0;
+
+    for (node = chain; node; node = node->next) {
+        size++;
+    }
+
+    threads = __clist_sort_threads(size, comparer);
+
+    if (threads < 2) {
+        return __clist_sort_chain(chain, item_offset, comparer);
+    }
+
+    tasks = malloc(threads * sizeof(ClistSortTask));
+    assert(tasks != NULL);
+
+    for (i = 0; i < threads; i++) {
+        part = size / threads + (i < size % threads);
+
+        tasks[i].item_offset = item_offset;
+        tasks[i].comparer = comparer;
+        tasks[i].left.first = chain;
+        tasks[i].left.size = part;
+
+        for (j = 1; j < part; j++) {
+            chain = chain->next;
+        }
+
+        node = chain->next;
+        chain->next = NULL;
+        chain = node;
+    }
+
+    __clist_threads_run(tasks, sizeof(ClistSortTask), threads, __clist_sort_chain_task);
+
+    for (count = threads; count > 1; count = (count + 1) / 2) {
+        /* the left of each pair stays left, so equal items keep their order */
+        for (i = 0; i + 1 < count; i += 2) {
+            tasks[i / 2].left = tasks[i].left;
+            tasks[i / 2].right = tasks[i + 1].left;
+        }
+
+        __clist_threads_run(tasks, sizeof(ClistSortTask), count / 2, __clist_sort_merge_task);
+
+        if (count % 2) {
+            tasks[count / 2].left = tasks[count - 1].left;
+        }
+    }
+
+    chain = tasks[0].left.first;
+
+    free(tasks);
+
+    return chain;
+}
+
+void *__clist_sort_nodes(void *first, size_t item_offset, const ClistSortComparer *comparer) {
+    if (comparer != NULL && comparer->threads > 1) {
+        return __clist_sort_chain_parallel((ClistSortLink *) first, item_offset, comparer);
+    }
+
+    return __clist_sort_chain((ClistSortLink *) first, item_offset, comparer);
+}
+
+/*
+ * finds the size of the run at the start of an array, reversing it if it is strictly descending
+ */
+static size_t __clist_sort_items_run(ClistItem **items, size_t size, const ClistSortComparer *comparer) {
+    ClistItem *tmp = NULL;
+    size_t end = 1, lo = 0, hi = 0;
+
+    if (size < 2) {
+        return size;
+    }
+
+    if (__clist_sort_compare(items[1], items[0], comparer) < 0) {
+        while (end < size && __clist_sort_compare(items[end], items[end - 1], comparer) < 0) {
+            end++;
+        }
+
+        for (lo = 0, hi = end - 1; lo < hi; lo++, hi--) {
+            tmp = items[lo];
+            items[lo] = items[hi];
+            items[hi] = tmp;
+        }
+    } else {
+        while (end < size && __clist_sort_compare(items[end], items[end - 1], comparer) >= 0) {
+            end++;
+        }
+    }
+
+    return end;
+}
+
+/*
+ * merges two adjacent ranges of an array, using a buffer for the left range
+ */
+static void __clist_sort_items_merge(ClistItem **items, size_t left, size_t right, ClistItem **buf,
+                                     const ClistSortComparer *comparer) {
+    size_t a = 0, b = left, pos = 0;
+
+    memcpy(buf, items, left * sizeof(ClistItem *));
+
+    while (a < left && b < left + right) {
+        if (__clist_sort_compare(buf[a], items[b], comparer) <= 0) {
+            items[pos++] = buf[a++];
+        } else {
+            items[pos++] = items[b++];
+        }
+    }
+
+    memcpy(items + pos, buf + a, (left - a) * sizeof(ClistItem *));
+}
+
+static void __clist_sort_items_serial(ClistItem **items, size_t size, const ClistSortComparer *comparer) {
+    size_t starts[CLIST_SORT_MAX_RUNS], sizes[CLIST_SORT_MAX_RUNS];
+    ClistItem **buf = NULL;
+    size_t count = 0, pos = 0, n = 0, at = 0;
+
+    while (pos < size) {
+        assert(count < CLIST_SORT_MAX_RUNS);
+
+        starts[count] = pos;
+        sizes[count] = __clist_sort_items_run(items + pos, size - pos, comparer);
+        pos += sizes[count++];
+
+        /* same rules as the linked runs, merging everything once the array is consumed */
+        while ((n = count) > 1) {
+            if (pos == size) {
+                at = n - 2;
+            } else if ((n >= 3 && sizes[n - 3] <= sizes[n - 2] + sizes[n - 1]) ||
+                       (n >= 4 && sizes[n - 4] <= sizes[n - 3] + sizes[n - 2])) {
+                at = sizes[n - 3] < sizes[n - 1] ? n - 3 : n - 2;
+            } else if (sizes[n - 2] <= sizes[n - 1]) {
+                at = n - 2;
+            } else {
+                break;
+            }
+
+            if (buf == NULL) {
+                buf = malloc(size * sizeof(ClistItem *));
+                assert(buf != NULL);
+            }
+
+            __clist_sort_items_merge(items + starts[at], sizes[at], sizes[at + 1], buf, comparer);
+
+            sizes[at] += sizes[at + 1];
+
+            memmove(starts + at + 1, starts + at + 2, (count - at - 2) * sizeof(size_t));
+            memmove(sizes + at + 1, sizes + at + 2, (count - at - 2) * sizeof(size_t));
+            count--;
+        }
+    }
+
+    free(buf);
+}
+
+static void __clist_sort_items_task(void *arg) {
+    ClistSortTask *task = (ClistSortTask *) arg;
+
+    __clist_sort_items_serial(task->items, task->left_size, task->comparer);
+}
+
+static void __clist_sort_items_merge_task(void *arg) {
+    ClistSortTask *task = (ClistSortTask *) arg;
+
+    __clist_sort_items_merge(task->items, task->left_size, task->right_size, task->buf, task->comparer);
+
+    task->left_size += task->right_size;
+}
+
+void __clist_sort_items(ClistItem **items, size_t size, const ClistSortComparer *comparer) {
+    ClistSortTask *tasks = NULL;
+    ClistItem **buf = NULL;
+    size_t threads = __clist_sort_threads(size, comparer), count = 0, part = 0, pos = 0, i = 0;
+
+    if (threads < 2) {
+        __clist_sort_items_serial(items, size, comparer);
+        return;
+    }
+
+    tasks = malloc(threads * sizeof(ClistSortTask));
+    assert(tasks != NULL);
+
+    /* each pair of ranges merges through the part of the buffer under it */
+    buf = malloc(size * sizeof(ClistItem *));
+    assert(buf != NULL);
+
+    for (i = 0; i < threads; i++) {
+        part = size / threads + (i < size % threads);
+
+        tasks[i].comparer = comparer;
+        tasks[i].items = items + pos;
+        tasks[i].buf = buf + pos;
+        tasks[i].left_size = part;
+
+        pos += part;
+    }
+
+    __clist_threads_run(tasks, sizeof(ClistSortTask), threads, __clist_sort_items_task);
+
+    for (count = threads; count > 1; count = (count + 1) / 2) {
+        for (i = 0; i + 1 < count; i += 2) {
+            tasks[i / 2].items = tasks[i].items;
+            tasks[i / 2].buf = tasks[i].buf;
+            tasks[i / 2].left_size = tasks[i].left_size;
+            tasks[i / 2].right_size = tasks[i + 1].left_size;
+        }
+
+        __clist_threads_run(tasks, sizeof(ClistSortTask), count / 2, __clist_sort_items_merge_task);
+
+        if (count % 2) {
+            tasks[count / 2].items = tasks[count - 1].items;
+            tasks[count / 2].buf = tasks[count - 1].buf;
+            tasks[count / 2].left_size = tasks[count - 1].left_size;
+        }
+    }
+
+    free(buf);
+    free(tasks);
+}
+
+/*
+ * an item, or the node holding it, with its cached key
+ */
+typedef struct __clist_sort_entry {
+    /* the key with the sign bit flipped, so unsigned order matches signed order */
+    uint64_t key;
+    void *value;
+} ClistSortEntry;
+
+#define CLIST_SORT_RADIX_BITS 8
+
+#define CLIST_SORT_RADIX_SIZE (1 << CLIST_SORT_RADIX_BITS)
+
+/*
+ * least significant digit radix sort of the keys, stable and O(n).
+ * passes where every key has the same digit are skipped.
+ */
+static void __clist_sort_entries(ClistSortEntry *entries, size_t size) {
+    size_t counts[CLIST_SORT_RADIX_SIZE];
+    ClistSortEntry *buf = NULL, *from = entries, *to = NULL, *tmp = NULL;
+    size_t pos = 0, total = 0, digit = 0, count = 0;
+    unsigned int shift = 0;
+
+    if (size < 2) {
+        return;
+    }
+
+    buf = malloc(size * sizeof(ClistSortEntry));
+    assert(buf != NULL);
+
+    to = buf;
+
+    for (shift = 0; shift < 64; shift += CLIST_SORT_RADIX_BITS) {
+        memset(counts, 0, sizeof(counts));
+
+        for (pos = 0; pos < size; pos++) {
+            counts[(from[pos].key >> shift) & (CLIST_SORT_RADIX_SIZE - 1)]++;
+        }
+
+        if (counts[(from[0].key >> shift) & (CLIST_SORT_RADIX_SIZE - 1)] == size) {
+            continue;
+        }
+
+        for (digit = 0, total = 0; digit < CLIST_SORT_RADIX_SIZE; digit++) {
+            count = counts[digit];
+            counts[digit] = total;
+            total += count;
+        }
+
+        for (pos = 0; pos < size; pos++) {
+            to[counts[(from[pos].key >> shift) & (CLIST_SORT_RADIX_SIZE - 1)]++] = from[pos];
+        }
+
+        tmp = from;
+        from = to;
+        to = tmp;
+    }
+
+    if (from != entries) {
+        memcpy(entries, from, size * sizeof(ClistSortEntry));
+    }
+
+    free(buf);
+}
+
+static inline uint64_t __clist_sort_key(const ClistItem *item, ClistKeyCallback key, void *ctx) {
+    return (uint64_t) (*key)(item->data, item->size, ctx) ^ ((uint64_t) 1 << 63);
+}
+
+void *__clist_sort_nodes_by_key(void *first, size_t size, size_t item_offset, ClistKeyCallback key, void *ctx) {
+    ClistSortEntry *entries = NULL;
+    ClistSortLink *node = NULL;
+    size_t pos = 0;
+
+    if (size < 2) {
+        return first;
+    }
+
+    entries = malloc(size * sizeof(ClistSortEntry));
+    assert(entries != NULL);
+
+    for (node = (ClistSortLink *) first, pos = 0; node; node = node->next, pos++) {
+        assert(pos < size);
+        entries[pos].key = __clist_sort_key(__clist_sort_item(node, item_offset), key, ctx);
+        entries[pos].value = node;
+    }
+
+    __clist_sort_entries(entries, size);
+
+    for (pos = 0; pos < size; pos++) {
+        node = (ClistSortLink *) entries[pos].value;
+        node->next = pos + 1 < size ? (ClistSortLink *) entries[pos + 1].value : NULL;
+    }
+
+    first = entries[0].value;
+
+    free(entries);
+
+    return first;
+}
+
+void __clist_sort_items_by_key(ClistItem **items, size_t size, ClistKeyCallback key, void *ctx) {
+    ClistSortEntry *entries = NULL;
+    size_t pos = 0;
+
+    if (size < 2) {
+        return;
+    }
+
+    entries = malloc(size * sizeof(ClistSortEntry));
+    assert(entries != NULL);
+
+    for (pos = 0; pos < size; pos++) {
+        entries[pos].key = __clist_sort_key(items[pos], key, ctx);
+        entries[pos].value = items[pos];
+    }
+
+    __clist_sort_entries(entries, size);
+
+    for (pos = 0; pos < size; pos++) {
+        items[pos] = (ClistItem *) entries[pos].value;
+    }
+
+    free(entries);
+}
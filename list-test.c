@@ -1,6 +1,10 @@
 #include <assert.h>
+#include <pthread.h>
 #include <setjmp.h>
 #include <stdarg.h>
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -56,6 +60,224 @@ static int create_and_populate_test_list(void **state)
     return 0;
 }
 
+static int create_test_array(void **state)
+{
+    Clist *list = clist_new_array();
+    *state = list;
+
+    return 0;
+}
+
+static int create_and_populate_test_array(void **state)
+{
+    Clist *list = clist_new_array_with_capacity(2);
+
+    clist_add(list, random_list_item());
+
+    clist_add(list, random_list_item());
+
+    clist_add(list, random_list_item());
+
+    *state = list;
+
+    return 0;
+}
+
+static int create_test_unrolled(void **state)
+{
+    Clist *list = clist_new_unrolled(4);
+    *state = list;
+
+    return 0;
+}
+
+static int create_and_populate_test_unrolled(void **state)
+{
+    Clist *list = clist_new_unrolled(4);
+
+    clist_add(list, random_list_item());
+
+    clist_add(list, random_list_item());
+
+    clist_add(list, random_list_item());
+
+    *state = list;
+
+    return 0;
+}
+
+static int create_test_ordered(void **state)
+{
+    Clist *list = clist_new_ordered();
+    *state = list;
+
+    return 0;
+}
+
+static int create_and_populate_test_ordered(void **state)
+{
+    Clist *list = clist_new_ordered();
+
+    clist_add(list, random_list_item());
+
+    clist_add(list, random_list_item());
+
+    clist_add(list, random_list_item());
+
+    *state = list;
+
+    return 0;
+}
+
+static int create_test_double(void **state)
+{
+    Clist *list = clist_new_double();
+    *state = list;
+
+    return 0;
+}
+
+static int create_and_populate_test_double(void **state)
+{
+    Clist *list = clist_new_double();
+
+    clist_add(list, random_list_item());
+
+    clist_add_last(list, random_list_item());
+
+    clist_add(list, random_list_item());
+
+    *state = list;
+
+    return 0;
+}
+
+static int create_test_rope(void **state)
+{
+    Clist *list = clist_new_rope();
+    *state = list;
+
+    return 0;
+}
+
+static int create_and_populate_test_rope(void **state)
+{
+    Clist *list = clist_new_rope();
+
+    clist_add(list, random_list_item());
+
+    clist_add_last(list, random_list_item());
+
+    clist_add(list, random_list_item());
+
+    *state = list;
+
+    return 0;
+}
+
+/* large enough that the common tests never fill it */
+#define TEST_RING_CAPACITY 4096
+
+static int create_test_ring(void **state)
+{
+    Clist *list = clist_new_ring(TEST_RING_CAPACITY);
+    *state = list;
+
+    return 0;
+}
+
+static int create_and_populate_test_ring(void **state)
+{
+    Clist *list = clist_new_ring(TEST_RING_CAPACITY);
+
+    clist_add(list, random_list_item());
+
+    clist_add_last(list, random_list_item());
+
+    clist_add(list, random_list_item());
+
+    *state = list;
+
+    return 0;
+}
+
+static int create_test_concurrent(void **state)
+{
+    Clist *list = clist_new_concurrent(clist_new_single());
+    *state = list;
+
+    return 0;
+}
+
+static int create_and_populate_test_concurrent(void **state)
+{
+    Clist *list = clist_new_concurrent(clist_new_single());
+
+    clist_add(list, random_list_item());
+
+    clist_add_last(list, random_list_item());
+
+    clist_add(list, random_list_item());
+
+    *state = list;
+
+    return 0;
+}
+
+static int create_test_lockfree(void **state)
+{
+    Clist *list = clist_new_lockfree_stack();
+    *state = list;
+
+    return 0;
+}
+
+static int create_test_pooled(void **state)
+{
+    Clist *list = clist_new_single_pooled(4);
+    *state = list;
+
+    return 0;
+}
+
+static int create_and_populate_test_pooled(void **state)
+{
+    Clist *list = clist_new_single_pooled(2);
+
+    clist_add(list, random_list_item());
+
+    clist_add(list, random_list_item());
+
+    clist_add(list, random_list_item());
+
+    *state = list;
+
+    return 0;
+}
+
+static int create_test_arena(void **state)
+{
+    Clist *list = clist_new_single_arena(64);
+    *state = list;
+
+    return 0;
+}
+
+static int create_and_populate_test_arena(void **state)
+{
+    Clist *list = clist_new_single_arena(0);
+
+    clist_add(list, random_list_item());
+
+    clist_add(list, random_list_item());
+
+    clist_add(list, random_list_item());
+
+    *state = list;
+
+    return 0;
+}
+
 static int destroy_test_list(void **state)
 {
     Clist *list = (Clist *)*state;
@@ -519,77 +741,2632 @@ static void test_list_merge_sort_valid(void **state)
         assert_int_equal(*item, sorted_values[index]);
     }
 }
-static void test_list_sort_invalid(void **state)
+
+static void test_parallel_double(void *data, size_t size, void *ctx)
+{
+    *(int *)data *= *(int *)ctx;
+}
+
+static int64_t test_parallel_value(const void *data, size_t size)
+{
+    return *(const int *)data;
+}
+
+static int64_t test_parallel_sum(int64_t a, int64_t b)
+{
+    return a + b;
+}
+
+/* keeps the later value, so it only gives the last item if the parts are combined in order */
+static int64_t test_parallel_last(int64_t a, int64_t b)
+{
+    return b == -1 ? a : b;
+}
+
+static void test_list_parallel(void **state)
 {
     Clist *list = (Clist *)*state;
 
-    clist_sort(NULL);
+    static int values[1000];
+
+    int num_values = sizeof(values) / sizeof(values[0]);
+
+    int index = 0, factor = 2;
+
+    assert_int_equal(clist_parallel_reduce(list, test_parallel_value, test_parallel_sum, 0, 4), 0);
+
+    for (index = 0; index < num_values; index++) {
+        values[index] = index;
+        clist_add_last(list, clist_item_new_static(&values[index], sizeof(int), test_int_compare));
+    }
+
+    clist_parallel_for_each(list, test_parallel_double, &factor, 4);
+
+    for (index = 0; index < num_values; index++) {
+        assert_int_equal(*(int *)clist_get(list, index), index * 2);
+    }
+
+    assert_int_equal(clist_parallel_reduce(list, test_parallel_value, test_parallel_sum, 0, 4),
+                     num_values * (num_values - 1));
+
+    /* the threads are reused, and more of them than parts is fine */
+    assert_int_equal(clist_parallel_reduce(list, test_parallel_value, test_parallel_last, -1, 64),
+                     *(int *)clist_get(list, num_values - 1));
+
+    assert_int_equal(clist_parallel_reduce(list, test_parallel_value, test_parallel_sum, 0, 1),
+                     num_values * (num_values - 1));
 }
 
-static void test_list_partition(void **state)
+/* enough items for three threads */
+#define TEST_SORT_PARALLEL_SIZE 12388
+
+static void test_list_sort_parallel(void **state)
 {
     Clist *list = (Clist *)*state;
 
-    int partition = 5;
+    /* compared by the first value only, the second is the original order */
+    static int values[TEST_SORT_PARALLEL_SIZE][2];
 
-    int values[] = {3, 5, 8, 5, 10, 2, 1};
+    int index = 0;
 
-    int expected[] = {3, 1, 2, 10, 5, 5, 8};
+    int *item = NULL, *prev = NULL;
+
+    /* runs and noise with plenty of equal keys, across the parts given to each thread */
+    for (index = 0; index < TEST_SORT_PARALLEL_SIZE; index++) {
+        if (index % 4000 < 1000) {
+            values[index][0] = (4000 - index % 4000) / 7;
+        } else {
+            values[index][0] = (index * 37) % 500;
+        }
+        values[index][1] = index;
+        clist_add_last(list, clist_item_new_static(values[index], sizeof(int), test_int_compare));
+    }
 
-    size_t num_values = sizeof(values) / sizeof(values[0]);
+    /* more threads than the list is split between */
+    clist_sort_parallel(list, 8);
 
-    for (int i = 0; i < num_values; i++) {
-        clist_add(list, clist_item_new_static(&values[i], sizeof(int), test_int_compare));
+    assert_int_equal(clist_size(list), TEST_SORT_PARALLEL_SIZE);
+
+    for (index = 1; index < TEST_SORT_PARALLEL_SIZE; index++) {
+        prev = (int *)clist_get(list, index - 1);
+        item = (int *)clist_get(list, index);
+
+        assert_true(prev[0] < item[0] || (prev[0] == item[0] && prev[1] < item[1]));
     }
 
-    assert_int_equal(clist_size(list), num_values);
+    clist_sort_parallel(list, 2);
 
-    ClistItem *head;
+    assert_int_equal(((int *)clist_get(list, 0))[1], 1000);
 }
 
-int run_list_tests()
+static void test_list_sort_stable(void **state)
 {
-    const struct CMUnitTest valid_tests[] = {
-        cmocka_unit_test_setup_teardown(test_list_add_valid, create_test_list, destroy_test_list),
-        cmocka_unit_test_setup_teardown(test_list_add_index_valid, create_and_populate_test_list, destroy_test_list),
-        cmocka_unit_test_setup_teardown(test_list_add_all_valid, create_and_populate_test_list, destroy_test_list),
-        cmocka_unit_test_setup_teardown(test_list_add_all_index_valid, create_and_populate_test_list,
-                                        destroy_test_list),
-        cmocka_unit_test_setup_teardown(test_list_clear_valid, create_and_populate_test_list, destroy_test_list),
-        cmocka_unit_test_setup_teardown(test_list_contains_valid, create_and_populate_test_list, destroy_test_list),
-        cmocka_unit_test_setup_teardown(test_list_contains_all_valid, create_and_populate_test_list, destroy_test_list),
-        cmocka_unit_test_setup_teardown(test_list_get_valid, create_and_populate_test_list, destroy_test_list),
-        cmocka_unit_test_setup_teardown(test_list_remove_valid, create_and_populate_test_list, destroy_test_list),
-        cmocka_unit_test_setup_teardown(test_list_remove_index_valid, create_and_populate_test_list, destroy_test_list),
-        cmocka_unit_test_setup_teardown(test_list_remove_all_valid, create_and_populate_test_list, destroy_test_list),
-        cmocka_unit_test_setup_teardown(test_list_index_of_valid, create_and_populate_test_list, destroy_test_list),
-        cmocka_unit_test_setup_teardown(test_list_set_valid, create_and_populate_test_list, destroy_test_list),
-        cmocka_unit_test_setup_teardown(test_list_size_valid, create_and_populate_test_list, destroy_test_list),
-        cmocka_unit_test_setup_teardown(test_list_is_empty_valid, create_and_populate_test_list, destroy_test_list),
-        cmocka_unit_test_setup_teardown(test_list_merge_sort_valid, create_test_list, destroy_test_list)};
+    Clist *list = (Clist *)*state;
 
-    const struct CMUnitTest invalid_tests[] = {
-        cmocka_unit_test_setup_teardown(test_list_add_invalid, create_test_list, destroy_test_list),
-        cmocka_unit_test_setup_teardown(test_list_add_index_invalid, create_and_populate_test_list, destroy_test_list),
-        cmocka_unit_test_setup_teardown(test_list_add_all_invalid, create_and_populate_test_list, destroy_test_list),
-        cmocka_unit_test_setup_teardown(test_list_add_all_index_invalid, create_and_populate_test_list,
-                                        destroy_test_list),
-        cmocka_unit_test_setup_teardown(test_list_clear_invalid, create_and_populate_test_list, destroy_test_list),
-        cmocka_unit_test_setup_teardown(test_list_contains_invalid, create_and_populate_test_list, destroy_test_list),
-        cmocka_unit_test_setup_teardown(test_list_contains_all_invalid, create_and_populate_test_list,
-                                        destroy_test_list),
-        cmocka_unit_test_setup_teardown(test_list_get_invalid, create_and_populate_test_list, destroy_test_list),
-        cmocka_unit_test_setup_teardown(test_list_remove_invalid, create_and_populate_test_list, destroy_test_list),
-        cmocka_unit_test_setup_teardown(test_list_remove_index_invalid, create_and_populate_test_list,
-                                        destroy_test_list),
-        cmocka_unit_test_setup_teardown(test_list_remove_all_invalid, create_and_populate_test_list, destroy_test_list),
-        cmocka_unit_test_setup_teardown(test_list_index_of_invalid, create_and_populate_test_list, destroy_test_list),
-        cmocka_unit_test_setup_teardown(test_list_set_invalid, create_and_populate_test_list, destroy_test_list),
-        cmocka_unit_test_setup_teardown(test_list_size_invalid, create_and_populate_test_list, destroy_test_list),
-        cmocka_unit_test_setup_teardown(test_list_is_empty_invalid, create_and_populate_test_list, destroy_test_list),
-        cmocka_unit_test_setup_teardown(test_list_sort_invalid, create_test_list, destroy_test_list)};
+    /* compared by the first value only, the second is the original order */
+    int values[300][2];
 
-    int rval = cmocka_run_group_tests_name("list valid tests", valid_tests, NULL, NULL);
+    int index = 0;
+
+    int num_values = sizeof(values) / sizeof(values[0]);
+
+    int *item = NULL, *prev = NULL;
+
+    /* a descending run, an ascending run and some noise, with plenty of equal keys */
+    for (index = 0; index < num_values; index++) {
+        if (index < 100) {
+            values[index][0] = (100 - index) / 3;
+        } else if (index < 200) {
+            values[index][0] = (index - 100) / 3;
+        } else {
+            values[index][0] = (index * 37) % 50;
+        }
+        values[index][1] = index;
+        clist_add_last(list, clist_item_new_static(values[index], sizeof(int), test_int_compare));
+    }
+
+    clist_sort(list);
+
+    assert_int_equal(clist_size(list), num_values);
+
+    for (index = 1; index < num_values; index++) {
+        prev = (int *)clist_get(list, index - 1);
+        item = (int *)clist_get(list, index);
+
+        assert_true(prev[0] <= item[0]);
+
+        if (prev[0] == item[0]) {
+            assert_true(prev[1] < item[1]);
+        }
+    }
+
+    /* sorting again leaves the order as is */
+    clist_sort(list);
+
+    for (index = 1; index < num_values; index++) {
+        prev = (int *)clist_get(list, index - 1);
+        item = (int *)clist_get(list, index);
+
+        assert_true(prev[0] < item[0] || (prev[0] == item[0] && prev[1] < item[1]));
+    }
+}
+
+/* compares the field selected by the context, in descending order */
+static int test_field_compare(const void *a, const void *b, size_t size, void *ctx)
+{
+    size_t field = *(size_t *)ctx;
+
+    return ((const int *)b)[field] - ((const int *)a)[field];
+}
+
+static int64_t test_field_key(const void *data, size_t size, void *ctx)
+{
+    size_t field = *(size_t *)ctx;
+
+    return ((const int *)data)[field];
+}
+
+static void test_list_sort_with_context(void **state)
+{
+    Clist *list = (Clist *)*state;
+
+    int values[200][3];
+
+    int index = 0;
+
+    int num_values = sizeof(values) / sizeof(values[0]);
+
+    size_t field = 0;
+
+    int *item = NULL, *prev = NULL;
+
+    for (index = 0; index < num_values; index++) {
+        values[index][0] = (index * 37) % 50;
+        values[index][1] = (index * 11) % 7 - 3;
+        values[index][2] = index;
+        clist_add_last(list, clist_item_new_static(values[index], sizeof(values[index]), test_int_compare));
+    }
+
+    field = 1;
+
+    clist_sort_with(list, test_field_compare, &field);
+
+    for (index = 1; index < num_values; index++) {
+        prev = (int *)clist_get(list, index - 1);
+        item = (int *)clist_get(list, index);
+
+        assert_true(prev[1] > item[1] || (prev[1] == item[1] && prev[2] < item[2]));
+    }
+
+    /* keys can be negative, equal keys keep the descending order of the second field */
+    field = 0;
+
+    clist_sort_by_key(list, test_field_key, &field);
+
+    for (index = 1; index < num_values; index++) {
+        prev = (int *)clist_get(list, index - 1);
+        item = (int *)clist_get(list, index);
+
+        assert_true(prev[0] <= item[0]);
+
+        if (prev[0] == item[0]) {
+            assert_true(prev[1] > item[1] || (prev[1] == item[1] && prev[2] < item[2]));
+        }
+    }
+
+    field = 1;
+
+    clist_sort_by_key(list, test_field_key, &field);
+
+    assert_int_equal(((int *)clist_get(list, 0))[1], -3);
+
+    assert_int_equal(((int *)clist_get(list, num_values - 1))[1], 3);
+}
+
+static size_t test_int_hash(const void *data)
+{
+    return (size_t) *(const int *)data;
+}
+
+#define TEST_INDEX_DUPLICATES 20000
+
+static void test_list_hash_index_duplicates(void **state)
+{
+    Clist *list = (Clist *)*state;
+
+    ClistItem *item = NULL;
+
+    int same = 7, other = 8, missing = -1;
+
+    int index = 0;
+
+    clist_enable_hash_index(list, test_int_hash);
+
+    /* equal items share a bucket, so adding and removing them stays constant time */
+    for (index = 0; index < TEST_INDEX_DUPLICATES; index++) {
+        clist_add(list, clist_item_new_static(&same, sizeof(int), test_int_compare));
+    }
+
+    clist_add_last(list, clist_item_new_static(&other, sizeof(int), test_int_compare));
+
+    assert_int_not_equal(clist_contains(list, &same), 0);
+
+    assert_int_equal(clist_contains(list, &missing), 0);
+
+    assert_int_equal(clist_index_of(list, &other), TEST_INDEX_DUPLICATES);
+
+    for (index = 0; index < TEST_INDEX_DUPLICATES / 2; index++) {
+        item = clist_pop_first(list);
+        clist_item_delete(item);
+    }
+
+    for (index = 0; index < TEST_INDEX_DUPLICATES / 2 - 1; index++) {
+        assert_int_not_equal(clist_remove(list, &same), 0);
+    }
+
+    assert_int_not_equal(clist_contains(list, &same), 0);
+
+    assert_int_equal(clist_index_of(list, &other), 1);
+
+    assert_int_not_equal(clist_remove(list, &same), 0);
+
+    assert_int_equal(clist_contains(list, &same), 0);
+
+    assert_int_equal(clist_index_of(list, &other), 0);
+}
+
+static void test_list_hash_index(void **state)
+{
+    Clist *list = (Clist *)*state;
+
+    Clist *other = clist_new_single();
+
+    ClistItem *item = NULL;
+
+    int values[200];
+
+    int index = 0;
+
+    int num_values = sizeof(values) / sizeof(values[0]);
+
+    int missing = -1;
+
+    /* half the values are duplicated */
+    for (index = 0; index < num_values; index++) {
+        values[index] = index % (num_values / 2);
+    }
+
+    for (index = 0; index < num_values / 2; index++) {
+        clist_add_last(list, clist_item_new_static(&values[index], sizeof(int), test_int_compare));
+    }
+
+    clist_enable_hash_index(list, test_int_hash);
+
+    for (index = num_values / 2; index < num_values; index++) {
+        clist_add_value(list, &values[index], sizeof(int), test_int_compare);
+    }
+
+    assert_int_equal(clist_size(list), num_values);
+
+    assert_int_equal(clist_contains(list, &missing), 0);
+
+    assert_int_equal(clist_index_of(list, &missing), -1);
+
+    assert_int_equal(clist_remove(list, &missing), 0);
+
+    /* the copies were prepended in reverse, so the first match is a copy */
+    for (index = 0; index < num_values / 2; index++) {
+        assert_int_not_equal(clist_contains(list, &values[index]), 0);
+        assert_int_equal(clist_index_of(list, &values[index]), num_values / 2 - 1 - index);
+    }
+
+    clist_set(list, 0, clist_item_new_static(&missing, sizeof(int), test_int_compare));
+
+    assert_int_equal(clist_index_of(list, &missing), 0);
+
+    assert_int_equal(clist_index_of(list, &values[num_values / 2 - 1]), num_values - 1);
+
+    item = clist_pop_first(list);
+
+    clist_item_delete(item);
+
+    assert_int_equal(clist_contains(list, &missing), 0);
+
+    /* removing one of two equal items leaves the other */
+    assert_int_not_equal(clist_remove(list, &values[0]), 0);
+
+    assert_int_not_equal(clist_contains(list, &values[0]), 0);
+
+    assert_int_not_equal(clist_remove(list, &values[0]), 0);
+
+    assert_int_equal(clist_contains(list, &values[0]), 0);
+
+    clist_add(other, clist_item_new_static(&values[1], sizeof(int), test_int_compare));
+
+    clist_add(other, clist_item_new_static(&missing, sizeof(int), test_int_compare));
+
+    assert_int_equal(clist_contains_all(list, other), 1);
+
+    clist_add_all(list, other);
+
+    assert_int_not_equal(clist_contains(list, &missing), 0);
+
+    assert_int_equal(clist_remove_all(list, other), 2);
+
+    assert_int_equal(clist_contains(list, &missing), 0);
+
+    assert_int_not_equal(clist_contains(list, &values[1]), 0);
+
+    item = clist_pop_last(list);
+
+    assert_int_equal(clist_index_of(list, clist_item_data(item)), -1);
+
+    clist_item_delete(item);
+
+    clist_clear(list);
+
+    assert_int_equal(clist_contains(list, &values[1]), 0);
+
+    clist_disable_hash_index(list);
+
+    clist_delete(other);
+}
+
+static void test_list_parallel_indexed(void **state)
+{
+    Clist *list = (Clist *)*state;
+
+    static int values[1000];
+
+    int num_values = sizeof(values) / sizeof(values[0]);
+
+    int index = 0, factor = 2, key = 0;
+
+    clist_enable_hash_index(list, test_int_hash);
+
+    for (index = 0; index < num_values; index++) {
+        values[index] = index;
+        clist_add_last(list, clist_item_new_static(&values[index], sizeof(int), test_int_compare));
+    }
+
+    /* the keys change under the index, which is rebuilt once the threads are done */
+    clist_parallel_for_each(list, test_parallel_double, &factor, 4);
+
+    for (index = 0; index < num_values; index++) {
+        key = index * 2;
+        assert_true(clist_contains(list, &key));
+        assert_int_equal(clist_index_of(list, &key), index);
+    }
+
+    key = num_values - 1;
+
+    assert_false(clist_contains(list, &key));
+
+    assert_int_equal(clist_index_of(list, &key), -1);
+
+    clist_disable_hash_index(list);
+}
+
+static void test_list_join_strategies(void **state)
+{
+    Clist *list = (Clist *)*state;
+
+    Clist *other = clist_new_array();
+
+    ClistJoinStrategy strategies[] = {ClistJoinScan, ClistJoinHash, ClistJoinSort, ClistJoinAuto, ClistJoinHash};
+
+    int num_strategies = sizeof(strategies) / sizeof(strategies[0]);
+
+    int values[80];
+
+    int index = 0, strategy = 0, pos = 0;
+
+    int num_values = sizeof(values) / sizeof(values[0]);
+
+    for (index = 0; index < num_values; index++) {
+        values[index] = index;
+    }
+
+    /* one of the values is to be removed twice */
+    for (index = 40; index < num_values; index++) {
+        clist_add_last(other, clist_item_new_static(&values[index], sizeof(int), test_int_compare));
+    }
+
+    clist_add_last(other, clist_item_new_static(&values[50], sizeof(int), test_int_compare));
+
+    for (strategy = 0; strategy < num_strategies; strategy++) {
+        /* the last hash strategy has no hash function and sorts instead */
+        clist_set_join_strategy(list, strategies[strategy], strategy < num_strategies - 1 ? test_int_hash : NULL);
+
+        clist_clear(list);
+
+        /* the values up to 60, twice */
+        for (index = 0; index < 120; index++) {
+            clist_add_last(list, clist_item_new_static(&values[index % 60], sizeof(int), test_int_compare));
+        }
+
+        assert_int_equal(clist_contains_all(list, other), 21);
+
+        assert_int_equal(clist_remove_all(list, other), 21);
+
+        assert_int_equal(clist_size(list), 99);
+
+        /* the first matches are removed */
+        for (index = 0, pos = 0; index < 40; index++, pos++) {
+            assert_int_equal(*(int *)clist_get(list, pos), index);
+        }
+
+        for (index = 0; index < 60; index++) {
+            if (index != 50) {
+                assert_int_equal(*(int *)clist_get(list, pos++), index);
+            }
+        }
+
+        assert_int_equal(clist_contains_all(list, other), 19);
+    }
+
+    clist_delete(other);
+}
+
+static int test_hash_calls = 0;
+
+static size_t test_counted_hash(const void *data)
+{
+    test_hash_calls++;
+
+    return test_int_hash(data);
+}
+
+static void test_list_join_sort_with_hash(void **state)
+{
+    Clist *list = (Clist *)*state;
+
+    Clist *other = clist_new_array();
+
+    Clist *result = NULL;
+
+    int values[40];
+
+    int index = 0;
+
+    int num_values = sizeof(values) / sizeof(values[0]);
+
+    for (index = 0; index < num_values; index++) {
+        values[index] = num_values - index - 1;
+        clist_add_last(list, clist_item_new_static(&values[index], sizeof(int), test_int_compare));
+    }
+
+    for (index = 0; index < num_values; index += 2) {
+        clist_add_last(other, clist_item_new_static(&values[index], sizeof(int), test_int_compare));
+    }
+
+    /* a hash function doesn't make the sort strategy hash */
+    clist_set_join_strategy(list, ClistJoinSort, test_counted_hash);
+
+    test_hash_calls = 0;
+
+    assert_int_equal(clist_contains_all(list, other), 20);
+
+    result = clist_intersection(list, other);
+    assert_int_equal(clist_size(result), 20);
+    clist_delete(result);
+
+    assert_int_equal(clist_remove_all(list, other), 20);
+
+    assert_int_equal(clist_size(list), 20);
+
+    assert_int_equal(test_hash_calls, 0);
+
+    clist_delete(other);
+}
+
+static void test_assert_range(const Clist *list, int first, int count)
+{
+    int index = 0;
+
+    assert_int_equal(clist_size(list), count);
+
+    for (index = 0; index < count; index++) {
+        assert_int_equal(*(int *)clist_get(list, index), first + index);
+    }
+}
+
+static void test_list_set_operations(void **state)
+{
+    Clist *list = (Clist *)*state;
+
+    Clist *other = clist_new_array();
+
+    Clist *result = NULL;
+
+    int values[15];
+
+    int index = 0, hashed = 0;
+
+    int num_values = sizeof(values) / sizeof(values[0]);
+
+    for (index = 0; index < num_values; index++) {
+        values[index] = index;
+    }
+
+    for (index = 0; index < 20; index++) {
+        clist_add_last(list, clist_item_new_static(&values[index % 10], sizeof(int), test_int_compare));
+    }
+
+    for (index = 5; index < num_values; index++) {
+        clist_add_last(other, clist_item_new_static(&values[index], sizeof(int), test_int_compare));
+    }
+
+    clist_add_last(other, clist_item_new_static(&values[5], sizeof(int), test_int_compare));
+
+    /* sorted, then hashed */
+    for (hashed = 0; hashed < 2; hashed++) {
+        clist_set_join_strategy(list, ClistJoinAuto, hashed ? test_int_hash : NULL);
+
+        result = clist_unique(list);
+        test_assert_range(result, 0, 10);
+        clist_delete(result);
+
+        result = clist_union(list, other);
+        test_assert_range(result, 0, 15);
+        clist_delete(result);
+
+        result = clist_intersection(list, other);
+        test_assert_range(result, 5, 5);
+        clist_delete(result);
+
+        result = clist_difference(list, other);
+        test_assert_range(result, 0, 5);
+        clist_delete(result);
+    }
+
+    assert_int_equal(clist_size(list), 20);
+
+    assert_int_equal(clist_unique_in_place(list), 10);
+    test_assert_range(list, 0, 10);
+
+    assert_int_equal(clist_intersection_in_place(list, other), 5);
+    test_assert_range(list, 5, 5);
+
+    assert_int_equal(clist_union_in_place(list, other), 10);
+    test_assert_range(list, 5, 10);
+
+    assert_int_equal(clist_difference_in_place(list, other), 0);
+
+    clist_delete(other);
+}
+
+static int test_key_compare(const void *a, const void *b, size_t size)
+{
+    return ((const int *)a)[0] - ((const int *)b)[0];
+}
+
+static void test_list_ordered(void **state)
+{
+    Clist *list = (Clist *)*state;
+
+    ClistIterator iter;
+
+    ClistItem *item = NULL;
+
+    int values[500][2];
+
+    int key[2] = {0, 0};
+
+    int *prev = NULL, *data = NULL;
+
+    int index = 0;
+
+    int num_values = sizeof(values) / sizeof(values[0]);
+
+    /* the keys repeat, the second field is the order they were added in */
+    for (index = 0; index < num_values; index++) {
+        values[index][0] = (index * 37) % 100;
+        values[index][1] = index;
+
+        if (index % 2) {
+            clist_add_value(list, values[index], sizeof(values[index]), test_key_compare);
+        } else {
+            clist_add_last(list, clist_item_new_static(values[index], sizeof(values[index]), test_key_compare));
+        }
+    }
+
+    assert_int_equal(clist_size(list), num_values);
+
+    for (index = 1; index < num_values; index++) {
+        prev = (int *)clist_get(list, index - 1);
+        data = (int *)clist_get(list, index);
+
+        assert_true(prev[0] < data[0] || (prev[0] == data[0] && prev[1] < data[1]));
+    }
+
+    for (key[0] = 0; key[0] < 100; key[0]++) {
+        assert_int_equal(clist_index_of(list, key), key[0] * 5);
+    }
+
+    key[0] = 100;
+
+    assert_int_equal(clist_contains(list, key), 0);
+
+    assert_int_equal(clist_index_of(list, key), -1);
+
+    /* the first of the equal items is removed */
+    key[0] = 50;
+
+    assert_int_not_equal(clist_remove(list, key), 0);
+
+    assert_int_equal(clist_index_of(list, key), 250);
+
+    assert_int_equal(((int *)clist_get(list, 250))[1], 150);
+
+    assert_int_not_equal(clist_remove_index(list, 0), 0);
+
+    assert_int_equal(clist_size(list), num_values - 2);
+
+    item = clist_pop_last(list);
+
+    assert_int_equal(((int *)clist_item_data(item))[0], 99);
+
+    clist_item_delete(item);
+
+    /* a replaced item moves to its place in the order */
+    key[0] = 100;
+
+    clist_set(list, 0, clist_item_new_static(key, sizeof(key), test_key_compare));
+
+    assert_int_equal(clist_index_of(list, key), num_values - 4);
+
+    assert_int_equal(clist_size(list), num_values - 3);
+    /* an iterator removes in order, and inserts where the item belongs */
+    for (clist_iter_begin(list, &iter); (item = clist_iter_next(&iter)) != NULL;) {
+        if (((int *)clist_item_data(item))[0] % 2) {
+            clist_iter_remove(&iter);
+        } else if (((int *)clist_item_data(item))[0] == 50) {
+            clist_iter_insert_after(&iter, clist_item_new_static(values[2], sizeof(values[2]), test_key_compare));
+        }
+    }
+
+    for (index = 1; index < (int)clist_size(list); index++) {
+        prev = (int *)clist_get(list, index - 1);
+        data = (int *)clist_get(list, index);
+
+        assert_int_equal(data[0] % 2, 0);
+
+        assert_true(prev[0] <= data[0]);
+    }
+
+    assert_int_equal(((int *)clist_get(list, 0))[0], 0);
+}
+
+static void test_list_rope_split_concat(void **state)
+{
+    Clist *list = (Clist *)*state;
+
+    Clist *rest = NULL;
+
+    int values[1000];
+
+    int index = 0;
+
+    int num_values = sizeof(values) / sizeof(values[0]);
+
+    /* inserting in the middle puts the odd values after the even ones before them */
+    for (index = 0; index < num_values; index += 2) {
+        values[index] = index;
+        clist_add_last(list, clist_item_new_static(&values[index], sizeof(int), test_int_compare));
+    }
+
+    for (index = 1; index < num_values; index += 2) {
+        values[index] = index;
+        clist_add_index(list, index - 1, clist_item_new_static(&values[index], sizeof(int), test_int_compare));
+    }
+
+    for (index = 0; index < num_values; index++) {
+        assert_int_equal(*(int *)clist_get(list, index), index);
+    }
+
+    rest = clist_split(list, 600);
+
+    assert_int_equal(clist_size(list), 600);
+
+    assert_int_equal(clist_size(rest), num_values - 600);
+
+    assert_int_equal(*(int *)clist_get(rest, 0), 600);
+
+    assert_int_not_equal(clist_remove_index(rest, 0), 0);
+
+    clist_concat(rest, list);
+
+    assert_int_equal(clist_size(list), 0);
+
+    assert_int_equal(clist_size(rest), num_values - 1);
+
+    assert_int_equal(*(int *)clist_get(rest, 0), 601);
+
+    assert_int_equal(*(int *)clist_get(rest, num_values - 601), 0);
+
+    assert_int_equal(clist_index_of(rest, &values[599]), num_values - 2);
+
+    clist_sort(rest);
+
+    for (index = 0; index < num_values - 1; index++) {
+        assert_int_equal(*(int *)clist_get(rest, index), index < 600 ? index : index + 1);
+    }
+
+    clist_delete(rest);
+}
+
+static void test_list_sort_invalid(void **state)
+{
+    Clist *list = (Clist *)*state;
+
+    clist_sort(NULL);
+}
+
+static void test_list_array_order(void **state)
+{
+    Clist *list = (Clist *)*state;
+
+    Clist *other = clist_new_single();
+
+    int values[100];
+
+    int index = 0;
+
+    int num_values = sizeof(values) / sizeof(values[0]);
+
+    /* prepends and inserts grow both ends of the array */
+    for (index = num_values - 1; index >= 0; index--) {
+        values[index] = index;
+        if (index % 2 == 0) {
+            clist_add(list, clist_item_new_static(&values[index], sizeof(int), test_int_compare));
+        }
+    }
+
+    for (index = 1; index < num_values; index += 2) {
+        clist_add_index(list, index - 1, clist_item_new_static(&values[index], sizeof(int), test_int_compare));
+    }
+
+    assert_int_equal(clist_size(list), num_values);
+
+    for (index = 0; index < num_values; index++) {
+        assert_int_equal(*(int *)clist_get(list, index), index);
+        assert_int_equal(clist_index_of(list, &values[index]), index);
+    }
+
+    clist_add_all(other, list);
+
+    assert_int_equal(clist_size(other), num_values);
+
+    assert_int_equal(clist_remove_all(list, other), num_values);
+
+    assert_int_not_equal(clist_is_empty(list), 0);
+
+    clist_delete(other);
+}
+
+static void test_list_unrolled_balance(void **state)
+{
+    Clist *list = (Clist *)*state;
+
+    int values[64];
+
+    int index = 0;
+
+    int num_values = sizeof(values) / sizeof(values[0]);
+
+    for (index = 0; index < num_values; index++) {
+        values[index] = index;
+        clist_add_last(list, clist_item_new_static(&values[index], sizeof(int), test_int_compare));
+    }
+
+    /* removing from the middle merges and borrows between nodes */
+    for (index = num_values / 2; index < num_values * 3 / 4; index++) {
+        assert_int_not_equal(clist_remove(list, &values[index]), 0);
+    }
+
+    assert_int_equal(clist_size(list), num_values * 3 / 4);
+
+    for (index = 0; index < (int) clist_size(list); index++) {
+        assert_int_equal(*(int *)clist_get(list, index), index < num_values / 2 ? index : index + num_values / 4);
+    }
+
+    for (index = 1; index < num_values; index += 2) {
+        clist_remove(list, &values[index]);
+    }
+
+    assert_int_equal(clist_size(list), num_values * 3 / 8);
+
+    for (index = 0; index < (int) clist_size(list); index++) {
+        assert_int_equal(clist_index_of(list, clist_get(list, index)), index);
+        assert_int_equal(*(int *)clist_get(list, index) % 2, 0);
+    }
+
+    while (!clist_is_empty(list)) {
+        clist_item_delete(clist_pop_last(list));
+    }
+
+    assert_null(clist_pop_first(list));
+}
+
+static void test_list_queue(void **state)
+{
+    Clist *list = (Clist *)*state;
+
+    ClistItem *item = NULL;
+
+    int values[] = {1, 2, 3, 4, 5};
+
+    size_t num_values = sizeof(values) / sizeof(values[0]);
+
+    size_t index = 0;
+
+    assert_null(clist_pop_first(list));
+
+    assert_null(clist_pop_last(list));
+
+    for (index = 0; index < num_values; index++) {
+        clist_add_last(list, clist_item_new_static(&values[index], sizeof(int), test_int_compare));
+    }
+
+    assert_int_equal(clist_size(list), num_values);
+
+    item = clist_pop_last(list);
+
+    assert_int_equal(*(int *)clist_item_data(item), 5);
+
+    clist_item_delete(item);
+
+    for (index = 0; index < num_values - 1; index++) {
+        item = clist_pop_first(list);
+
+        assert_non_null(item);
+
+        assert_int_equal(*(int *)clist_item_data(item), values[index]);
+
+        clist_item_delete(item);
+    }
+
+    assert_int_not_equal(clist_is_empty(list), 0);
+}
+
+static void test_assert_sequence(const Clist *list, const int *expected, size_t count)
+{
+    size_t index = 0;
+
+    assert_int_equal(clist_size(list), count);
+
+    for (index = 0; index < count; index++) {
+        assert_int_equal(*(int *)clist_get(list, index), expected[index]);
+    }
+
+    for (index = count; index > 0; index--) {
+        assert_int_equal(*(int *)clist_get(list, index - 1), expected[index - 1]);
+    }
+}
+
+static void test_list_sequential_access(void **state)
+{
+    Clist *list = (Clist *)*state;
+
+    static int values[100];
+
+    static int extra[] = {-1, -2, -3};
+
+    int expected[102];
+
+    size_t count = sizeof(values) / sizeof(values[0]);
+
+    size_t index = 0;
+
+    for (index = 0; index < count; index++) {
+        values[index] = (int)index;
+        expected[index] = (int)index;
+        clist_add_last(list, clist_item_new_static(&values[index], sizeof(int), test_int_compare));
+    }
+
+    test_assert_sequence(list, expected, count);
+
+    /* removing at and before the last position read */
+    assert_non_null(clist_get(list, 50));
+    assert_int_not_equal(clist_remove_index(list, 50), 0);
+    memmove(expected + 50, expected + 51, (--count - 50) * sizeof(int));
+    assert_int_equal(*(int *)clist_get(list, 50), expected[50]);
+
+    assert_non_null(clist_get(list, 60));
+    assert_int_not_equal(clist_remove_index(list, 20), 0);
+    memmove(expected + 20, expected + 21, (--count - 20) * sizeof(int));
+    assert_int_equal(*(int *)clist_get(list, 60), expected[60]);
+
+    /* adding before the last position read */
+    assert_non_null(clist_get(list, 70));
+    clist_add(list, clist_item_new_static(&extra[0], sizeof(int), test_int_compare));
+    memmove(expected + 1, expected, count++ * sizeof(int));
+    expected[0] = extra[0];
+    assert_int_equal(*(int *)clist_get(list, 70), expected[70]);
+
+    assert_non_null(clist_get(list, 80));
+    clist_add_index(list, 30, clist_item_new_static(&extra[1], sizeof(int), test_int_compare));
+    memmove(expected + 32, expected + 31, (count++ - 31) * sizeof(int));
+    expected[31] = extra[1];
+    assert_int_equal(*(int *)clist_get(list, 80), expected[80]);
+
+    clist_add_index(list, 90, clist_item_new_static(&extra[2], sizeof(int), test_int_compare));
+    memmove(expected + 92, expected + 91, (count++ - 91) * sizeof(int));
+    expected[91] = extra[2];
+
+    test_assert_sequence(list, expected, count);
+
+    clist_item_delete(clist_pop_first(list));
+    memmove(expected, expected + 1, --count * sizeof(int));
+
+    assert_non_null(clist_get(list, count - 1));
+    clist_item_delete(clist_pop_last(list));
+    count--;
+
+    test_assert_sequence(list, expected, count);
+
+    clist_sort(list);
+
+    for (index = 1; index < count; index++) {
+        assert_true(*(int *)clist_get(list, index - 1) <= *(int *)clist_get(list, index));
+    }
+}
+
+static ClistCallbackReturn test_delete_odd(Clist *list, size_t index, ClistItem *item)
+{
+    return *(int *)clist_item_data(item) % 2 ? ClistIteratorDelete : ClistIterateNext;
+}
+
+static void test_list_for_each(void **state)
+{
+    Clist *list = (Clist *)*state;
+
+    static int values[10];
+
+    size_t count = sizeof(values) / sizeof(values[0]);
+
+    size_t index = 0;
+
+    for (index = 0; index < count; index++) {
+        values[index] = (int)index;
+        clist_add_last(list, clist_item_new_static(&values[index], sizeof(int), test_int_compare));
+    }
+
+    clist_enable_hash_index(list, test_int_hash);
+
+    clist_for_each(list, test_delete_odd);
+
+    assert_int_equal(clist_size(list), count / 2);
+
+    for (index = 0; index < count / 2; index++) {
+        assert_int_equal(*(int *)clist_get(list, index), values[index * 2]);
+    }
+
+    assert_int_equal(clist_contains(list, &values[3]), 0);
+}
+
+static void test_list_add_batch(void **state)
+{
+    Clist *list = (Clist *)*state;
+
+    ClistItem *items[64];
+
+    static int values[64];
+
+    size_t count = sizeof(values) / sizeof(values[0]);
+
+    size_t index = 0;
+
+    for (index = 0; index < count; index++) {
+        values[index] = (int)index;
+    }
+
+    clist_enable_hash_index(list, test_int_hash);
+
+    clist_add_last(list, clist_item_new_static(&values[62], sizeof(int), test_int_compare));
+
+    clist_add_last(list, clist_item_new_static(&values[63], sizeof(int), test_int_compare));
+
+    for (index = 0; index < 30; index++) {
+        items[index] = clist_item_new_static(&values[index], sizeof(int), test_int_compare);
+    }
+
+    clist_add_batch(list, items, 30);
+
+    for (index = 0; index < 32; index++) {
+        items[index] = clist_item_new_static(&values[index + 30], sizeof(int), test_int_compare);
+    }
+
+    clist_add_batch_index(list, 29, items, 32);
+
+    assert_int_equal(clist_size(list), count);
+
+    for (index = 0; index < count; index++) {
+        assert_int_equal(*(int *)clist_get(list, index), values[index]);
+    }
+
+    assert_int_equal(clist_index_of(list, &values[40]), 40);
+
+    /* past the end nothing is taken */
+    clist_add_batch_index(list, count, items, 1);
+
+    assert_int_equal(clist_size(list), count);
+
+    /* the nodes are released one at a time, and can be allocated again */
+    for (index = 0; index < count; index += 2) {
+        assert_int_not_equal(clist_remove(list, &values[index]), 0);
+    }
+
+    for (index = 0; index < count / 2; index++) {
+        items[index] = clist_item_new_static(&values[index * 2], sizeof(int), test_int_compare);
+    }
+
+    clist_add_batch_index(list, 0, items, count / 2);
+
+    assert_int_equal(clist_size(list), count);
+
+    assert_int_equal(*(int *)clist_get(list, 0), values[1]);
+
+    assert_int_equal(*(int *)clist_get(list, 1), values[0]);
+
+    assert_int_equal(*(int *)clist_get(list, count / 2), values[count - 2]);
+
+    assert_int_not_equal(clist_contains(list, &values[10]), 0);
+
+    clist_clear(list);
+
+    for (index = 0; index < 8; index++) {
+        items[index] = clist_item_new_static(&values[index], sizeof(int), test_int_compare);
+    }
+
+    clist_add_batch(list, items, 8);
+
+    assert_int_equal(*(int *)clist_get(list, 7), values[7]);
+}
+
+static void test_list_add_all_order(void **state)
+{
+    Clist *list = (Clist *)*state;
+
+    Clist *other = clist_new_single();
+
+    static int values[] = {0, 1, 2, 3, 4, 10, 11, 12};
+
+    int expected[] = {10, 11, 12, 0, 10, 11, 12, 1, 2, 3, 4};
+
+    size_t count = sizeof(expected) / sizeof(expected[0]);
+
+    size_t index = 0;
+
+    for (index = 0; index < 5; index++) {
+        clist_add_last(list, clist_item_new_static(&values[index], sizeof(int), test_int_compare));
+    }
+
+    for (index = 5; index < 8; index++) {
+        clist_add_last(other, clist_item_new_static(&values[index], sizeof(int), test_int_compare));
+    }
+
+    clist_add_all(list, other);
+
+    clist_add_all_index(list, 3, other);
+
+    assert_int_equal(clist_size(list), count);
+
+    for (index = 0; index < count; index++) {
+        assert_int_equal(*(int *)clist_get(list, index), expected[index]);
+    }
+
+    /* adding a list to itself copies the items as they were */
+    clist_add_all_index(list, count - 1, list);
+
+    assert_int_equal(clist_size(list), count * 2);
+
+    for (index = 0; index < count * 2; index++) {
+        assert_int_equal(*(int *)clist_get(list, index), expected[index % count]);
+    }
+
+    clist_delete(other);
+}
+
+static void test_list_transfer(void **state)
+{
+    Clist *list = (Clist *)*state;
+
+    Clist *other = NULL;
+
+    static int values[30];
+
+    int expected[] = {28, 29, 0, 1, 2, 3, 4, 22, 23, 24, 5, 6, 7, 8, 9, 10, 11, 12,
+                      13, 14, 15, 16, 17, 18, 19, 20, 21, 25, 26, 27};
+
+    size_t count = sizeof(values) / sizeof(values[0]);
+
+    size_t index = 0;
+
+    int value = 100;
+
+    clist_enable_hash_index(list, test_int_hash);
+
+    for (index = 0; index < count; index++) {
+        values[index] = (int)index;
+        clist_add_last(list, clist_item_new_static(&values[index], sizeof(int), test_int_compare));
+    }
+
+    other = clist_split(list, 20);
+
+    assert_int_equal(clist_size(list), 20);
+
+    assert_int_equal(clist_size(other), 10);
+
+    assert_false(clist_contains(list, &values[25]));
+
+    assert_int_equal(clist_transfer_range(list, 5, other, 2, 3), 3);
+
+    /* the count is clamped to the end of the source */
+    assert_int_equal(clist_transfer_range(list, 0, other, 5, 10), 2);
+
+    /* past the end of the destination nothing moves */
+    assert_int_equal(clist_transfer_range(list, clist_size(list) + 1, other, 0, 1), 0);
+
+    clist_splice(list, clist_size(list), other);
+
+    assert_int_equal(clist_size(other), 0);
+
+    assert_int_equal(clist_size(list), count);
+
+    for (index = 0; index < count; index++) {
+        assert_int_equal(*(int *)clist_get(list, index), expected[index]);
+    }
+
+    assert_true(clist_contains(list, &values[25]));
+
+    /* fused items move too */
+    clist_add_value(other, &value, sizeof(int), test_int_compare);
+
+    clist_splice(list, 1, other);
+
+    assert_int_equal(*(int *)clist_get(list, 1), value);
+
+    assert_true(clist_contains(list, &value));
+
+    clist_delete(other);
+}
+
+static void test_list_ring_policy(void **state)
+{
+    Clist *list = (Clist *)*state;
+
+    Clist *ring = clist_new_ring(4);
+
+    Clist *bounded = clist_new_ring_with_policy(3, ClistRingReject);
+
+    ClistItem *batch[2];
+
+    ClistItem *item = NULL;
+
+    static int values[8];
+
+    int index = 0;
+
+    for (index = 0; index < 8; index++) {
+        values[index] = index;
+    }
+
+    /* appending to a full ring drops the oldest item, wrapping around the buffer */
+    for (index = 0; index < 6; index++) {
+        clist_add_last(ring, clist_item_new_static(&values[index], sizeof(int), test_int_compare));
+    }
+
+    assert_int_equal(clist_size(ring), 4);
+
+    for (index = 0; index < 4; index++) {
+        assert_int_equal(*(int *)clist_get(ring, index), index + 2);
+    }
+
+    /* prepending drops the last item */
+    clist_add(ring, clist_item_new_static(&values[7], sizeof(int), test_int_compare));
+
+    assert_int_equal(*(int *)clist_get(ring, 0), 7);
+
+    assert_int_equal(*(int *)clist_get(ring, 3), 4);
+
+    clist_delete(ring);
+
+    /* a rejecting ring refuses the added items instead, leaving them with the caller */
+    clist_enable_hash_index(bounded, test_int_hash);
+
+    for (index = 0; index < 5; index++) {
+        item = clist_item_new_static(&values[index], sizeof(int), test_int_compare);
+
+        if (index < 3) {
+            assert_true(clist_ring_offer(bounded, item));
+            continue;
+        }
+
+        assert_false(clist_ring_offer(bounded, item));
+
+        assert_int_equal(*(int *)clist_item_data(item), index);
+
+        clist_item_delete(item);
+    }
+
+    item = clist_item_new_static(&values[4], sizeof(int), test_int_compare);
+
+    clist_add(bounded, item);
+
+    assert_int_equal(*(int *)clist_item_data(item), 4);
+
+    clist_item_delete(item);
+
+    /* data to copy isn't copied when there is no room */
+    clist_add_value(bounded, &values[4], sizeof(int), test_int_compare);
+
+    assert_int_equal(clist_size(bounded), 3);
+
+    assert_int_equal(*(int *)clist_get(bounded, 2), 2);
+
+    assert_false(clist_contains(bounded, &values[3]));
+
+    assert_false(clist_contains(bounded, &values[4]));
+
+    clist_item_delete(clist_pop_first(bounded));
+
+    batch[0] = clist_item_new_static(&values[5], sizeof(int), test_int_compare);
+    batch[1] = clist_item_new_static(&values[6], sizeof(int), test_int_compare);
+
+    /* all of a batch fits or none of it is added */
+    clist_add_batch(bounded, batch, 2);
+
+    assert_int_equal(clist_size(bounded), 2);
+
+    assert_false(clist_contains(bounded, &values[5]));
+
+    clist_item_delete(batch[1]);
+
+    clist_add_batch(bounded, batch, 1);
+
+    assert_int_equal(clist_size(bounded), 3);
+
+    assert_true(clist_contains(bounded, &values[5]));
+
+    clist_delete(bounded);
+
+    assert_true(clist_is_empty(list));
+}
+
+static void test_list_ring_reject_concurrent(void **state)
+{
+    Clist *list = (Clist *)*state;
+
+    Clist *shared = clist_new_concurrent(clist_new_ring_with_policy(4, ClistRingReject));
+
+    Clist *other = clist_new_single();
+
+    Clist *result = NULL;
+
+    ClistIterator iter;
+
+    ClistItem *item = NULL;
+
+    static int values[8];
+
+    int index = 0;
+
+    for (index = 0; index < 8; index++) {
+        values[index] = index;
+    }
+
+    for (index = 0; index < 2; index++) {
+        assert_true(clist_ring_offer(shared, clist_item_new_static(&values[index + 6], sizeof(int), test_int_compare)));
+    }
+
+    for (index = 0; index < 6; index++) {
+        clist_add_last(other, clist_item_new_static(&values[index], sizeof(int), test_int_compare));
+    }
+
+    /* a wrapped rejecting ring takes what fits of a set operation, not nothing */
+    result = clist_union(shared, other);
+
+    assert_int_equal(clist_size(result), 4);
+
+    assert_true(clist_contains(result, &values[6]));
+
+    assert_true(clist_contains(result, &values[7]));
+
+    clist_delete(result);
+
+    assert_int_equal(clist_union_in_place(shared, other), 4);
+
+    assert_true(clist_contains(shared, &values[6]));
+
+    /* a full ring leaves an offered or inserted item with the caller */
+    item = clist_item_new_static(&values[5], sizeof(int), test_int_compare);
+
+    assert_false(clist_ring_offer(shared, item));
+
+    clist_iter_begin(shared, &iter);
+
+    assert_int_equal(clist_iter_insert_after(&iter, item), 0);
+
+    assert_int_equal(*(int *)clist_item_data(clist_iter_next(&iter)), 6);
+
+    clist_item_delete(clist_pop_first(shared));
+
+    clist_iter_begin(shared, &iter);
+
+    assert_int_not_equal(clist_iter_insert_after(&iter, item), 0);
+
+    assert_int_equal(clist_size(shared), 4);
+
+    assert_int_equal(*(int *)clist_get(shared, 0), 5);
+
+    clist_delete(other);
+
+    clist_delete(shared);
+
+    assert_true(clist_is_empty(list));
+}
+
+#define TEST_CONCURRENT_THREADS 4
+#define TEST_CONCURRENT_ITEMS 1000
+
+static int test_concurrent_values[TEST_CONCURRENT_THREADS * TEST_CONCURRENT_ITEMS];
+
+typedef struct {
+    Clist *list;
+    int thread;
+    size_t popped;
+} TestConcurrentArg;
+
+static void *test_concurrent_add(void *arg)
+{
+    TestConcurrentArg *params = (TestConcurrentArg *)arg;
+    int index = 0;
+    int *value = NULL;
+
+    for (index = 0; index < TEST_CONCURRENT_ITEMS; index++) {
+        value = &test_concurrent_values[params->thread * TEST_CONCURRENT_ITEMS + index];
+
+        clist_add_last(params->list, clist_item_new_static(value, sizeof(int), test_int_compare));
+
+        /* readers share the lock with each other, positional reads included */
+        assert_true(clist_contains(params->list, value));
+
+        assert_non_null(clist_get(params->list, 0));
+    }
+
+    return NULL;
+}
+
+static int test_concurrent_pop_locked(Clist *list, void *arg)
+{
+    /* checking the size and popping is atomic with the lock held */
+    if (clist_is_empty(list)) {
+        return 0;
+    }
+
+    clist_item_delete(clist_pop_first(list));
+
+    return 1;
+}
+
+static void *test_concurrent_pop(void *arg)
+{
+    TestConcurrentArg *params = (TestConcurrentArg *)arg;
+
+    while (clist_locked_apply(params->list, test_concurrent_pop_locked, NULL)) {
+        params->popped++;
+    }
+
+    return NULL;
+}
+
+static void test_list_lockfree_stack(void **state)
+{
+    Clist *list = (Clist *)*state;
+
+    static int values[200];
+
+    int index = 0;
+
+    ClistItem *item = NULL;
+
+    assert_true(clist_is_empty(list));
+
+    assert_null(clist_pop_first(list));
+
+    for (index = 0; index < 200; index++) {
+        values[index] = index;
+        clist_add(list, clist_item_new_static(&values[index], sizeof(int), test_int_compare));
+    }
+
+    assert_int_equal(clist_size(list), 200);
+
+    /* last in, first out, reusing the popped nodes across blocks */
+    for (index = 199; index >= 100; index--) {
+        item = clist_pop_first(list);
+        assert_non_null(item);
+        assert_int_equal(*(int *)clist_item_data(item), index);
+        clist_item_delete(item);
+    }
+
+    index = 1000;
+
+    clist_add_value(list, &index, sizeof(int), test_int_compare);
+
+    item = clist_pop_first(list);
+
+    assert_int_equal(*(int *)clist_item_data(item), 1000);
+
+    clist_item_delete(item);
+
+    assert_int_equal(clist_size(list), 100);
+
+    clist_clear(list);
+
+    assert_true(clist_is_empty(list));
+
+    assert_int_equal(clist_size(list), 0);
+}
+
+#define TEST_LOCKFREE_THREADS 8
+#define TEST_LOCKFREE_ITEMS 20000
+
+static int test_lockfree_values[TEST_LOCKFREE_THREADS * TEST_LOCKFREE_ITEMS];
+
+static int test_lockfree_popped[TEST_LOCKFREE_THREADS * TEST_LOCKFREE_ITEMS];
+
+typedef struct {
+    Clist *list;
+    int thread;
+    int *popped;
+    size_t count;
+} TestLockfreeArg;
+
+static void *test_lockfree_push_pop(void *arg)
+{
+    TestLockfreeArg *params = (TestLockfreeArg *)arg;
+    ClistItem *item = NULL;
+    int index = 0;
+
+    /* pushes and pops interleaved, so the nodes are reused while other threads hold them */
+    for (index = 0; index < TEST_LOCKFREE_ITEMS; index++) {
+        clist_add(params->list,
+                  clist_item_new_static(&test_lockfree_values[params->thread * TEST_LOCKFREE_ITEMS + index],
+                                        sizeof(int), test_int_compare));
+
+        if (index % 3 == 0) {
+            continue;
+        }
+
+        item = clist_pop_first(params->list);
+
+        if (item != NULL) {
+            params->popped[params->count++] = *(int *)clist_item_data(item);
+            clist_item_delete(item);
+        }
+    }
+
+    return NULL;
+}
+
+static void test_list_lockfree_stress(void **state)
+{
+    Clist *list = (Clist *)*state;
+
+    pthread_t threads[TEST_LOCKFREE_THREADS];
+
+    TestLockfreeArg params[TEST_LOCKFREE_THREADS];
+
+    static char seen[TEST_LOCKFREE_THREADS * TEST_LOCKFREE_ITEMS];
+
+    size_t total = TEST_LOCKFREE_THREADS * TEST_LOCKFREE_ITEMS;
+
+    size_t index = 0, count = 0;
+
+    ClistItem *item = NULL;
+
+    int *popped = test_lockfree_popped;
+
+    for (index = 0; index < total; index++) {
+        test_lockfree_values[index] = (int)index;
+        seen[index] = 0;
+    }
+
+    for (index = 0; index < TEST_LOCKFREE_THREADS; index++) {
+        params[index].list = list;
+        params[index].thread = (int)index;
+        params[index].popped = popped;
+        params[index].count = 0;
+        popped += TEST_LOCKFREE_ITEMS;
+        assert_int_equal(pthread_create(&threads[index], NULL, test_lockfree_push_pop, &params[index]), 0);
+    }
+
+    for (index = 0; index < TEST_LOCKFREE_THREADS; index++) {
+        pthread_join(threads[index], NULL);
+    }
+
+    /* every item is popped exactly once, by a thread or here */
+    for (index = 0; index < TEST_LOCKFREE_THREADS; index++) {
+        for (count = 0; count < params[index].count; count++) {
+            assert_int_equal(seen[params[index].popped[count]]++, 0);
+        }
+        total -= params[index].count;
+    }
+
+    assert_int_equal(clist_size(list), total);
+
+    while ((item = clist_pop_first(list)) != NULL) {
+        assert_int_equal(seen[*(int *)clist_item_data(item)]++, 0);
+        clist_item_delete(item);
+    }
+
+    for (index = 0; index < TEST_LOCKFREE_THREADS * TEST_LOCKFREE_ITEMS; index++) {
+        assert_int_equal(seen[index], 1);
+    }
+
+    assert_true(clist_is_empty(list));
+}
+
+#define TEST_LOCKFREE_PRODUCERS 4
+#define TEST_LOCKFREE_PRODUCED 1000
+
+static _Atomic size_t test_lockfree_taken;
+
+static void *test_lockfree_push(void *arg)
+{
+    TestLockfreeArg *params = (TestLockfreeArg *)arg;
+    int index = 0;
+
+    for (index = 0; index < TEST_LOCKFREE_PRODUCED; index++) {
+        clist_add(params->list,
+                  clist_item_new_static(&test_lockfree_values[params->thread * TEST_LOCKFREE_PRODUCED + index],
+                                        sizeof(int), test_int_compare));
+    }
+
+    return NULL;
+}
+
+static void *test_lockfree_pop(void *arg)
+{
+    TestLockfreeArg *params = (TestLockfreeArg *)arg;
+    ClistItem *item = NULL;
+
+    /* pops race the pushes, often finding the stack empty */
+    while (atomic_load(&test_lockfree_taken) < TEST_LOCKFREE_PRODUCERS * TEST_LOCKFREE_PRODUCED) {
+        item = clist_pop_first(params->list);
+
+        if (item != NULL) {
+            params->popped[params->count++] = *(int *)clist_item_data(item);
+            clist_item_delete(item);
+            atomic_fetch_add(&test_lockfree_taken, 1);
+        }
+    }
+
+    return NULL;
+}
+
+static void test_list_lockfree_producers(void **state)
+{
+    Clist *list = (Clist *)*state;
+
+    pthread_t threads[TEST_LOCKFREE_PRODUCERS * 2];
+
+    TestLockfreeArg params[TEST_LOCKFREE_PRODUCERS * 2];
+
+    static char seen[TEST_LOCKFREE_PRODUCERS * TEST_LOCKFREE_PRODUCED];
+
+    size_t total = TEST_LOCKFREE_PRODUCERS * TEST_LOCKFREE_PRODUCED;
+
+    size_t index = 0, count = 0;
+
+    for (index = 0; index < total; index++) {
+        test_lockfree_values[index] = (int)index;
+        seen[index] = 0;
+    }
+
+    atomic_store(&test_lockfree_taken, 0);
+
+    /* as many threads popping as pushing, each popping thread with room for every item */
+    for (index = 0; index < TEST_LOCKFREE_PRODUCERS * 2; index++) {
+        params[index].list = list;
+        params[index].thread = (int)(index / 2);
+        params[index].popped = test_lockfree_popped + (index / 2) * total;
+        params[index].count = 0;
+        assert_int_equal(pthread_create(&threads[index], NULL, index % 2 ? test_lockfree_pop : test_lockfree_push,
+                                        &params[index]),
+                         0);
+    }
+
+    for (index = 0; index < TEST_LOCKFREE_PRODUCERS * 2; index++) {
+        pthread_join(threads[index], NULL);
+    }
+
+    /* nothing is lost or popped twice */
+    for (index = 1; index < TEST_LOCKFREE_PRODUCERS * 2; index += 2) {
+        for (count = 0; count < params[index].count; count++) {
+            assert_int_equal(seen[params[index].popped[count]]++, 0);
+        }
+    }
+
+    for (index = 0; index < total; index++) {
+        assert_int_equal(seen[index], 1);
+    }
+
+    assert_true(clist_is_empty(list));
+
+    assert_int_equal(clist_size(list), 0);
+}
+
+static void test_list_concurrent(void **state)
+{
+    Clist *list = (Clist *)*state;
+
+    pthread_t threads[TEST_CONCURRENT_THREADS];
+
+    TestConcurrentArg params[TEST_CONCURRENT_THREADS];
+
+    size_t popped = 0;
+
+    int index = 0;
+
+    for (index = 0; index < TEST_CONCURRENT_THREADS * TEST_CONCURRENT_ITEMS; index++) {
+        test_concurrent_values[index] = index;
+    }
+
+    clist_enable_hash_index(list, test_int_hash);
+
+    for (index = 0; index < TEST_CONCURRENT_THREADS; index++) {
+        params[index].list = list;
+        params[index].thread = index;
+        params[index].popped = 0;
+        assert_int_equal(pthread_create(&threads[index], NULL, test_concurrent_add, &params[index]), 0);
+    }
+
+    for (index = 0; index < TEST_CONCURRENT_THREADS; index++) {
+        pthread_join(threads[index], NULL);
+    }
+
+    assert_int_equal(clist_size(list), TEST_CONCURRENT_THREADS * TEST_CONCURRENT_ITEMS);
+
+    for (index = 0; index < TEST_CONCURRENT_THREADS * TEST_CONCURRENT_ITEMS; index += 97) {
+        assert_true(clist_contains(list, &test_concurrent_values[index]));
+    }
+
+    for (index = 0; index < TEST_CONCURRENT_THREADS; index++) {
+        assert_int_equal(pthread_create(&threads[index], NULL, test_concurrent_pop, &params[index]), 0);
+    }
+
+    for (index = 0; index < TEST_CONCURRENT_THREADS; index++) {
+        pthread_join(threads[index], NULL);
+        popped += params[index].popped;
+    }
+
+    assert_int_equal(popped, TEST_CONCURRENT_THREADS * TEST_CONCURRENT_ITEMS);
+
+    assert_true(clist_is_empty(list));
+
+    assert_false(clist_contains(list, &test_concurrent_values[0]));
+}
+
+static void test_list_iterator(void **state)
+{
+    Clist *list = (Clist *)*state;
+
+    ClistIterator iter;
+
+    ClistItem *item = NULL;
+
+    static int values[40];
+
+    static int extra[] = {-1, -2, -3};
+
+    size_t count = sizeof(values) / sizeof(values[0]);
+
+    size_t index = 0;
+
+    clist_iter_begin(list, &iter);
+
+    assert_null(clist_iter_next(&iter));
+
+    assert_int_equal(clist_iter_remove(&iter), 0);
+
+    for (index = 0; index < count; index++) {
+        values[index] = (int)index;
+        clist_add_last(list, clist_item_new_static(&values[index], sizeof(int), test_int_compare));
+    }
+
+    clist_enable_hash_index(list, test_int_hash);
+
+    /* removing every odd item in one pass */
+    for (clist_iter_begin(list, &iter), index = 0; (item = clist_iter_next(&iter)) != NULL; index++) {
+        assert_int_equal(*(int *)clist_item_data(item), values[index]);
+
+        if (index % 2) {
+            assert_int_not_equal(clist_iter_remove(&iter), 0);
+            assert_int_equal(clist_iter_remove(&iter), 0);
+        }
+    }
+
+    assert_int_equal(index, count);
+
+    assert_int_equal(clist_size(list), count / 2);
+
+    assert_int_equal(clist_contains(list, &values[1]), 0);
+
+    assert_int_equal(clist_index_of(list, &values[2]), 1);
+
+    /* inserting at the front, after an item and in place of a removed item */
+    clist_iter_begin(list, &iter);
+
+    clist_iter_insert_after(&iter, clist_item_new_static(&extra[0], sizeof(int), test_int_compare));
+
+    assert_int_equal(*(int *)clist_item_data(clist_iter_next(&iter)), 0);
+
+    clist_iter_insert_after(&iter, clist_item_new_static(&extra[1], sizeof(int), test_int_compare));
+
+    assert_int_equal(clist_iter_remove(&iter), 0);
+
+    assert_int_equal(*(int *)clist_item_data(clist_iter_next(&iter)), 2);
+
+    assert_int_not_equal(clist_iter_remove(&iter), 0);
+
+    clist_iter_insert_after(&iter, clist_item_new_static(&extra[2], sizeof(int), test_int_compare));
+
+    assert_int_equal(*(int *)clist_item_data(clist_iter_next(&iter)), 4);
+
+    assert_int_equal(clist_size(list), count / 2 + 2);
+
+    assert_int_equal(*(int *)clist_get(list, 0), extra[0]);
+
+    assert_int_equal(*(int *)clist_get(list, 1), 0);
+
+    assert_int_equal(*(int *)clist_get(list, 2), extra[1]);
+
+    assert_int_equal(*(int *)clist_get(list, 3), extra[2]);
+
+    assert_int_equal(*(int *)clist_get(list, 4), 4);
+
+    assert_int_equal(clist_index_of(list, &extra[2]), 3);
+
+    /* removing everything, then adding to the empty list */
+    for (clist_iter_begin(list, &iter); clist_iter_next(&iter) != NULL;) {
+        clist_iter_remove(&iter);
+    }
+
+    assert_int_not_equal(clist_is_empty(list), 0);
+
+    clist_iter_insert_after(&iter, clist_item_new_static(&extra[0], sizeof(int), test_int_compare));
+
+    assert_int_equal(clist_size(list), 1);
+
+    assert_int_not_equal(clist_contains(list, &extra[0]), 0);
+}
+
+static void test_list_add_value(void **state)
+{
+    Clist *list = (Clist *)*state;
+
+    Clist *other = clist_new_single();
+
+    ClistItem *item = NULL;
+
+    int values[] = {3, 1, 2};
+
+    size_t num_values = sizeof(values) / sizeof(values[0]);
+
+    size_t index = 0;
+
+    for (index = 0; index < num_values; index++) {
+        clist_add_value(list, &values[index], sizeof(int), test_int_compare);
+    }
+
+    /* the list holds copies */
+    values[0] = 100;
+
+    assert_int_equal(clist_size(list), num_values);
+
+    assert_int_equal(*(int *)clist_get(list, 2), 3);
+
+    assert_int_not_equal(clist_get(list, 2), &values[0]);
+
+    clist_add_all(other, list);
+
+    clist_sort(list);
+
+    assert_int_equal(*(int *)clist_get(list, 0), 1);
+
+    assert_int_not_equal(clist_remove(list, &values[1]), 0);
+
+    clist_set(list, 0, clist_item_new_static(&values[0], sizeof(int), test_int_compare));
+
+    assert_int_equal(*(int *)clist_get(list, 0), 100);
+
+    item = clist_pop_last(list);
+
+    assert_int_equal(*(int *)clist_item_data(item), 3);
+
+    clist_item_delete(item);
+
+    assert_int_equal(clist_contains_all(other, list), 0);
+
+    assert_int_equal(clist_size(other), num_values);
+
+    clist_delete(other);
+}
+
+static int test_long_double_compare(const void *a, const void *b, size_t size)
+{
+    long double d1 = *(const long double *)a, d2 = *(const long double *)b;
+
+    return (d1 > d2) - (d1 < d2);
+}
+
+static void test_assert_aligned(const void *data)
+{
+    assert_int_equal((uintptr_t)data % _Alignof(max_align_t), 0);
+}
+
+static void test_list_add_value_aligned(void **state)
+{
+    Clist *list = (Clist *)*state;
+
+    Clist *other = clist_new_single();
+
+    long double values[] = {1.5L, 2.5L, 3.5L};
+
+    size_t num_values = sizeof(values) / sizeof(values[0]);
+
+    size_t index = 0;
+
+    for (index = 0; index < num_values; index++) {
+        clist_add_value(list, &values[index], sizeof(long double), test_long_double_compare);
+    }
+
+    /* data stored with its node is aligned for any type, as malloc would give */
+    for (index = 0; index < num_values; index++) {
+        test_assert_aligned(clist_get(list, index));
+    }
+
+    assert_true(clist_contains(list, &values[1]));
+
+    clist_add_all(other, list);
+
+    for (index = 0; index < num_values; index++) {
+        test_assert_aligned(clist_get(other, index));
+        assert_true(*(long double *)clist_get(other, index) == *(long double *)clist_get(list, index));
+    }
+
+    clist_delete(other);
+}
+
+static void test_list_item_type(void **state)
+{
+    Clist *list = (Clist *)*state;
+
+    Clist *other = clist_new_single();
+
+    ClistItemType *type = clist_item_type_new(test_int_compare, malloc, free, memmove);
+
+    ClistItem *item = NULL, *other_item = NULL;
+
+    int values[] = {3, 1, 2};
+
+    size_t num_values = sizeof(values) / sizeof(values[0]);
+
+    size_t index = 0;
+
+    int *data = NULL;
+
+    for (index = 0; index < num_values; index++) {
+        data = malloc(sizeof(int));
+        *data = values[index];
+        clist_add(list, clist_item_new_typed(data, sizeof(int), type));
+    }
+
+    /* items with the same callbacks share a type */
+    item = clist_item_new_static(&values[0], sizeof(int), test_int_compare);
+
+    other_item = clist_item_new_static(&values[1], sizeof(int), test_int_compare);
+
+    assert_ptr_equal(clist_item_type(item), clist_item_type(other_item));
+
+    assert_ptr_not_equal(clist_item_type(item), type);
+
+    clist_item_delete(item);
+
+    clist_item_delete(other_item);
+
+    clist_add_all(other, list);
+
+    clist_sort(list);
+
+    assert_int_equal(*(int *)clist_get(list, 0), 1);
+
+    assert_int_equal(clist_contains_all(other, list), num_values);
+
+    clist_clear(list);
+
+    assert_int_not_equal(clist_contains(other, &values[2]), 0);
+
+    clist_delete(other);
+
+    clist_item_type_delete(type);
+}
+
+typedef struct {
+    _Alignas(16) long double value;
+} TestWide;
+
+static void test_list_inline_copies(void **state)
+{
+    Clist *list = (Clist *)*state;
+
+    Clist *other = clist_new_single();
+
+    ClistItem *item = NULL, *orig = NULL;
+
+    TestWide *wide = NULL;
+
+    size_t threshold = clist_item_inline_threshold();
+
+    size_t index = 0;
+
+    int *data = NULL;
+
+    int value = 100;
+
+    for (index = 0; index < 3; index++) {
+        data = malloc(sizeof(int));
+        *data = (int) index;
+        clist_add(other, clist_item_new(data, sizeof(int), test_int_compare));
+    }
+
+    clist_add_all(list, other);
+
+    /* larger than the threshold, copied with the allocator */
+    clist_item_set_inline_threshold(0);
+
+    clist_add_all(list, other);
+
+    clist_item_set_inline_threshold(threshold);
+
+    assert_int_equal(clist_size(list), 6);
+
+    /* the copies don't share data with the originals */
+    *(int *)clist_get(other, 0) = value;
+
+    assert_int_equal(clist_contains(list, &value), 0);
+
+    item = clist_pop_first(list);
+
+    assert_int_not_equal(clist_item_data(item), clist_get(other, 0));
+
+    assert_int_equal(clist_item_size(item), sizeof(int));
+
+    clist_item_delete(item);
+
+    /* an inline copy is aligned like an allocated one, even for over-aligned data */
+    wide = malloc(sizeof(TestWide));
+    wide->value = 1.5L;
+
+    orig = clist_item_new(wide, sizeof(TestWide), test_long_double_compare);
+
+    item = clist_item_copy(orig);
+
+    assert_ptr_not_equal(clist_item_data(item), wide);
+
+    test_assert_aligned(clist_item_data(item));
+
+    assert_true(((TestWide *)clist_item_data(item))->value == 1.5L);
+
+    clist_item_delete(item);
+
+    clist_item_delete(orig);
+
+    clist_delete(other);
+}
+
+static void test_list_pool_stats(void **state)
+{
+    Clist *list = (Clist *)*state;
+
+    Clist *other = clist_new_single();
+
+    ClistPoolStats stats;
+
+    int index = 0;
+
+    assert_int_equal(clist_pool_stats(other, &stats), 0);
+
+    for (index = 0; index < 10; index++) {
+        clist_add(list, random_list_item());
+    }
+
+    clist_add_value(list, &index, sizeof(int), test_int_compare);
+
+    assert_int_not_equal(clist_pool_stats(list, &stats), 0);
+
+    assert_int_equal(stats.allocations, 10);
+
+    assert_int_equal(stats.recycled, 0);
+
+    assert_int_equal(stats.in_use, 10);
+
+    assert_int_equal(stats.blocks, 3);
+
+    assert_int_equal(stats.block_size, 4);
+
+    assert_int_not_equal(clist_remove_index(list, 3), 0);
+
+    assert_int_not_equal(clist_remove_index(list, 0), 0);
+
+    clist_add(list, random_list_item());
+
+    clist_pool_stats(list, &stats);
+
+    assert_int_equal(stats.allocations, 11);
+
+    assert_int_equal(stats.recycled, 1);
+
+    assert_int_equal(stats.in_use, 10);
+
+    clist_clear(list);
+
+    clist_pool_stats(list, &stats);
+
+    assert_int_equal(stats.blocks, 0);
+
+    assert_int_equal(stats.in_use, 0);
+
+    clist_delete(other);
+}
+
+static void test_list_arena_copies(void **state)
+{
+    Clist *list = (Clist *)*state;
+
+    Clist *other = clist_new_double();
+
+    ClistItem *item = NULL;
+
+    int values[] = {4, 8, 15, 16, 23, 42};
+
+    size_t num_values = sizeof(values) / sizeof(values[0]);
+
+    size_t index = 0;
+
+    for (index = 0; index < num_values; index++) {
+        clist_add_last(other, clist_item_new_static(&values[index], sizeof(int), test_int_compare));
+    }
+
+    clist_add(other, random_list_item());
+
+    clist_add_value(other, &values[0], sizeof(int), test_int_compare);
+
+    /* copies are made in the arena */
+    clist_add_all(list, other);
+
+    clist_add_all(list, other);
+
+    assert_int_equal(clist_size(list), 2 * clist_size(other));
+
+    assert_int_equal(clist_contains_all(list, other), clist_size(other));
+
+    /* static items share their data */
+    assert_ptr_equal(clist_get(list, clist_index_of(list, &values[1])), &values[1]);
+
+    item = clist_pop_first(list);
+
+    assert_int_not_equal(clist_contains(other, clist_item_data(item)), 0);
+
+    clist_item_delete(item);
+
+    clist_set(list, 0, random_list_item());
+
+    assert_int_not_equal(clist_remove(list, &values[5]), 0);
+
+    clist_clear(list);
+
+    assert_int_not_equal(clist_is_empty(list), 0);
+
+    clist_add_all(list, other);
+
+    assert_int_equal(clist_size(list), clist_size(other));
+
+    clist_delete(other);
+}
+
+static void test_list_partition(void **state)
+{
+    Clist *list = (Clist *)*state;
+
+    int partition = 5;
+
+    int values[] = {3, 5, 8, 5, 10, 2, 1};
+
+    int expected[] = {3, 1, 2, 10, 5, 5, 8};
+
+    size_t num_values = sizeof(values) / sizeof(values[0]);
+
+    for (int i = 0; i < num_values; i++) {
+        clist_add(list, clist_item_new_static(&values[i], sizeof(int), test_int_compare));
+    }
+
+    assert_int_equal(clist_size(list), num_values);
+
+    ClistItem *head;
+}
+
+int run_list_tests()
+{
+    const struct CMUnitTest valid_tests[] = {
+        cmocka_unit_test_setup_teardown(test_list_add_valid, create_test_list, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_add_index_valid, create_and_populate_test_list, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_add_all_valid, create_and_populate_test_list, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_add_all_index_valid, create_and_populate_test_list,
+                                        destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_clear_valid, create_and_populate_test_list, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_contains_valid, create_and_populate_test_list, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_contains_all_valid, create_and_populate_test_list, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_get_valid, create_and_populate_test_list, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_remove_valid, create_and_populate_test_list, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_remove_index_valid, create_and_populate_test_list, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_remove_all_valid, create_and_populate_test_list, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_index_of_valid, create_and_populate_test_list, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_set_valid, create_and_populate_test_list, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_size_valid, create_and_populate_test_list, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_is_empty_valid, create_and_populate_test_list, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_merge_sort_valid, create_test_list, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_sort_stable, create_test_list, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_parallel, create_test_list, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_parallel_indexed, create_test_list, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_sort_parallel, create_test_list, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_sort_with_context, create_test_list, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_hash_index, create_test_list, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_hash_index_duplicates, create_test_list, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_join_strategies, create_test_list, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_join_sort_with_hash, create_test_list, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_set_operations, create_test_list, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_queue, create_test_list, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_sequential_access, create_test_list, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_iterator, create_test_list, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_for_each, create_test_list, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_add_batch, create_test_list, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_add_all_order, create_test_list, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_transfer, create_test_list, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_add_value, create_test_list, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_add_value_aligned, create_test_list, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_item_type, create_test_list, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_inline_copies, create_test_list, destroy_test_list)};
+
+    const struct CMUnitTest invalid_tests[] = {
+        cmocka_unit_test_setup_teardown(test_list_add_invalid, create_test_list, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_add_index_invalid, create_and_populate_test_list, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_add_all_invalid, create_and_populate_test_list, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_add_all_index_invalid, create_and_populate_test_list,
+                                        destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_clear_invalid, create_and_populate_test_list, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_contains_invalid, create_and_populate_test_list, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_contains_all_invalid, create_and_populate_test_list,
+                                        destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_get_invalid, create_and_populate_test_list, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_remove_invalid, create_and_populate_test_list, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_remove_index_invalid, create_and_populate_test_list,
+                                        destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_remove_all_invalid, create_and_populate_test_list, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_index_of_invalid, create_and_populate_test_list, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_set_invalid, create_and_populate_test_list, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_size_invalid, create_and_populate_test_list, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_is_empty_invalid, create_and_populate_test_list, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_sort_invalid, create_test_list, destroy_test_list)};
+
+    const struct CMUnitTest array_tests[] = {
+        cmocka_unit_test_setup_teardown(test_list_add_valid, create_test_array, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_add_index_valid, create_and_populate_test_array, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_add_all_valid, create_and_populate_test_array, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_add_all_index_valid, create_and_populate_test_array,
+                                        destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_clear_valid, create_and_populate_test_array, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_contains_valid, create_and_populate_test_array, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_contains_all_valid, create_and_populate_test_array,
+                                        destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_get_valid, create_and_populate_test_array, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_remove_valid, create_and_populate_test_array, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_remove_index_valid, create_and_populate_test_array,
+                                        destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_remove_all_valid, create_and_populate_test_array, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_index_of_valid, create_and_populate_test_array, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_set_valid, create_and_populate_test_array, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_size_valid, create_and_populate_test_array, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_is_empty_valid, create_and_populate_test_array, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_merge_sort_valid, create_test_array, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_sort_stable, create_test_array, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_parallel, create_test_array, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_parallel_indexed, create_test_array, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_sort_parallel, create_test_array, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_sort_with_context, create_test_array, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_hash_index, create_test_array, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_hash_index_duplicates, create_test_array, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_join_strategies, create_test_array, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_join_sort_with_hash, create_test_array, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_set_operations, create_test_array, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_array_order, create_test_array, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_queue, create_test_array, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_sequential_access, create_test_array, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_iterator, create_test_array, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_for_each, create_test_array, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_add_batch, create_test_array, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_add_all_order, create_test_array, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_transfer, create_test_array, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_add_value, create_test_array, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_add_value_aligned, create_test_array, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_inline_copies, create_test_array, destroy_test_list)};
+
+    const struct CMUnitTest unrolled_tests[] = {
+        cmocka_unit_test_setup_teardown(test_list_add_valid, create_test_unrolled, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_add_index_valid, create_and_populate_test_unrolled,
+                                        destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_add_all_valid, create_and_populate_test_unrolled, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_add_all_index_valid, create_and_populate_test_unrolled,
+                                        destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_clear_valid, create_and_populate_test_unrolled, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_contains_valid, create_and_populate_test_unrolled,
+                                        destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_contains_all_valid, create_and_populate_test_unrolled,
+                                        destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_get_valid, create_and_populate_test_unrolled, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_remove_valid, create_and_populate_test_unrolled, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_remove_index_valid, create_and_populate_test_unrolled,
+                                        destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_remove_all_valid, create_and_populate_test_unrolled,
+                                        destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_index_of_valid, create_and_populate_test_unrolled,
+                                        destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_set_valid, create_and_populate_test_unrolled, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_size_valid, create_and_populate_test_unrolled, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_is_empty_valid, create_and_populate_test_unrolled,
+                                        destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_merge_sort_valid, create_test_unrolled, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_sort_stable, create_test_unrolled, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_parallel, create_test_unrolled, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_sort_parallel, create_test_unrolled, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_sort_with_context, create_test_unrolled, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_hash_index, create_test_unrolled, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_join_strategies, create_test_unrolled, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_set_operations, create_test_unrolled, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_array_order, create_test_unrolled, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_unrolled_balance, create_test_unrolled, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_queue, create_test_unrolled, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_sequential_access, create_test_unrolled, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_iterator, create_test_unrolled, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_for_each, create_test_unrolled, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_add_batch, create_test_unrolled, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_add_all_order, create_test_unrolled, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_transfer, create_test_unrolled, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_add_value, create_test_unrolled, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_add_value_aligned, create_test_unrolled, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_inline_copies, create_test_unrolled, destroy_test_list)};
+
+    const struct CMUnitTest ordered_tests[] = {
+        cmocka_unit_test_setup_teardown(test_list_add_valid, create_test_ordered, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_add_value_aligned, create_test_ordered, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_add_all_valid, create_and_populate_test_ordered, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_add_all_index_valid, create_and_populate_test_ordered,
+                                        destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_clear_valid, create_and_populate_test_ordered, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_contains_valid, create_and_populate_test_ordered,
+                                        destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_contains_all_valid, create_and_populate_test_ordered,
+                                        destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_get_valid, create_and_populate_test_ordered, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_remove_valid, create_and_populate_test_ordered, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_remove_index_valid, create_and_populate_test_ordered,
+                                        destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_remove_all_valid, create_and_populate_test_ordered,
+                                        destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_index_of_valid, create_and_populate_test_ordered,
+                                        destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_size_valid, create_and_populate_test_ordered, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_is_empty_valid, create_and_populate_test_ordered,
+                                        destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_merge_sort_valid, create_test_ordered, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_sort_stable, create_test_ordered, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_parallel, create_test_ordered, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_sort_parallel, create_test_ordered, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_set_operations, create_test_ordered, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_ordered, create_test_ordered, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_queue, create_test_ordered, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_inline_copies, create_test_ordered, destroy_test_list)};
+
+    const struct CMUnitTest double_tests[] = {
+        cmocka_unit_test_setup_teardown(test_list_add_valid, create_test_double, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_add_index_valid, create_and_populate_test_double, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_add_all_valid, create_and_populate_test_double, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_add_all_index_valid, create_and_populate_test_double,
+                                        destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_clear_valid, create_and_populate_test_double, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_contains_valid, create_and_populate_test_double, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_contains_all_valid, create_and_populate_test_double,
+                                        destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_get_valid, create_and_populate_test_double, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_remove_valid, create_and_populate_test_double, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_remove_index_valid, create_and_populate_test_double,
+                                        destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_remove_all_valid, create_and_populate_test_double,
+                                        destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_index_of_valid, create_and_populate_test_double, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_set_valid, create_and_populate_test_double, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_size_valid, create_and_populate_test_double, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_is_empty_valid, create_and_populate_test_double, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_merge_sort_valid, create_test_double, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_sort_stable, create_test_double, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_parallel, create_test_double, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_sort_parallel, create_test_double, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_sort_with_context, create_test_double, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_hash_index, create_test_double, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_join_strategies, create_test_double, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_set_operations, create_test_double, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_queue, create_test_double, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_sequential_access, create_test_double, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_iterator, create_test_double, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_for_each, create_test_double, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_add_batch, create_test_double, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_add_all_order, create_test_double, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_transfer, create_test_double, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_add_value, create_test_double, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_add_value_aligned, create_test_double, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_inline_copies, create_test_double, destroy_test_list)};
+
+    const struct CMUnitTest rope_tests[] = {
+        cmocka_unit_test_setup_teardown(test_list_add_valid, create_test_rope, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_add_index_valid, create_and_populate_test_rope, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_add_all_valid, create_and_populate_test_rope, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_add_all_index_valid, create_and_populate_test_rope,
+                                        destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_clear_valid, create_and_populate_test_rope, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_contains_valid, create_and_populate_test_rope, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_contains_all_valid, create_and_populate_test_rope,
+                                        destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_get_valid, create_and_populate_test_rope, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_remove_valid, create_and_populate_test_rope, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_remove_index_valid, create_and_populate_test_rope,
+                                        destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_remove_all_valid, create_and_populate_test_rope,
+                                        destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_index_of_valid, create_and_populate_test_rope, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_set_valid, create_and_populate_test_rope, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_size_valid, create_and_populate_test_rope, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_is_empty_valid, create_and_populate_test_rope, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_merge_sort_valid, create_test_rope, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_sort_stable, create_test_rope, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_parallel, create_test_rope, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_sort_parallel, create_test_rope, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_sort_with_context, create_test_rope, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_hash_index, create_test_rope, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_join_strategies, create_test_rope, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_set_operations, create_test_rope, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_queue, create_test_rope, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_sequential_access, create_test_rope, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_iterator, create_test_rope, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_for_each, create_test_rope, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_add_batch, create_test_rope, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_add_all_order, create_test_rope, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_transfer, create_test_rope, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_add_value, create_test_rope, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_add_value_aligned, create_test_rope, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_inline_copies, create_test_rope, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_rope_split_concat, create_test_rope, destroy_test_list)};
+
+    const struct CMUnitTest ring_tests[] = {
+        cmocka_unit_test_setup_teardown(test_list_add_valid, create_test_ring, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_add_index_valid, create_and_populate_test_ring, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_add_all_valid, create_and_populate_test_ring, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_add_all_index_valid, create_and_populate_test_ring,
+                                        destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_clear_valid, create_and_populate_test_ring, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_contains_valid, create_and_populate_test_ring, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_contains_all_valid, create_and_populate_test_ring,
+                                        destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_get_valid, create_and_populate_test_ring, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_remove_valid, create_and_populate_test_ring, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_remove_index_valid, create_and_populate_test_ring,
+                                        destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_remove_all_valid, create_and_populate_test_ring,
+                                        destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_index_of_valid, create_and_populate_test_ring, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_set_valid, create_and_populate_test_ring, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_size_valid, create_and_populate_test_ring, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_is_empty_valid, create_and_populate_test_ring, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_merge_sort_valid, create_test_ring, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_sort_stable, create_test_ring, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_parallel, create_test_ring, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_sort_with_context, create_test_ring, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_hash_index, create_test_ring, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_join_strategies, create_test_ring, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_set_operations, create_test_ring, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_queue, create_test_ring, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_sequential_access, create_test_ring, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_iterator, create_test_ring, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_for_each, create_test_ring, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_add_batch, create_test_ring, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_add_all_order, create_test_ring, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_transfer, create_test_ring, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_add_value, create_test_ring, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_add_value_aligned, create_test_ring, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_inline_copies, create_test_ring, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_ring_policy, create_test_ring, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_ring_reject_concurrent, create_test_ring, destroy_test_list)};
+
+    const struct CMUnitTest concurrent_tests[] = {
+        cmocka_unit_test_setup_teardown(test_list_add_valid, create_test_concurrent, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_add_index_valid, create_and_populate_test_concurrent, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_add_all_valid, create_and_populate_test_concurrent, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_add_all_index_valid, create_and_populate_test_concurrent,
+                                        destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_clear_valid, create_and_populate_test_concurrent, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_contains_valid, create_and_populate_test_concurrent, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_contains_all_valid, create_and_populate_test_concurrent,
+                                        destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_get_valid, create_and_populate_test_concurrent, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_remove_valid, create_and_populate_test_concurrent, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_remove_index_valid, create_and_populate_test_concurrent,
+                                        destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_remove_all_valid, create_and_populate_test_concurrent,
+                                        destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_index_of_valid, create_and_populate_test_concurrent, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_set_valid, create_and_populate_test_concurrent, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_size_valid, create_and_populate_test_concurrent, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_is_empty_valid, create_and_populate_test_concurrent, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_merge_sort_valid, create_test_concurrent, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_sort_stable, create_test_concurrent, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_parallel, create_test_concurrent, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_parallel_indexed, create_test_concurrent, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_sort_parallel, create_test_concurrent, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_sort_with_context, create_test_concurrent, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_hash_index, create_test_concurrent, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_join_strategies, create_test_concurrent, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_set_operations, create_test_concurrent, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_queue, create_test_concurrent, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_sequential_access, create_test_concurrent, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_iterator, create_test_concurrent, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_for_each, create_test_concurrent, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_add_batch, create_test_concurrent, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_add_all_order, create_test_concurrent, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_transfer, create_test_concurrent, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_add_value, create_test_concurrent, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_add_value_aligned, create_test_concurrent, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_inline_copies, create_test_concurrent, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_concurrent, create_test_concurrent, destroy_test_list)};
+
+    const struct CMUnitTest lockfree_tests[] = {
+        cmocka_unit_test_setup_teardown(test_list_lockfree_stack, create_test_lockfree, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_lockfree_stress, create_test_lockfree, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_lockfree_producers, create_test_lockfree, destroy_test_list)};
+
+    const struct CMUnitTest pooled_tests[] = {
+        cmocka_unit_test_setup_teardown(test_list_add_valid, create_test_pooled, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_add_index_valid, create_and_populate_test_pooled, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_add_all_valid, create_and_populate_test_pooled, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_add_all_index_valid, create_and_populate_test_pooled,
+                                        destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_clear_valid, create_and_populate_test_pooled, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_remove_valid, create_and_populate_test_pooled, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_remove_all_valid, create_and_populate_test_pooled,
+                                        destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_set_valid, create_and_populate_test_pooled, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_merge_sort_valid, create_test_pooled, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_sort_stable, create_test_pooled, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_parallel, create_test_pooled, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_sort_parallel, create_test_pooled, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_sort_with_context, create_test_pooled, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_hash_index, create_test_pooled, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_join_strategies, create_test_pooled, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_set_operations, create_test_pooled, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_queue, create_test_pooled, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_sequential_access, create_test_pooled, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_iterator, create_test_pooled, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_for_each, create_test_pooled, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_add_batch, create_test_pooled, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_add_all_order, create_test_pooled, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_transfer, create_test_pooled, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_add_value, create_test_pooled, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_add_value_aligned, create_test_pooled, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_pool_stats, create_test_pooled, destroy_test_list)};
+
+    const struct CMUnitTest arena_tests[] = {
+        cmocka_unit_test_setup_teardown(test_list_add_valid, create_test_arena, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_add_index_valid, create_and_populate_test_arena, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_add_all_valid, create_and_populate_test_arena, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_add_all_index_valid, create_and_populate_test_arena,
+                                        destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_clear_valid, create_and_populate_test_arena, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_remove_valid, create_and_populate_test_arena, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_remove_all_valid, create_and_populate_test_arena,
+                                        destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_set_valid, create_and_populate_test_arena, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_merge_sort_valid, create_test_arena, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_sort_stable, create_test_arena, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_parallel, create_test_arena, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_sort_parallel, create_test_arena, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_sort_with_context, create_test_arena, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_hash_index, create_test_arena, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_join_strategies, create_test_arena, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_set_operations, create_test_arena, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_queue, create_test_arena, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_sequential_access, create_test_arena, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_iterator, create_test_arena, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_for_each, create_test_arena, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_add_batch, create_test_arena, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_add_all_order, create_test_arena, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_transfer, create_test_arena, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_add_value, create_test_arena, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_add_value_aligned, create_test_arena, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_arena_copies, create_test_arena, destroy_test_list),
+        cmocka_unit_test_setup_teardown(test_list_inline_copies, create_test_arena, destroy_test_list)};
+
+    int rval = cmocka_run_group_tests_name("list valid tests", valid_tests, NULL, NULL);
+
+    if (rval) {
+        return rval;
+    }
+
+    rval = cmocka_run_group_tests_name("array list tests", array_tests, NULL, NULL);
+
+    if (rval) {
+        return rval;
+    }
+
+    rval = cmocka_run_group_tests_name("unrolled list tests", unrolled_tests, NULL, NULL);
+
+    if (rval) {
+        return rval;
+    }
+
+    rval = cmocka_run_group_tests_name("ordered list tests", ordered_tests, NULL, NULL);
+
+    if (rval) {
+        return rval;
+    }
+
+    rval = cmocka_run_group_tests_name("double list tests", double_tests, NULL, NULL);
+
+    if (rval) {
+        return rval;
+    }
+
+    rval = cmocka_run_group_tests_name("rope list tests", rope_tests, NULL, NULL);
+
+    if (rval) {
+        return rval;
+    }
+
+    rval = cmocka_run_group_tests_name("ring list tests", ring_tests, NULL, NULL);
+
+    if (rval) {
+        return rval;
+    }
+
+    rval = cmocka_run_group_tests_name("concurrent list tests", concurrent_tests, NULL, NULL);
+
+    if (rval) {
+        return rval;
+    }
+
+    rval = cmocka_run_group_tests_name("lockfree stack tests", lockfree_tests, NULL, NULL);
+
+    if (rval) {
+        return rval;
+    }
+
+    rval = cmocka_run_group_tests_name("pooled list tests", pooled_tests, NULL, NULL);
+
+    if (rval) {
+        return rval;
+    }
+
+    rval = cmocka_run_group_tests_name("arena list tests", arena_tests, NULL, NULL);
 
     if (rval) {
         return rval;
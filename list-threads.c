@@ -0,0 +1,183 @@
+#include <pthread.h>
+#include <stdlib.h>
+
+#include "internal.h"
+
+typedef struct __clist_threads_job ClistThreadsJob;
+
+/*
+ * worker threads shared by all parallel operations, started as they are first needed and
+ * kept until exit.  a job is a number of tasks, claimed one at a time by the workers and by
+ * the thread that runs the job, so a job finishes even when every worker is busy, including
+ * a job started from a task of another job.
+ */
+#define CLIST_THREADS_MAX 64
+
+struct __clist_threads_job {
+    char *tasks;
+    size_t task_size;
+    size_t count;
+    ClistTaskCallback callback;
+    /* the next task to claim */
+    size_t claimed;
+    size_t done;
+    pthread_cond_t finished;
+    /* the next job with tasks to claim */
+    ClistThreadsJob *next;
+};
+
+static pthread_mutex_t __clist_threads_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static pthread_cond_t __clist_threads_work = PTHREAD_COND_INITIALIZER;
+
+/* the jobs with tasks to claim, newest first */
+static ClistThreadsJob *__clist_threads_jobs = NULL;
+
+static pthread_t __clist_threads_workers[CLIST_THREADS_MAX];
+
+static size_t __clist_threads_size = 0;
+
+static int __clist_threads_stopping = 0;
+
+/*
+ * claims the next task of a job, with the lock held, removing the job once all are claimed
+ * @return the task
+ */
+static void *__clist_threads_claim(ClistThreadsJob *job) {
+    ClistThreadsJob **link = NULL;
+    size_t index = job->claimed++;
+
+    if (job->claimed == job->count) {
+        for (link = &__clist_threads_jobs; *link != job; link = &(*link)->next) {
+        }
+
+        *link = job->next;
+    }
+
+    return job->tasks + index * job->task_size;
+}
+
+/*
+ * runs a claimed task without the lock, then counts it done
+ */
+static void __clist_threads_do(ClistThreadsJob *job, void *task) {
+    pthread_mutex_unlock(&__clist_threads_lock);
+
+    (*job->callback)(task);
+
+    pthread_mutex_lock(&__clist_threads_lock);
+
+    if (++job->done == job->count) {
+        pthread_cond_signal(&job->finished);
+    }
+}
+
+static void *__clist_threads_worker(void *arg) {
+    ClistThreadsJob *job = NULL;
+
+    (void) arg;
+
+    pthread_mutex_lock(&__clist_threads_lock);
+
+    for (;;) {
+        while (__clist_threads_jobs == NULL && !__clist_threads_stopping) {
+            pthread_cond_wait(&__clist_threads_work, &__clist_threads_lock);
+        }
+
+        if (__clist_threads_jobs == NULL) {
+            break;
+        }
+
+        job = __clist_threads_jobs;
+
+        __clist_threads_do(job, __clist_threads_claim(job));
+    }
+
+    pthread_mutex_unlock(&__clist_threads_lock);
+
+    return NULL;
+}
+
+static void __clist_threads_stop() {
+    size_t i = 0;
+
+    pthread_mutex_lock(&__clist_threads_lock);
+
+    __clist_threads_stopping = 1;
+
+    pthread_cond_broadcast(&__clist_threads_work);
+
+    pthread_mutex_unlock(&__clist_threads_lock);
+
+    for (i = 0; i < __clist_threads_size; i++) {
+        pthread_join(__clist_threads_workers[i], NULL);
+    }
+}
+
+/*
+ * starts workers, with the lock held, until there are a number of them or no more can start
+ */
+static void __clist_threads_grow(size_t size) {
+    if (__clist_threads_stopping) {
+        return;
+    }
+
+    if (__clist_threads_size == 0) {
+        atexit(__clist_threads_stop);
+    }
+
+    if (size > CLIST_THREADS_MAX) {
+        size = CLIST_THREADS_MAX;
+    }
+
+    while (__clist_threads_size < size) {
+        if (pthread_create(&__clist_threads_workers[__clist_threads_size], NULL, __clist_threads_worker, NULL) != 0) {
+            break;
+        }
+
+        __clist_threads_size++;
+    }
+}
+
+void __clist_threads_run(void *tasks, size_t task_size, size_t count, ClistTaskCallback callback) {
+    ClistThreadsJob job;
+
+    if (count == 0) {
+        return;
+    }
+
+    if (count == 1) {
+        (*callback)(tasks);
+        return;
+    }
+
+    job.tasks = (char *) tasks;
+    job.task_size = task_size;
+    job.count = count;
+    job.callback = callback;
+    job.claimed = 0;
+    job.done = 0;
+
+    pthread_cond_init(&job.finished, NULL);
+
+    pthread_mutex_lock(&__clist_threads_lock);
+
+    __clist_threads_grow(count - 1);
+
+    job.next = __clist_threads_jobs;
+    __clist_threads_jobs = &job;
+
+    pthread_cond_broadcast(&__clist_threads_work);
+
+    while (job.claimed < job.count) {
+        __clist_threads_do(&job, __clist_threads_claim(&job));
+    }
+
+    while (job.done < job.count) {
+        pthread_cond_wait(&job.finished, &__clist_threads_lock);
+    }
+
+    pthread_mutex_unlock(&__clist_threads_lock);
+
+    pthread_cond_destroy(&job.finished);
+}
@@ -0,0 +1,1037 @@
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <clist/list-item.h>
+#include "list-vtable.h"
+#include "internal.h"
+
+#define CLIST_UNROLLED_DEFAULT_CAPACITY 16
+
+#define CLIST_UNROLLED_MIN_CAPACITY 4
+
+typedef struct __clist_unrolled_node ClistUnrolledNode;
+
+typedef struct __clist_unrolled ClistUnrolled;
+
+struct __clist_unrolled_node {
+    ClistUnrolledNode *next;
+    ClistUnrolledNode *prev;
+    size_t count;
+    ClistItem *items[];
+};
+
+/*
+ * a linked list of nodes each holding up to capacity items in order.
+ * nodes other than the only one are kept at least half full by splitting
+ * full nodes on insert and merging or borrowing from a neighbour on remove.
+ */
+struct __clist_unrolled {
+    ClistUnrolledNode *first;
+    ClistUnrolledNode *last;
+    size_t size;
+    size_t capacity;
+    /* the last node located by index and the index of its first item */
+    ClistUnrolledNode *cursor;
+    size_t cursor_base;
+};
+
+extern void clist_unrolled_clear(Clist *list);
+
+/*
+ * invalidates the cursor after items move between or out of nodes
+ */
+static inline void __clist_unrolled_forget(ClistUnrolled *list) {
+    list->cursor = NULL;
+    list->cursor_base = 0;
+}
+
+static inline ClistUnrolled *__clist_unrolled_impl(const Clist *arg) {
+    assert(arg->impl != NULL);
+    return (ClistUnrolled *) arg->impl;
+}
+
+static ClistUnrolledNode *__clist_unrolled_node_new(const ClistUnrolled *list) {
+    ClistUnrolledNode *node = malloc(sizeof(ClistUnrolledNode) + list->capacity * sizeof(ClistItem *));
+    assert(node != NULL);
+    node->next = NULL;
+    node->prev = NULL;
+    node->count = 0;
+    return node;
+}
+
+/*
+ * links a node after another, or at the front when after is NULL
+ */
+static void __clist_unrolled_node_link(ClistUnrolled *list, ClistUnrolledNode *after, ClistUnrolledNode *node) {
+    node->prev = after;
+    node->next = after ? after->next : list->first;
+
+    if (node->next) {
+        node->next->prev = node;
+    } else {
+        list->last = node;
+    }
+
+    if (after) {
+        after->next = node;
+    } else {
+        list->first = node;
+    }
+}
+
+/*
+ * unlinks and frees a node, its items must have been moved or deleted
+ */
+static void __clist_unrolled_node_unlink(ClistUnrolled *list, ClistUnrolledNode *node) {
+    if (node->prev) {
+        node->prev->next = node->next;
+    } else {
+        list->first = node->next;
+    }
+
+    if (node->next) {
+        node->next->prev = node->prev;
+    } else {
+        list->last = node->prev;
+    }
+
+    free(node);
+}
+
+/*
+ * finds the node holding an index, walking forward from the cursor when it is nearer than either end
+ * @param offset set to the position of the index in the node
+ */
+static ClistUnrolledNode *__clist_unrolled_locate(const ClistUnrolled *list, size_t index, size_t *offset) {
+    /* the cursor is a cache, updating it does not change the list */
+    ClistUnrolled *impl = (ClistUnrolled *) list;
+    ClistUnrolledNode *node = NULL;
+    size_t pos = 0;
+
+    assert(index < list->size);
+
+    if (list->cursor != NULL && index >= list->cursor_base && index - list->cursor_base < list->size - index) {
+        for (node = list->cursor, pos = list->cursor_base; index >= pos + node->count; node = node->next) {
+            pos += node->count;
+        }
+    } else if (index < list->size / 2) {
+        for (node = list->first; index >= pos + node->count; node = node->next) {
+            pos += node->count;
+        }
+    } else {
+        pos = list->size;
+
+        for (node = list->last; index < pos - node->count; node = node->prev) {
+            pos -= node->count;
+        }
+
+        pos -= node->count;
+    }
+
+    impl->cursor = node;
+    impl->cursor_base = pos;
+
+    *offset = index - pos;
+    return node;
+}
+
+/*
+ * finds the first item matching some data
+ * @return the index of the item or -1 if not found
+ */
+static int __clist_unrolled_find(const ClistUnrolled *list, const void *data, ClistUnrolledNode **found,
+                                 size_t *offset) {
+    ClistUnrolledNode *node = NULL;
+    size_t pos = 0;
+    int index = 0;
+
+    for (node = list->first; node; node = node->next) {
+        for (pos = 0; pos < node->count; pos++, index++) {
+            if (clist_item_compare(node->items[pos], data) == 0) {
+                if (found) {
+                    *found = node;
+                    *offset = pos;
+                }
+                return index;
+            }
+        }
+    }
+    return -1;
+}
+
+/*
+ * inserts an item before an offset in a node, splitting the node if it is full.
+ * the node can be NULL for an empty list.
+ * @param where the node, set to the node holding the item
+ * @param offset the offset, set to the position of the item
+ */
+static void __clist_unrolled_insert(ClistUnrolled *list, ClistUnrolledNode **where, size_t *offset,
+                                    ClistItem *item) {
+    ClistUnrolledNode *node = *where, *other = NULL;
+    size_t pos = *offset, half = 0;
+
+    __clist_unrolled_forget(list);
+
+    if (node == NULL) {
+        node = __clist_unrolled_node_new(list);
+        __clist_unrolled_node_link(list, list->last, node);
+        pos = 0;
+    } else if (node->count == list->capacity) {
+        if (pos == node->count && node->next && node->next->count < list->capacity) {
+            node = node->next;
+            pos = 0;
+        } else if (pos == 0 && node->prev && node->prev->count < list->capacity) {
+            node = node->prev;
+            pos = node->count;
+        } else if (pos == node->count || pos == 0) {
+            /* growing at an end of a full node, start a new one rather than leave two half full */
+            other = __clist_unrolled_node_new(list);
+            __clist_unrolled_node_link(list, pos == 0 ? node->prev : node, other);
+            node = other;
+            pos = 0;
+        } else {
+            other = __clist_unrolled_node_new(list);
+            half = node->count / 2;
+            memcpy(other->items, node->items + half, (node->count - half) * sizeof(ClistItem *));
+            other->count = node->count - half;
+            node->count = half;
+            __clist_unrolled_node_link(list, node, other);
+
+            if (pos > half) {
+                node = other;
+                pos -= half;
+            }
+        }
+    }
+
+    memmove(node->items + pos + 1, node->items + pos, (node->count - pos) * sizeof(ClistItem *));
+    node->items[pos] = item;
+    node->count++;
+    list->size++;
+
+    *where = node;
+    *offset = pos;
+}
+
+/*
+ * resolves an insert position to a node and offset
+ */
+static ClistUnrolledNode *__clist_unrolled_position(const ClistUnrolled *list, size_t index, size_t *offset) {
+    if (index < list->size) {
+        return __clist_unrolled_locate(list, index, offset);
+    }
+
+    *offset = list->last ? list->last->count : 0;
+    return list->last;
+}
+
+/*
+ * removes an empty node, or merges an under full node into the previous one
+ * @return positive if the node was removed
+ */
+static int __clist_unrolled_compact(ClistUnrolled *list, ClistUnrolledNode *node) {
+    ClistUnrolledNode *prev = node->prev;
+
+    __clist_unrolled_forget(list);
+
+    if (node->count == 0) {
+        __clist_unrolled_node_unlink(list, node);
+        return 1;
+    }
+
+    if (node->count >= list->capacity / 2 || prev == NULL || prev->count + node->count > list->capacity) {
+        return 0;
+    }
+
+    memcpy(prev->items + prev->count, node->items, node->count * sizeof(ClistItem *));
+    prev->count += node->count;
+    __clist_unrolled_node_unlink(list, node);
+    return 1;
+}
+
+/*
+ * restores the occupancy of a node after a remove
+ */
+static void __clist_unrolled_balance(ClistUnrolled *list, ClistUnrolledNode *node) {
+    ClistUnrolledNode *next = node->next, *prev = node->prev;
+    size_t move = 0;
+
+    if (__clist_unrolled_compact(list, node) || node->count >= list->capacity / 2) {
+        return;
+    }
+
+    if (next && node->count + next->count <= list->capacity) {
+        memcpy(node->items + node->count, next->items, next->count * sizeof(ClistItem *));
+        node->count += next->count;
+        __clist_unrolled_node_unlink(list, next);
+        return;
+    }
+
+    /* the neighbours are too full to merge, borrow half the difference */
+    if (next) {
+        move = (next->count - node->count) / 2;
+        memcpy(node->items + node->count, next->items, move * sizeof(ClistItem *));
+        memmove(next->items, next->items + move, (next->count - move) * sizeof(ClistItem *));
+        next->count -= move;
+        node->count += move;
+    } else if (prev) {
+        move = (prev->count - node->count) / 2;
+        memmove(node->items + move, node->items, node->count * sizeof(ClistItem *));
+        memcpy(node->items, prev->items + prev->count - move, move * sizeof(ClistItem *));
+        prev->count -= move;
+        node->count += move;
+    }
+}
+
+/*
+ * removes an item from a node without deleting it
+ * @return the removed item
+ */
+static ClistItem *__clist_unrolled_take(ClistUnrolled *list, ClistUnrolledNode *node, size_t offset) {
+    ClistItem *item = node->items[offset];
+
+    memmove(node->items + offset, node->items + offset + 1, (node->count - offset - 1) * sizeof(ClistItem *));
+    node->count--;
+    list->size--;
+
+    __clist_unrolled_forget(list);
+
+    __clist_unrolled_balance(list, node);
+
+    return item;
+}
+
+void *clist_unrolled_new() {
+    ClistUnrolled *list = malloc(sizeof(ClistUnrolled));
+    assert(list != NULL);
+    list->first = NULL;
+    list->last = NULL;
+    list->size = 0;
+    list->capacity = CLIST_UNROLLED_DEFAULT_CAPACITY;
+    list->cursor = NULL;
+    list->cursor_base = 0;
+    return list;
+}
+
+void __clist_unrolled_set_capacity(Clist *list, size_t capacity) {
+    ClistUnrolled *impl = NULL;
+
+    assert(list != NULL);
+
+    impl = __clist_unrolled_impl(list);
+
+    assert(impl->first == NULL);
+
+    if (capacity == 0) {
+        capacity = CLIST_UNROLLED_DEFAULT_CAPACITY;
+    } else if (capacity < CLIST_UNROLLED_MIN_CAPACITY) {
+        capacity = CLIST_UNROLLED_MIN_CAPACITY;
+    }
+
+    impl->capacity = capacity;
+}
+
+void clist_unrolled_delete(Clist *list) {
+    assert(list != NULL);
+
+    clist_unrolled_clear(list);
+
+    free(__clist_unrolled_impl(list));
+}
+
+void clist_unrolled_add(Clist *list, ClistItem *item) {
+    ClistUnrolled *impl = NULL;
+    ClistUnrolledNode *node = NULL;
+    size_t offset = 0;
+
+    assert(list != NULL);
+    assert(item != NULL);
+
+    impl = __clist_unrolled_impl(list);
+
+    node = impl->first;
+
+    __clist_unrolled_insert(impl, &node, &offset, item);
+}
+
+void clist_unrolled_add_last(Clist *list, ClistItem *item) {
+    ClistUnrolled *impl = NULL;
+    ClistUnrolledNode *node = NULL;
+    size_t offset = 0;
+
+    assert(list != NULL);
+    assert(item != NULL);
+
+    impl = __clist_unrolled_impl(list);
+
+    node = __clist_unrolled_position(impl, impl->size, &offset);
+
+    __clist_unrolled_insert(impl, &node, &offset, item);
+}
+
+ClistItem *clist_unrolled_pop_first(Clist *list) {
+    ClistUnrolled *impl = NULL;
+
+    assert(list != NULL);
+
+    impl = __clist_unrolled_impl(list);
+
+    if (impl->size == 0) {
+        return NULL;
+    }
+
+    return __clist_unrolled_take(impl, impl->first, 0);
+}
+
+ClistItem *clist_unrolled_pop_last(Clist *list) {
+    ClistUnrolled *impl = NULL;
+
+    assert(list != NULL);
+
+    impl = __clist_unrolled_impl(list);
+
+    if (impl->size == 0) {
+        return NULL;
+    }
+
+    return __clist_unrolled_take(impl, impl->last, impl->last->count - 1);
+}
+
+void clist_unrolled_add_index(Clist *list, size_t index, ClistItem *item) {
+    ClistUnrolled *impl = NULL;
+    ClistUnrolledNode *node = NULL;
+    size_t offset = 0;
+
+    assert(list != NULL);
+    assert(item != NULL);
+
+    impl = __clist_unrolled_impl(list);
+
+    if (index >= impl->size) {
+        return;
+    }
+
+    node = __clist_unrolled_position(impl, index + 1, &offset);
+
+    __clist_unrolled_insert(impl, &node, &offset, item);
+}
+
+/*
+ * inserts some items at a position, preserving their order
+ */
+static void __clist_unrolled_insert_batch(ClistUnrolled *list, size_t index, ClistItem **items, size_t count) {
+    ClistUnrolledNode *node = NULL;
+    size_t offset = 0, i = 0;
+
+    node = __clist_unrolled_position(list, index, &offset);
+
+    for (i = 0; i < count; i++, offset++) {
+        __clist_unrolled_insert(list, &node, &offset, items[i]);
+    }
+}
+
+void clist_unrolled_add_batch(Clist *list, ClistItem **items, size_t count) {
+    assert(list != NULL);
+    assert(items != NULL);
+
+    __clist_unrolled_insert_batch(__clist_unrolled_impl(list), 0, items, count);
+}
+
+void clist_unrolled_add_batch_index(Clist *list, size_t index, ClistItem **items, size_t count) {
+    ClistUnrolled *impl = NULL;
+
+    assert(list != NULL);
+    assert(items != NULL);
+
+    impl = __clist_unrolled_impl(list);
+
+    if (index < impl->size) {
+        __clist_unrolled_insert_batch(impl, index + 1, items, count);
+    }
+}
+
+void clist_unrolled_transfer(Clist *list, size_t index, Clist *other, size_t from, size_t count) {
+    ClistUnrolled *impl = NULL, *source = NULL;
+    ClistUnrolledNode *node = NULL, *next = NULL, *head = NULL, *tail = NULL;
+    ClistItem **items = NULL;
+    size_t offset = 0, moved = 0, take = 0;
+
+    assert(list != NULL);
+    assert(other != NULL);
+
+    impl = __clist_unrolled_impl(list);
+    source = __clist_unrolled_impl(other);
+
+    assert(index <= impl->size);
+    assert(count > 0 && from + count <= source->size);
+
+    items = malloc(count * sizeof(ClistItem *));
+    assert(items != NULL);
+
+    /* cut the item pointers out of the other list, freeing the nodes that empty */
+    node = __clist_unrolled_locate(source, from, &offset);
+
+    for (; moved < count; node = next, offset = 0) {
+        take = node->count - offset;
+
+        if (take > count - moved) {
+            take = count - moved;
+        }
+
+        memcpy(items + moved, node->items + offset, take * sizeof(ClistItem *));
+        memmove(node->items + offset, node->items + offset + take,
+                (node->count - offset - take) * sizeof(ClistItem *));
+        node->count -= take;
+        moved += take;
+
+        next = node->next;
+
+        if (node->count == 0) {
+            __clist_unrolled_node_unlink(source, node);
+        } else if (head == NULL) {
+            head = node;
+        } else {
+            tail = node;
+        }
+    }
+
+    source->size -= count;
+
+    __clist_unrolled_forget(source);
+
+    /* only the nodes at either end of the cut can be under full */
+    if (tail != NULL) {
+        __clist_unrolled_balance(source, tail);
+    }
+
+    if (head != NULL) {
+        __clist_unrolled_balance(source, head);
+    }
+
+    __clist_unrolled_insert_batch(impl, index, items, count);
+
+    free(items);
+}
+
+typedef struct __clist_unrolled_copy_arg {
+    ClistItem **slot;
+} ClistUnrolledCopyArg;
+
+static ClistCallbackReturn __clist_unrolled_copy_item(ClistItem *item, void *arg) {
+    ClistUnrolledCopyArg *params = (ClistUnrolledCopyArg *) arg;
+    *params->slot++ = clist_item_copy(item);
+    return ClistIterateNext;
+}
+
+/*
+ * inserts copies of the items in another list at a position, preserving their order
+ */
+static void __clist_unrolled_insert_copies(Clist *list, size_t index, const Clist *other) {
+    ClistUnrolled *impl = NULL;
+    ClistUnrolledNode *node = NULL;
+    ClistUnrolledCopyArg params;
+    ClistItem **copies = NULL;
+    size_t count = 0, offset = 0, i = 0;
+
+    impl = __clist_unrolled_impl(list);
+
+    count = clist_size(other);
+
+    if (count == 0) {
+        return;
+    }
+
+    /* copy first, inserting would move the items being visited */
+    copies = malloc(count * sizeof(ClistItem *));
+    assert(copies != NULL);
+
+    params.slot = copies;
+
+    __clist_visit(other, __clist_unrolled_copy_item, &params);
+
+    node = __clist_unrolled_position(impl, index, &offset);
+
+    for (i = 0; i < count; i++, offset++) {
+        __clist_unrolled_insert(impl, &node, &offset, copies[i]);
+    }
+
+    free(copies);
+}
+
+void clist_unrolled_add_all(Clist *list, const Clist *other) {
+    assert(list != NULL);
+    assert(other != NULL);
+
+    __clist_unrolled_insert_copies(list, 0, other);
+}
+
+void clist_unrolled_add_all_index(Clist *list, size_t index, const Clist *other) {
+    assert(list != NULL);
+    assert(other != NULL);
+
+    if (index >= __clist_unrolled_impl(list)->size) {
+        return;
+    }
+
+    __clist_unrolled_insert_copies(list, index + 1, other);
+}
+
+void clist_unrolled_clear(Clist *list) {
+    ClistUnrolled *impl = NULL;
+    ClistUnrolledNode *node = NULL, *next = NULL;
+    size_t pos = 0;
+
+    assert(list != NULL);
+
+    impl = __clist_unrolled_impl(list);
+
+    for (node = impl->first; node; node = next) {
+        next = node->next;
+
+        for (pos = 0; pos < node->count; pos++) {
+            clist_item_delete(node->items[pos]);
+        }
+
+        free(node);
+    }
+
+    impl->first = NULL;
+    impl->last = NULL;
+    impl->size = 0;
+
+    __clist_unrolled_forget(impl);
+}
+
+int clist_unrolled_contains(const Clist *list, const void *data) {
+    if (list == NULL) {
+        return 0;
+    }
+
+    return __clist_unrolled_find(__clist_unrolled_impl(list), data, NULL, NULL) != -1;
+}
+
+typedef struct __clist_unrolled_count_arg {
+    const ClistUnrolled *list;
+    int count;
+} ClistUnrolledCountArg;
+
+static ClistCallbackReturn __clist_unrolled_count_found(ClistItem *item, void *arg) {
+    ClistUnrolledCountArg *params = (ClistUnrolledCountArg *) arg;
+
+    if (__clist_unrolled_find(params->list, item->data, NULL, NULL) != -1) {
+        params->count++;
+    }
+    return ClistIterateNext;
+}
+
+int clist_unrolled_contains_all(const Clist *list, const Clist *other) {
+    ClistUnrolledCountArg params;
+
+    if (list == NULL || other == NULL) {
+        return 0;
+    }
+
+    params.list = __clist_unrolled_impl(list);
+    params.count = 0;
+
+    __clist_visit(other, __clist_unrolled_count_found, &params);
+
+    return params.count;
+}
+
+ClistItem *clist_unrolled_get_item(const Clist *list, size_t index) {
+    ClistUnrolled *impl = NULL;
+    ClistUnrolledNode *node = NULL;
+    size_t offset = 0;
+
+    if (list == NULL) {
+        return NULL;
+    }
+
+    impl = __clist_unrolled_impl(list);
+
+    if (index >= impl->size) {
+        return NULL;
+    }
+
+    node = __clist_unrolled_locate(impl, index, &offset);
+
+    return node->items[offset];
+}
+
+void *clist_unrolled_get(const Clist *list, size_t index) {
+    ClistItem *item = clist_unrolled_get_item(list, index);
+
+    if (item == NULL) {
+        return NULL;
+    }
+
+    return item->data;
+}
+
+int clist_unrolled_remove_index(Clist *list, size_t index) {
+    ClistUnrolled *impl = NULL;
+    ClistUnrolledNode *node = NULL;
+    size_t offset = 0;
+
+    if (list == NULL) {
+        return 0;
+    }
+
+    impl = __clist_unrolled_impl(list);
+
+    if (index >= impl->size) {
+        return 0;
+    }
+
+    node = __clist_unrolled_locate(impl, index, &offset);
+
+    clist_item_delete(__clist_unrolled_take(impl, node, offset));
+
+    return 1;
+}
+
+int clist_unrolled_remove(Clist *list, const void *data) {
+    ClistUnrolled *impl = NULL;
+    ClistUnrolledNode *node = NULL;
+    size_t offset = 0;
+
+    if (list == NULL) {
+        return 0;
+    }
+
+    impl = __clist_unrolled_impl(list);
+
+    if (__clist_unrolled_find(impl, data, &node, &offset) == -1) {
+        return 0;
+    }
+
+    clist_item_delete(__clist_unrolled_take(impl, node, offset));
+
+    return 1;
+}
+
+typedef struct __clist_unrolled_remove_arg {
+    Clist *list;
+    int count;
+} ClistUnrolledRemoveArg;
+
+static ClistCallbackReturn __clist_unrolled_remove_found(ClistItem *item, void *arg) {
+    ClistUnrolledRemoveArg *params = (ClistUnrolledRemoveArg *) arg;
+
+    if (clist_unrolled_remove(params->list, item->data)) {
+        params->count++;
+    }
+    return ClistIterateNext;
+}
+
+int clist_unrolled_remove_all(Clist *list, const Clist *other) {
+    ClistUnrolledRemoveArg params;
+    int result = 0;
+
+    if (list == NULL || other == NULL) {
+        return 0;
+    }
+
+    /* removing a list from itself empties it */
+    if (list == other) {
+        result = (int) __clist_unrolled_impl(list)->size;
+        clist_unrolled_clear(list);
+        return result;
+    }
+
+    params.list = list;
+    params.count = 0;
+
+    __clist_visit(other, __clist_unrolled_remove_found, &params);
+
+    return params.count;
+}
+
+int clist_unrolled_index_of(const Clist *list, const void *data) {
+    if (list == NULL) {
+        return -1;
+    }
+
+    return __clist_unrolled_find(__clist_unrolled_impl(list), data, NULL, NULL);
+}
+
+void clist_unrolled_set(Clist *list, size_t index, ClistItem *item) {
+    ClistUnrolled *impl = NULL;
+    ClistUnrolledNode *node = NULL;
+    size_t offset = 0;
+
+    if (list == NULL) {
+        return;
+    }
+
+    impl = __clist_unrolled_impl(list);
+
+    if (index >= impl->size) {
+        return;
+    }
+
+    node = __clist_unrolled_locate(impl, index, &offset);
+
+    clist_item_delete(node->items[offset]);
+
+    node->items[offset] = item;
+}
+
+size_t clist_unrolled_size(const Clist *list) {
+    if (list == NULL) {
+        return 0;
+    }
+
+    return __clist_unrolled_impl(list)->size;
+}
+
+int clist_unrolled_is_empty(const Clist *list) {
+    assert(list != NULL);
+    return __clist_unrolled_impl(list)->size == 0;
+}
+
+/*
+ * copies the item pointers into a flat array for sorting
+ */
+static ClistItem **__clist_unrolled_gather(const ClistUnrolled *list) {
+    ClistUnrolledNode *node = NULL;
+    ClistItem **items = NULL, **slot = NULL;
+
+    items = malloc(list->size * sizeof(ClistItem *));
+    assert(items != NULL);
+
+    for (node = list->first, slot = items; node; slot += node->count, node = node->next) {
+        memcpy(slot, node->items, node->count * sizeof(ClistItem *));
+    }
+    return items;
+}
+
+/*
+ * writes sorted item pointers back and frees the array, the nodes are unchanged
+ */
+static void __clist_unrolled_scatter(ClistUnrolled *list, ClistItem **items) {
+    ClistUnrolledNode *node = NULL;
+    ClistItem **slot = NULL;
+
+    for (node = list->first, slot = items; node; slot += node->count, node = node->next) {
+        memcpy(node->items, slot, node->count * sizeof(ClistItem *));
+    }
+
+    free(items);
+}
+
+void clist_unrolled_sort_with(Clist *list, const ClistSortComparer *comparer) {
+    ClistUnrolled *impl = NULL;
+    ClistItem **items = NULL;
+
+    if (clist_size(list) <= 1) {
+        return;
+    }
+
+    impl = __clist_unrolled_impl(list);
+
+    items = __clist_unrolled_gather(impl);
+
+    __clist_sort_items(items, impl->size, comparer);
+
+    __clist_unrolled_scatter(impl, items);
+}
+
+void clist_unrolled_sort(Clist *list) {
+    clist_unrolled_sort_with(list, NULL);
+}
+
+void clist_unrolled_sort_by_key(Clist *list, ClistKeyCallback key, void *ctx) {
+    ClistUnrolled *impl = NULL;
+    ClistItem **items = NULL;
+
+    if (clist_size(list) <= 1) {
+        return;
+    }
+
+    impl = __clist_unrolled_impl(list);
+
+    items = __clist_unrolled_gather(impl);
+
+    __clist_sort_items_by_key(items, impl->size, key, ctx);
+
+    __clist_unrolled_scatter(impl, items);
+}
+
+void clist_unrolled_visit(Clist *list, ClistVisitCallback callback, void *arg) {
+    ClistUnrolled *impl = NULL;
+    ClistUnrolledNode *node = NULL, *next = NULL;
+    size_t pos = 0, kept = 0;
+
+    assert(list != NULL);
+    assert(callback != NULL);
+
+    impl = __clist_unrolled_impl(list);
+
+    /* deleted items are compacted out of each node as we go */
+    for (node = impl->first; node; node = next) {
+        next = node->next;
+
+        for (pos = 0, kept = 0; pos < node->count; pos++) {
+            switch (callback(node->items[pos], arg)) {
+                case ClistIteratorBreak:
+                    memmove(node->items + kept, node->items + pos, (node->count - pos) * sizeof(ClistItem *));
+                    impl->size -= pos - kept;
+                    node->count -= pos - kept;
+                    __clist_unrolled_balance(impl, node);
+                    return;
+                case ClistIteratorDelete:
+                    clist_item_delete(node->items[pos]);
+                    break;
+                default:
+                    node->items[kept++] = node->items[pos];
+                    break;
+            }
+        }
+
+        impl->size -= node->count - kept;
+        node->count = kept;
+
+        /* only merge backwards, the next node hasn't been visited */
+        __clist_unrolled_compact(impl, node);
+    }
+}
+
+/*
+ * the iterator node and offset hold the last item stepped over
+ */
+ClistItem *clist_unrolled_iter_next(ClistIterator *iter) {
+    ClistUnrolled *impl = __clist_unrolled_impl(iter->list);
+    ClistUnrolledNode *node = (ClistUnrolledNode *) iter->node;
+
+    if (iter->index >= impl->size) {
+        return NULL;
+    }
+
+    if (node == NULL) {
+        node = impl->first;
+        iter->offset = 0;
+    } else if (++iter->offset == node->count) {
+        node = node->next;
+        iter->offset = 0;
+    }
+
+    iter->node = node;
+    iter->index++;
+
+    return node->items[iter->offset];
+}
+
+void clist_unrolled_iter_remove(ClistIterator *iter) {
+    ClistUnrolled *impl = __clist_unrolled_impl(iter->list);
+    ClistUnrolledNode *node = (ClistUnrolledNode *) iter->node;
+    ClistUnrolledNode *prev = node->prev;
+    size_t base = iter->index - 1 - iter->offset;
+
+    if (prev != NULL) {
+        base -= prev->count;
+    }
+
+    clist_item_delete(__clist_unrolled_take(impl, node, iter->offset));
+
+    iter->index--;
+
+    if (iter->index == 0) {
+        iter->node = NULL;
+        return;
+    }
+
+    /* balancing only moves items between the node and its neighbours, so the previous node still starts at base */
+    if (prev != NULL) {
+        impl->cursor = prev;
+        impl->cursor_base = base;
+    } else {
+        impl->cursor = impl->first;
+        impl->cursor_base = 0;
+    }
+
+    iter->node = __clist_unrolled_locate(impl, iter->index - 1, &iter->offset);
+}
+
+int clist_unrolled_iter_insert(ClistIterator *iter, ClistItem *item) {
+    ClistUnrolled *impl = __clist_unrolled_impl(iter->list);
+    ClistUnrolledNode *node = (ClistUnrolledNode *) iter->node;
+    size_t offset = iter->offset + 1;
+
+    if (node == NULL) {
+        node = impl->first;
+        offset = 0;
+    }
+
+    __clist_unrolled_insert(impl, &node, &offset, item);
+
+    iter->node = node;
+    iter->offset = offset;
+    iter->index++;
+
+    return 1;
+}
+
+typedef struct __clist_unrolled_for_each_arg {
+    Clist *list;
+    ClistCallback callback;
+    size_t index;
+} ClistUnrolledForEachArg;
+
+static ClistCallbackReturn __clist_unrolled_for_each_item(ClistItem *item, void *arg) {
+    ClistUnrolledForEachArg *params = (ClistUnrolledForEachArg *) arg;
+
+    return params->callback(params->list, params->index++, item);
+}
+
+void clist_unrolled_for_each(Clist *list, ClistCallback callback) {
+    ClistUnrolledForEachArg params;
+
+    assert(list != NULL);
+    assert(callback != NULL);
+
+    params.list = list;
+    params.callback = callback;
+    params.index = 0;
+
+    clist_unrolled_visit(list, __clist_unrolled_for_each_item, &params);
+}
+
+static ClistVtable __clist_unrolled_table = {.create = clist_unrolled_new,
+        .destroy = clist_unrolled_delete,
+        .add = clist_unrolled_add,
+        .add_last = clist_unrolled_add_last,
+        .pop_first = clist_unrolled_pop_first,
+        .pop_last = clist_unrolled_pop_last,
+        .add_all = clist_unrolled_add_all,
+        .add_index = clist_unrolled_add_index,
+        .add_all_index = clist_unrolled_add_all_index,
+        .add_batch = clist_unrolled_add_batch,
+        .add_batch_index = clist_unrolled_add_batch_index,
+        .transfer = clist_unrolled_transfer,
+        .clear = clist_unrolled_clear,
+        .contains = clist_unrolled_contains,
+        .contains_all = clist_unrolled_contains_all,
+        .get = clist_unrolled_get,
+        .get_item = clist_unrolled_get_item,
+        .remove = clist_unrolled_remove,
+        .remove_index = clist_unrolled_remove_index,
+        .remove_all = clist_unrolled_remove_all,
+        .index_of = clist_unrolled_index_of,
+        .set = clist_unrolled_set,
+        .size = clist_unrolled_size,
+        .is_empty = clist_unrolled_is_empty,
+        .sort = clist_unrolled_sort,
+        .sort_with = clist_unrolled_sort_with,
+        .sort_by_key = clist_unrolled_sort_by_key,
+        .for_each = clist_unrolled_for_each,
+        .iter_next = clist_unrolled_iter_next,
+        .iter_remove = clist_unrolled_iter_remove,
+        .iter_insert = clist_unrolled_iter_insert,
+        .visit = clist_unrolled_visit};
+
+ClistVtable *__clist_unrolled_vtable() {
+    return &__clist_unrolled_table;
+}
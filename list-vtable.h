@@ -5,6 +5,13 @@
 
 typedef struct __clist_vtable ClistVtable;
 
+/*
+ * internal callback for visiting the items in a list with user data
+ */
+typedef ClistCallbackReturn (*ClistVisitCallback)(ClistItem *item, void *arg);
+
+typedef struct __clist_sort_comparer ClistSortComparer;
+
 struct __clist_vtable {
     /**
      * creates a new list
@@ -26,6 +33,37 @@ struct __clist_vtable {
      */
     void (*add)(Clist *list, ClistItem *item);
 
+    /**
+     * prepends a copy of some data to the list
+     * the list owns the copy, allowing an implementation to store it with its node
+     * @param list the list instance
+     * @param data the data to copy
+     * @param size the size of the data in bytes
+     * @param comparator the compare function, can be NULL
+     */
+    void (*add_value)(Clist *list, const void *data, size_t size, ClistCompareCallback comparator);
+
+    /**
+     * appends a list item to the list
+     * @param list the list instance
+     * @param item the item to add to the list
+     */
+    void (*add_last)(Clist *list, ClistItem *item);
+
+    /**
+     * removes the first item from the list
+     * @param list the list instance
+     * @return the removed item, owned by the caller, or NULL if empty
+     */
+    ClistItem *(*pop_first)(Clist *list);
+
+    /**
+     * removes the last item from the list
+     * @param list the list instance
+     * @return the removed item, owned by the caller, or NULL if empty
+     */
+    ClistItem *(*pop_last)(Clist *list);
+
     /**
      * adds all items in a list to the list
      * @param list the list instance
@@ -52,6 +90,23 @@ struct __clist_vtable {
      */
     void (*add_all_index)(Clist *list, size_t index, const Clist *other);
 
+    /**
+     * prepends some items to the list, keeping their order
+     * @param list  the list instance
+     * @param items the items to add
+     * @param count the number of items
+     */
+    void (*add_batch)(Clist *list, ClistItem **items, size_t count);
+
+    /**
+     * adds some items to the list after the specific index, keeping their order
+     * @param list  the list instance
+     * @param index the index to add after
+     * @param items the items to add
+     * @param count the number of items
+     */
+    void (*add_batch_index)(Clist *list, size_t index, ClistItem **items, size_t count);
+
     /**
      * removes all items in the list
      * if the items have a destructor set, it will be called
@@ -86,6 +141,15 @@ struct __clist_vtable {
      */
     void *(*get)(const Clist *list, size_t index);
 
+    /**
+     * gets an item from a list
+     * used internally to keep track of the items entering and leaving the list
+     * @param  list  the list instance
+     * @param  index the index of the item
+     * @return       the item, still owned by the list, or NULL if out of range
+     */
+    ClistItem *(*get_item)(const Clist *list, size_t index);
+
     /**
      * removes an item from a list
      * items must have a compare function set
@@ -95,6 +159,14 @@ struct __clist_vtable {
      */
     int (*remove)(Clist *list, const void *item);
 
+    /**
+     * removes an item from a list by identity, optional
+     * @param  list the list instance
+     * @param  item the item to remove, destroyed if found
+     * @return      zero if nothing was removed, otherwise a positive value
+     */
+    int (*remove_item)(Clist *list, ClistItem *item);
+
     /**
      * removes an index from a list
      * @param  list  the list instance
@@ -144,17 +216,80 @@ struct __clist_vtable {
 
     /**
      * sorts the list based on the comparator
-     * NOTE: the implementation is subject to change
+     * the sort must be stable
      * @param  list the list instance
      */
     void (*sort)(Clist *list);
 
+    /**
+     * sorts the list with a compare function, the sort must be stable
+     * @param list the list instance
+     * @param comparer the compare function and its user data
+     */
+    void (*sort_with)(Clist *list, const ClistSortComparer *comparer);
+
+    /**
+     * sorts the list by a key extracted once per item, the sort must be stable
+     * @param list the list instance
+     * @param key the key function
+     * @param ctx user data passed to the key function
+     */
+    void (*sort_by_key)(Clist *list, ClistKeyCallback key, void *ctx);
+
+    /**
+     * moves a range of items from another list into the list, without copying the items
+     * @param list  the list instance
+     * @param index the position in the list for the first item moved, at most the size
+     * @param other another list of the same implementation
+     * @param from  the index in the other list of the first item to move
+     * @param count the number of items to move, at least one and all in the other list
+     */
+    void (*transfer)(Clist *list, size_t index, Clist *other, size_t from, size_t count);
+
+    /**
+     * gets the node pool counters for a list
+     * @param list the list instance
+     * @param stats the counters to fill
+     * @return positive if the list uses a pool, otherwise zero
+     */
+    int (*pool_stats)(const Clist *list, ClistPoolStats *stats);
+
     /**
      * iterates the list
      * @param list the list instance
      * @param callback the iterator callback
      */
     void (*for_each)(Clist *list, ClistCallback callback);
+
+    /**
+     * visits each item in the list in order
+     * used internally to work with lists of another implementation
+     * @param list the list instance
+     * @param callback the visit callback
+     * @param arg user data passed to the callback
+     */
+    void (*visit)(Clist *list, ClistVisitCallback callback, void *arg);
+
+    /**
+     * steps an iterator to the next item
+     * @param iter the iterator, with the list and the positions set
+     * @return the next item or NULL at the end
+     */
+    ClistItem *(*iter_next)(ClistIterator *iter);
+
+    /**
+     * removes the item an iterator last stepped to, leaving the iterator before the next item
+     * @param iter the iterator, with an item to remove
+     */
+    void (*iter_remove)(ClistIterator *iter);
+
+    /**
+     * inserts an item where an iterator is, and moves the iterator past it
+     * @param iter the iterator
+     * @param item the item to insert
+     * @return positive if the item was inserted, zero if it was rejected and is left with the caller
+     */
+    int (*iter_insert)(ClistIterator *iter, ClistItem *item);
 };
 
 #endif
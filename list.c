@@ -1,4 +1,5 @@
 #include <assert.h>
+#include <stdint.h>
 #include <clist/list.h>
 #include "internal.h"
 
@@ -19,14 +20,15 @@
  */
 #define clist_vtable2(list, fun, arg1, arg2) ((list)->vtable->fun)((list), (arg1), (arg2))
 
-/**
- * creates a new list
- * @return an allocated list object
+/*
+ * creates a list with a specific implementation
  */
-Clist *clist_new_single() {
+static Clist *__clist_new(ClistVtable *vtable) {
     Clist *list = malloc(sizeof(Clist));
 
-    list->vtable = clist_single_vtable();
+    assert(list != NULL);
+
+    list->vtable = vtable;
 
     assert(list->vtable != NULL);
 
@@ -34,9 +36,226 @@ Clist *clist_new_single() {
 
     list->impl = clist_vtable0(list, create);
 
+    list->index = NULL;
+
+    list->join = ClistJoinAuto;
+
+    list->join_hash = NULL;
+
+    return list;
+}
+
+/*
+ * creates an empty list of the same implementation and join strategy as another
+ */
+static Clist *__clist_new_like(const Clist *other) {
+    Clist *list = __clist_new(other->vtable);
+
+    /* a ring has nowhere to put items until it has a capacity */
+    if (other->vtable == __clist_ring_vtable()) {
+        __clist_ring_copy_capacity(list, other);
+    }
+
+    /* a concurrent list wraps a list like the one it wraps */
+    if (other->vtable == __clist_concurrent_vtable()) {
+        __clist_concurrent_set_inner(list, __clist_new_like(__clist_concurrent_inner(other)));
+    }
+
+    list->join = other->join;
+
+    list->join_hash = other->join_hash;
+
+    return list;
+}
+
+static ClistCallbackReturn __clist_index_attach_item(ClistItem *item, void *arg) {
+    __clist_index_attach((ClistIndex *) arg, item);
+    return ClistIterateNext;
+}
+
+/*
+ * indexes all the items again, after an implementation has added or deleted items internally
+ */
+void __clist_reindex(Clist *list) {
+    if (list->index == NULL) {
+        return;
+    }
+
+    __clist_index_clear(list->index);
+
+    __clist_visit(list, __clist_index_attach_item, list->index);
+}
+
+/*
+ * removes the item at an index from the hash index, before it leaves the list
+ */
+static void __clist_index_detach_at(Clist *list, size_t index) {
+    ClistItem *item = NULL;
+
+    if (list->index == NULL) {
+        return;
+    }
+
+    item = clist_vtable1(list, get_item, index);
+
+    if (item != NULL) {
+        __clist_index_detach(list->index, item);
+    }
+}
+
+/*
+ * finds the position of the first item matching some data with the hash index.
+ * misses take constant time, hits are located by the implementation, as without an index.
+ * @return the position or -1 if not found
+ */
+static int __clist_index_position(const Clist *list, const void *data) {
+    if (__clist_index_find(list->index, data, NULL, 0) == 0) {
+        return -1;
+    }
+
+    return clist_vtable1(list, index_of, data);
+}
+
+/**
+ * creates a new list
+ * @return an allocated list object
+ */
+Clist *clist_new_single() {
+    return __clist_new(__clist_single_vtable());
+}
+
+/**
+ * creates a new list that allocates its nodes from blocks owned by the list
+ * @param block_size the number of nodes to allocate at once, zero for a default
+ * @return an allocated list object
+ */
+Clist *clist_new_single_pooled(size_t block_size) {
+    Clist *list = __clist_new(__clist_single_vtable());
+
+    __clist_single_set_pool(list, block_size);
+
+    return list;
+}
+
+/**
+ * creates a new list that allocates its nodes, and the items it copies, from an arena owned by the list
+ * @param block_size the number of bytes to allocate at once, zero for a default
+ * @return an allocated list object
+ */
+Clist *clist_new_single_arena(size_t block_size) {
+    Clist *list = __clist_new(__clist_single_vtable());
+
+    __clist_single_set_arena(list, block_size);
+
+    return list;
+}
+
+/**
+ * creates a new list backed by a dynamic array
+ * @return an allocated list object
+ */
+Clist *clist_new_array() {
+    return __clist_new(__clist_array_vtable());
+}
+
+/**
+ * creates a new list backed by a dynamic array
+ * @param capacity the number of items to reserve space for
+ * @return an allocated list object
+ */
+Clist *clist_new_array_with_capacity(size_t capacity) {
+    Clist *list = __clist_new(__clist_array_vtable());
+
+    __clist_array_reserve(list, capacity);
+
+    return list;
+}
+
+/**
+ * creates a new unrolled linked list
+ * @param chunk_capacity the number of items held by each node, zero for a default
+ * @return an allocated list object
+ */
+Clist *clist_new_unrolled(size_t chunk_capacity) {
+    Clist *list = __clist_new(__clist_unrolled_vtable());
+
+    __clist_unrolled_set_capacity(list, chunk_capacity);
+
+    return list;
+}
+
+/**
+ * creates a new ordered list
+ * @return an allocated list object
+ */
+Clist *clist_new_ordered() {
+    return __clist_new(__clist_ordered_vtable());
+}
+
+/**
+ * creates a new rope
+ * @return an allocated list object
+ */
+Clist *clist_new_rope() {
+    return __clist_new(__clist_rope_vtable());
+}
+
+/**
+ * creates a new ring, overwriting its oldest items when full
+ * @param capacity the most items the ring holds, at least one
+ * @return an allocated list object
+ */
+Clist *clist_new_ring(size_t capacity) {
+    return clist_new_ring_with_policy(capacity, ClistRingOverwrite);
+}
+
+/**
+ * creates a new ring with a policy for adding to it when full
+ * @param capacity the most items the ring holds, at least one
+ * @param policy what to do with an added item when full
+ * @return an allocated list object
+ */
+Clist *clist_new_ring_with_policy(size_t capacity, ClistRingPolicy policy) {
+    Clist *list = __clist_new(__clist_ring_vtable());
+
+    __clist_ring_set_capacity(list, capacity, policy);
+
+    return list;
+}
+
+/**
+ * creates a stack that threads can add to and pop from without locking
+ * @return an allocated list object
+ */
+Clist *clist_new_lockfree_stack() {
+    return __clist_new(__clist_lockfree_vtable());
+}
+
+/**
+ * creates a list that can be shared between threads
+ * @param inner the list to wrap, owned by the concurrent list
+ * @return an allocated list object
+ */
+Clist *clist_new_concurrent(Clist *inner) {
+    Clist *list = NULL;
+
+    assert(inner != NULL);
+
+    list = __clist_new(__clist_concurrent_vtable());
+
+    __clist_concurrent_set_inner(list, inner);
+
     return list;
 }
 
+/**
+ * creates a new doubly linked list
+ * @return an allocated list object
+ */
+Clist *clist_new_double() {
+    return __clist_new(__clist_double_vtable());
+}
+
 /**
  * destroys a created list
  * @param list the list instance
@@ -48,6 +267,8 @@ void clist_delete(Clist *list) {
 
     clist_vtable0(list, destroy);
 
+    __clist_index_delete(list->index);
+
     free(list);
 }
 
@@ -62,9 +283,124 @@ void clist_add(Clist *list, ClistItem *item) {
 
     clist_assert_vtable(list, add);
 
+    /* attached first, so a full ring can detach the item it drops */
+    if (list->index) {
+        __clist_index_attach(list->index, item);
+    }
+
     clist_vtable1(list, add, item);
 }
 
+/**
+ * prepends a copy of some data to the list
+ * the list owns the copy, which is stored in a single allocation with the
+ * list node and item where the implementation supports it
+ * @param list       the list instance
+ * @param data       the data to copy
+ * @param size       the size of the data in bytes
+ * @param comparator the compare function, can be NULL
+ */
+void clist_add_value(Clist *list, const void *data, size_t size, ClistCompareCallback comparator) {
+    assert(list != NULL);
+
+    /* implementations without node storage hold the data in the item, as does an indexed
+     * ordered list, where the new item isn't first and has to be known to index it */
+    if (list->vtable->add_value == NULL || (list->index && list->vtable == __clist_ordered_vtable())) {
+        /* a full rejecting ring would leave the item with us */
+        if (__clist_ring_room(list) == 0) {
+            return;
+        }
+
+        clist_add(list, __clist_item_new_inline(data, size, __clist_item_type_intern(comparator, NULL, NULL, NULL)));
+        return;
+    }
+
+    (list->vtable->add_value)(list, data, size, comparator);
+
+    if (list->index) {
+        __clist_index_attach(list->index, clist_vtable1(list, get_item, 0));
+    }
+}
+
+/**
+ * appends a list item to the list
+ * @param list the list instance
+ * @param item the item to add to the list
+ * @see rj_list_item_create
+ */
+void clist_add_last(Clist *list, ClistItem *item) {
+    assert(list != NULL);
+
+    clist_assert_vtable(list, add_last);
+
+    if (list->index) {
+        __clist_index_attach(list->index, item);
+    }
+
+    clist_vtable1(list, add_last, item);
+}
+
+static int __clist_ring_offer_locked(Clist *list, void *arg) {
+    return clist_ring_offer(list, (ClistItem *) arg);
+}
+
+/**
+ * appends a list item to a ring, reporting if a full rejecting ring refused it
+ * @param list the ring instance, or a concurrent list wrapping one
+ * @param item the item to add to the ring
+ * @return positive if the item was added, zero if it was rejected and is still the caller's
+ */
+int clist_ring_offer(Clist *list, ClistItem *item) {
+    assert(list != NULL);
+
+    /* the room is checked and taken with the lock held */
+    if (list->vtable == __clist_concurrent_vtable()) {
+        return __clist_concurrent_apply(list, __clist_ring_offer_locked, item);
+    }
+
+    assert(list->vtable == __clist_ring_vtable());
+
+    if (__clist_ring_room(list) == 0) {
+        return 0;
+    }
+
+    clist_add_last(list, item);
+
+    return 1;
+}
+
+/**
+ * removes the first item from the list without destroying it
+ * @param list the list instance
+ * @return the removed item, owned by the caller, or NULL if the list is empty
+ */
+ClistItem *clist_pop_first(Clist *list) {
+    assert(list != NULL);
+
+    clist_assert_vtable(list, pop_first);
+
+    __clist_index_detach_at(list, 0);
+
+    return clist_vtable0(list, pop_first);
+}
+
+/**
+ * removes the last item from the list without destroying it
+ * @param list the list instance
+ * @return the removed item, owned by the caller, or NULL if the list is empty
+ */
+ClistItem *clist_pop_last(Clist *list) {
+    assert(list != NULL);
+
+    clist_assert_vtable(list, pop_last);
+
+    if (list->index && !clist_is_empty(list)) {
+        __clist_index_detach_at(list, clist_size(list) - 1);
+    }
+
+    return clist_vtable0(list, pop_last);
+}
+
 /**
  * adds an item to the list after the specific index
  * @param list  the list instance
@@ -77,6 +413,11 @@ void clist_add_index(Clist *list, size_t index, ClistItem *item) {
 
     clist_assert_vtable(list, add_index);
 
+    /* nothing is added past the end */
+    if (list->index && index < clist_size(list)) {
+        __clist_index_attach(list->index, item);
+    }
+
     clist_vtable2(list, add_index, index, item);
 }
 
@@ -93,6 +434,8 @@ void clist_add_all(Clist *list, const Clist *other) {
     clist_assert_vtable(list, add_all);
 
     clist_vtable1(list, add_all, other);
+
+    __clist_reindex(list);
 }
 
 /**
@@ -109,6 +452,67 @@ void clist_add_all_index(Clist *list, size_t index, const Clist *other) {
     clist_assert_vtable(list, add_all_index);
 
     clist_vtable2(list, add_all_index, index, other);
+
+    __clist_reindex(list);
+}
+
+/*
+ * attaches some items to the hash index
+ */
+static void __clist_index_attach_batch(Clist *list, ClistItem **items, size_t count) {
+    size_t i = 0;
+
+    for (i = 0; i < count; i++) {
+        __clist_index_attach(list->index, items[i]);
+    }
+}
+
+/**
+ * prepends some items to the list, keeping their order
+ * @param list  the list instance
+ * @param items the items to add
+ * @param count the number of items
+ */
+void clist_add_batch(Clist *list, ClistItem **items, size_t count) {
+    assert(list != NULL);
+    assert(items != NULL || count == 0);
+
+    clist_assert_vtable(list, add_batch);
+
+    if (count == 0) {
+        return;
+    }
+
+    if (list->index) {
+        __clist_index_attach_batch(list, items, count);
+    }
+
+    clist_vtable2(list, add_batch, items, count);
+}
+
+/**
+ * adds some items to the list after the specific index, keeping their order
+ * @param list  the list instance
+ * @param index the index to add after
+ * @param items the items to add
+ * @param count the number of items
+ */
+void clist_add_batch_index(Clist *list, size_t index, ClistItem **items, size_t count) {
+    assert(list != NULL);
+    assert(items != NULL || count == 0);
+
+    clist_assert_vtable(list, add_batch_index);
+
+    if (count == 0) {
+        return;
+    }
+
+    /* nothing is added past the end */
+    if (list->index && index < clist_size(list)) {
+        __clist_index_attach_batch(list, items, count);
+    }
+
+    (list->vtable->add_batch_index)(list, index, items, count);
 }
 
 /**
@@ -122,6 +526,10 @@ void clist_clear(Clist *list) {
     clist_assert_vtable(list, clear);
 
     clist_vtable0(list, clear);
+
+    if (list->index) {
+        __clist_index_clear(list->index);
+    }
 }
 
 /**
@@ -134,9 +542,191 @@ void clist_clear(Clist *list) {
 int clist_contains(const Clist *list, const void *item) {
     assert(list != NULL);
 
-    clist_assert_vtable(list, contains);
+    clist_assert_vtable(list, contains);
+
+    if (list->index) {
+        return __clist_index_find(list->index, item, NULL, 0) > 0;
+    }
+
+    return clist_vtable1(list, contains, item);
+}
+
+typedef struct __clist_index_count_arg {
+    const ClistIndex *index;
+    int count;
+} ClistIndexCountArg;
+
+static ClistCallbackReturn __clist_index_count_found(ClistItem *item, void *arg) {
+    ClistIndexCountArg *params = (ClistIndexCountArg *) arg;
+
+    if (__clist_index_find(params->index, item->data, NULL, 0) > 0) {
+        params->count++;
+    }
+    return ClistIterateNext;
+}
+
+/*
+ * moves a range of items between lists of the same implementation, keeping the hash indexes up to date
+ * @return the number of items moved, a rejecting ring may move none
+ */
+static size_t __clist_transfer(Clist *dst, size_t index, Clist *src, size_t from, size_t count) {
+    size_t i = 0, size = clist_size(src);
+
+    assert(dst != src);
+    assert(dst->vtable == src->vtable);
+
+    clist_assert_vtable(dst, transfer);
+
+    if (src->index) {
+        for (i = 0; i < count; i++) {
+            __clist_index_detach(src->index, clist_vtable1(src, get_item, from + i));
+        }
+    }
+
+    ((dst)->vtable->transfer)(dst, index, src, from, count);
+
+    if (clist_size(src) != size - count) {
+        __clist_reindex(src);
+        return size - clist_size(src);
+    }
+
+    /* an ordered list doesn't keep the moved items together, and a ring may drop some */
+    if (dst->vtable == __clist_ordered_vtable() || dst->vtable == __clist_ring_vtable()) {
+        __clist_reindex(dst);
+    } else if (dst->index) {
+        for (i = 0; i < count; i++) {
+            __clist_index_attach(dst->index, clist_vtable1(dst, get_item, index + i));
+        }
+    }
+
+    return count;
+}
+
+/**
+ * splits a list in two, without copying any items
+ * @param  list  the list instance
+ * @param  index the index of the first item to move
+ * @return       an allocated list, of the same implementation, with the items from the index onwards
+ */
+Clist *clist_split(Clist *list, size_t index) {
+    Clist *rest = NULL;
+    size_t size = 0;
+
+    assert(list != NULL);
+
+    rest = __clist_new_like(list);
+
+    size = clist_size(list);
+
+    if (index < size) {
+        __clist_transfer(rest, 0, list, index, size - index);
+    }
+
+    return rest;
+}
+
+/**
+ * moves all the items of another list to the end of a list, without copying them
+ * @param list  the list instance
+ * @param other a list of the same implementation, left empty
+ */
+void clist_concat(Clist *list, Clist *other) {
+    assert(list != NULL);
+    assert(other != NULL);
+
+    clist_splice(list, clist_size(list), other);
+}
+
+/**
+ * moves all the items of another list into a list at a position, without copying them
+ * @param dst   the list instance
+ * @param index the position of the first item moved, at most the size of the list
+ * @param src   a list of the same implementation, left empty
+ */
+void clist_splice(Clist *dst, size_t index, Clist *src) {
+    assert(dst != NULL);
+    assert(src != NULL);
+
+    clist_transfer_range(dst, index, src, 0, clist_size(src));
+}
+
+/**
+ * moves a range of items from another list into a list at a position, without copying them
+ * @param dst       the list instance
+ * @param dst_index the position of the first item moved, at most the size of the list
+ * @param src       a list of the same implementation
+ * @param from      the index of the first item to move
+ * @param count     the number of items to move, fewer are moved if the source ends first
+ * @return          the number of items moved
+ */
+size_t clist_transfer_range(Clist *dst, size_t dst_index, Clist *src, size_t from, size_t count) {
+    size_t size = 0;
+
+    assert(dst != NULL);
+    assert(src != NULL);
+
+    size = clist_size(src);
+
+    if (from >= size || dst_index > clist_size(dst)) {
+        return 0;
+    }
+
+    if (count > size - from) {
+        count = size - from;
+    }
+
+    if (count == 0) {
+        return 0;
+    }
+
+    return __clist_transfer(dst, dst_index, src, from, count);
+}
+
+/*
+ * below this many item pairs a scan is faster than building a hash set or sorting
+ */
+#define CLIST_JOIN_SCAN_LIMIT 256
+
+/*
+ * picks how to match the items in two lists
+ * @param hash set to the hash function to use, if any
+ */
+static ClistJoinStrategy __clist_join_strategy(const Clist *list, const Clist *other, ClistHashCallback *hash) {
+    ClistJoinStrategy strategy = list->join;
+    size_t size = 0, other_size = 0;
+
+    *hash = list->join_hash;
+
+    /* a concurrent list joins with the lock held, by its wrapped list */
+    if (list->vtable == __clist_concurrent_vtable()) {
+        return ClistJoinScan;
+    }
+
+    if (*hash == NULL && list->index) {
+        *hash = __clist_index_hasher(list->index);
+    }
 
-    return clist_vtable1(list, contains, item);
+    if (strategy == ClistJoinAuto) {
+        size = clist_size(list);
+        other_size = clist_size(other);
+
+        if (size == 0 || other_size == 0 || other_size <= CLIST_JOIN_SCAN_LIMIT / size) {
+            return ClistJoinScan;
+        }
+
+        strategy = *hash ? ClistJoinHash : ClistJoinSort;
+    }
+
+    if (strategy == ClistJoinHash && *hash == NULL) {
+        strategy = ClistJoinSort;
+    }
+
+    /* the joins hash whenever given a hash, so only the hash strategy gets one */
+    if (strategy != ClistJoinHash) {
+        *hash = NULL;
+    }
+
+    return strategy;
 }
 
 /**
@@ -147,11 +737,27 @@ int clist_contains(const Clist *list, const void *item) {
  * @return       zero if nothing found, otherwise the number of items found
  */
 int clist_contains_all(const Clist *list, const Clist *other) {
+    ClistIndexCountArg params;
+    ClistHashCallback hash = NULL;
+
     assert(list != NULL);
 
     clist_assert_vtable(list, contains_all);
 
-    return clist_vtable1(list, contains_all, other);
+    if (list->index && other != NULL) {
+        params.index = list->index;
+        params.count = 0;
+
+        __clist_visit(other, __clist_index_count_found, &params);
+
+        return params.count;
+    }
+
+    if (other == NULL || __clist_join_strategy(list, other, &hash) == ClistJoinScan) {
+        return clist_vtable1(list, contains_all, other);
+    }
+
+    return __clist_join_contains_all(list, other, hash);
 }
 
 /**
@@ -177,10 +783,37 @@ void *clist_get(const Clist *list, size_t index) {
  * @return      zero if nothing was removed, otherwise a positive value
  */
 int clist_remove(Clist *list, const void *item) {
+    ClistItem *found = NULL;
+    size_t count = 0;
+    int index = 0;
+
     assert(list != NULL);
 
     clist_assert_vtable(list, remove);
 
+    if (list->index) {
+        count = __clist_index_find(list->index, item, &found, 1);
+
+        if (count == 0) {
+            return 0;
+        }
+
+        /* the only match is the one the implementation would remove */
+        if (count == 1) {
+            __clist_index_detach(list->index, found);
+
+            if (list->vtable->remove_item != NULL) {
+                return clist_vtable1(list, remove_item, found);
+            }
+
+            return clist_vtable1(list, remove, item);
+        }
+
+        index = clist_vtable1(list, index_of, item);
+
+        return clist_remove_index(list, (size_t) index);
+    }
+
     return clist_vtable1(list, remove, item);
 }
 
@@ -195,6 +828,8 @@ int clist_remove_index(Clist *list, size_t index) {
 
     clist_assert_vtable(list, remove_index);
 
+    __clist_index_detach_at(list, index);
+
     return clist_vtable1(list, remove_index, index);
 }
 
@@ -206,11 +841,22 @@ int clist_remove_index(Clist *list, size_t index) {
  * @return       zero if nothing removed, otherwise the number of items removed
  */
 int clist_remove_all(Clist *list, const Clist *other) {
+    ClistHashCallback hash = NULL;
+    int count = 0;
+
     assert(list != NULL);
 
     clist_assert_vtable(list, remove_all);
 
-    return clist_vtable1(list, remove_all, other);
+    if (other == NULL || other == list || __clist_join_strategy(list, other, &hash) == ClistJoinScan) {
+        count = clist_vtable1(list, remove_all, other);
+    } else {
+        count = __clist_join_remove_all(list, other, hash);
+    }
+
+    __clist_reindex(list);
+
+    return count;
 }
 
 /**
@@ -224,6 +870,10 @@ int clist_index_of(const Clist *list, const void *item) {
 
     clist_assert_vtable(list, index_of);
 
+    if (list->index) {
+        return __clist_index_position(list, item);
+    }
+
     return clist_vtable1(list, index_of, item);
 }
 
@@ -238,6 +888,12 @@ void clist_set(Clist *list, size_t index, ClistItem *item) {
 
     clist_assert_vtable(list, set);
 
+    /* nothing is set past the end */
+    if (list->index && index < clist_size(list)) {
+        __clist_index_detach_at(list, index);
+        __clist_index_attach(list->index, item);
+    }
+
     clist_vtable2(list, set, index, item);
 }
 
@@ -269,7 +925,8 @@ int clist_is_empty(const Clist *list) {
 
 /**
  * sorts the list based on the comparator
- * NOTE: the implementation is subject to change
+ * the sort is stable, items that compare equal keep their order.
+ * runs already in order (or in reverse order) are detected, so a sorted list takes linear time.
  * @param  list the list instance
  */
 void clist_sort(Clist *list) {
@@ -279,3 +936,540 @@ void clist_sort(Clist *list) {
 
     clist_vtable0(list, sort);
 }
+
+/**
+ * sorts the list with a compare function taking user data, instead of the item compare functions
+ * @param list     the list instance
+ * @param compare  the compare function
+ * @param ctx      user data passed to the compare function
+ */
+void clist_sort_with(Clist *list, ClistSortCallback compare, void *ctx) {
+    ClistSortComparer comparer;
+
+    assert(list != NULL);
+    assert(compare != NULL);
+
+    clist_assert_vtable(list, sort_with);
+
+    comparer.compare = compare;
+    comparer.ctx = ctx;
+    comparer.threads = 1;
+
+    clist_vtable1(list, sort_with, &comparer);
+}
+
+/**
+ * sorts the list with several threads, with the same result as clist_sort
+ * @param list     the list instance
+ * @param nthreads the most threads to sort with, including the calling thread
+ */
+void clist_sort_parallel(Clist *list, size_t nthreads) {
+    ClistSortComparer comparer;
+
+    assert(list != NULL);
+
+    clist_assert_vtable(list, sort_with);
+
+    comparer.compare = NULL;
+    comparer.ctx = NULL;
+    comparer.threads = nthreads;
+
+    clist_vtable1(list, sort_with, &comparer);
+}
+
+/**
+ * sorts the list by an integer key, extracted once per item and cached for the sort
+ * @param list the list instance
+ * @param key  the key function
+ * @param ctx  user data passed to the key function
+ */
+void clist_sort_by_key(Clist *list, ClistKeyCallback key, void *ctx) {
+    assert(list != NULL);
+    assert(key != NULL);
+
+    clist_assert_vtable(list, sort_by_key);
+
+    clist_vtable2(list, sort_by_key, key, ctx);
+}
+
+typedef struct __clist_join_arg {
+    ClistJoinStrategy strategy;
+    ClistHashCallback hash;
+} ClistJoinArg;
+
+static int __clist_set_join_locked(Clist *list, void *arg) {
+    ClistJoinArg *params = (ClistJoinArg *) arg;
+
+    clist_set_join_strategy(list, params->strategy, params->hash);
+
+    return 0;
+}
+
+/**
+ * sets how contains_all and remove_all match the items of the list with another list
+ * a list with a hash index searches the index instead for contains_all.
+ * @param list     the list instance
+ * @param strategy the strategy
+ * @param hash     the hash function for item data, NULL to use the hash index function if there is one
+ */
+void clist_set_join_strategy(Clist *list, ClistJoinStrategy strategy, ClistHashCallback hash) {
+    ClistJoinArg params;
+
+    assert(list != NULL);
+
+    list->join = strategy;
+
+    list->join_hash = hash;
+
+    /* a concurrent list joins by its wrapped list */
+    if (list->vtable == __clist_concurrent_vtable()) {
+        params.strategy = strategy;
+        params.hash = hash;
+        __clist_concurrent_apply(list, __clist_set_join_locked, &params);
+    }
+}
+
+/*
+ * the hash function for set operations, NULL to sort
+ */
+static ClistHashCallback __clist_set_hash(const Clist *list) {
+    if (list->join == ClistJoinSort) {
+        return NULL;
+    }
+
+    if (list->join_hash == NULL && list->index) {
+        return __clist_index_hasher(list->index);
+    }
+
+    return list->join_hash;
+}
+
+typedef struct __clist_copies_arg {
+    ClistItem **items;
+    size_t size;
+} ClistCopiesArg;
+
+static void __clist_add_last_copies(Clist *list, ClistItem **items, size_t size);
+
+static int __clist_add_last_copies_locked(Clist *list, void *arg) {
+    ClistCopiesArg *params = (ClistCopiesArg *) arg;
+
+    __clist_add_last_copies(list, params->items, params->size);
+
+    return 0;
+}
+
+/*
+ * appends copies of some items to a list
+ */
+static void __clist_add_last_copies(Clist *list, ClistItem **items, size_t size) {
+    ClistCopiesArg params;
+    ClistItem **copies = NULL;
+    size_t pos = 0, list_size = 0;
+
+    /* a concurrent list appends to its wrapped list with the lock held, so the room can't change */
+    if (list->vtable == __clist_concurrent_vtable()) {
+        params.items = items;
+        params.size = size;
+        __clist_concurrent_apply(list, __clist_add_last_copies_locked, &params);
+        return;
+    }
+
+    /* a rejecting ring takes what fits, rather than refusing the lot */
+    if (size > __clist_ring_room(list)) {
+        size = __clist_ring_room(list);
+    }
+
+    if (size == 0) {
+        return;
+    }
+
+    copies = malloc(size * sizeof(ClistItem *));
+    assert(copies != NULL);
+
+    for (pos = 0; pos < size; pos++) {
+        copies[pos] = clist_item_copy(items[pos]);
+    }
+
+    list_size = clist_size(list);
+
+    /* added in one go, so a list without a tail pointer is walked once */
+    if (list_size == 0) {
+        clist_add_batch(list, copies, size);
+    } else {
+        clist_add_batch_index(list, list_size - 1, copies, size);
+    }
+
+    /* a rejecting ring refuses a batch whole, leaving the copies here */
+    if (clist_size(list) == list_size) {
+        for (pos = 0; pos < size; pos++) {
+            clist_item_delete(copies[pos]);
+        }
+    }
+
+    free(copies);
+}
+
+static Clist *__clist_set_new(const Clist *list, const Clist *other, ClistSetOp op) {
+    ClistItem **selected = NULL;
+    Clist *result = NULL;
+    size_t size = 0;
+
+    assert(list != NULL);
+
+    size = __clist_join_select(list, other, op, __clist_set_hash(list), &selected);
+
+    result = __clist_new_like(list);
+
+    __clist_add_last_copies(result, selected, size);
+
+    free(selected);
+
+    return result;
+}
+
+typedef struct __clist_set_keep_arg {
+    ClistItem **selected;
+    size_t size;
+    size_t pos;
+} ClistSetKeepArg;
+
+/*
+ * deletes the items not selected, which are in the same order as the list
+ */
+static ClistCallbackReturn __clist_set_keep_item(ClistItem *item, void *arg) {
+    ClistSetKeepArg *params = (ClistSetKeepArg *) arg;
+
+    if (params->pos < params->size && params->selected[params->pos] == item) {
+        params->pos++;
+        return ClistIterateNext;
+    }
+    return ClistIteratorDelete;
+}
+
+static int __clist_set_in_place(Clist *list, const Clist *other, ClistSetOp op) {
+    ClistSetKeepArg params;
+
+    assert(list != NULL);
+
+    clist_assert_vtable(list, visit);
+
+    params.size = __clist_join_select(list, other, op, __clist_set_hash(list), &params.selected);
+    params.pos = 0;
+
+    __clist_visit(list, __clist_set_keep_item, &params);
+
+    /* the rest are from the other list */
+    __clist_add_last_copies(list, params.selected + params.pos, params.size - params.pos);
+
+    free(params.selected);
+
+    __clist_reindex(list);
+
+    return (int) clist_size(list);
+}
+
+/**
+ * creates a list, of the same implementation, with the items in either list
+ * @param  list  the list instance
+ * @param  other the other list
+ * @return       an allocated list with the items of the list, then the items only in the other list
+ */
+Clist *clist_union(const Clist *list, const Clist *other) {
+    return __clist_set_new(list, other, ClistSetUnion);
+}
+
+/**
+ * creates a list, of the same implementation, with the items in both lists
+ * @param  list  the list instance
+ * @param  other the other list
+ * @return       an allocated list
+ */
+Clist *clist_intersection(const Clist *list, const Clist *other) {
+    return __clist_set_new(list, other, ClistSetIntersection);
+}
+
+/**
+ * creates a list, of the same implementation, with the items not in another list
+ * @param  list  the list instance
+ * @param  other the other list
+ * @return       an allocated list
+ */
+Clist *clist_difference(const Clist *list, const Clist *other) {
+    return __clist_set_new(list, other, ClistSetDifference);
+}
+
+/**
+ * creates a list, of the same implementation, without duplicate items
+ * @param  list the list instance
+ * @return      an allocated list
+ */
+Clist *clist_unique(const Clist *list) {
+    return __clist_set_new(list, NULL, ClistSetUnique);
+}
+
+/**
+ * keeps the items in either list, appending the items only in the other list
+ * @param  list  the list instance
+ * @param  other the other list
+ * @return       the number of items in the list
+ */
+int clist_union_in_place(Clist *list, const Clist *other) {
+    return __clist_set_in_place(list, other, ClistSetUnion);
+}
+
+/**
+ * keeps the items also in another list
+ * @param  list  the list instance
+ * @param  other the other list
+ * @return       the number of items in the list
+ */
+int clist_intersection_in_place(Clist *list, const Clist *other) {
+    return __clist_set_in_place(list, other, ClistSetIntersection);
+}
+
+/**
+ * keeps the items not in another list
+ * @param  list  the list instance
+ * @param  other the other list
+ * @return       the number of items in the list
+ */
+int clist_difference_in_place(Clist *list, const Clist *other) {
+    return __clist_set_in_place(list, other, ClistSetDifference);
+}
+
+/**
+ * removes duplicate items from a list
+ * @param  list the list instance
+ * @return      the number of items in the list
+ */
+int clist_unique_in_place(Clist *list) {
+    return __clist_set_in_place(list, NULL, ClistSetUnique);
+}
+
+/**
+ * keeps a hash index of the items in a list, so that contains, index_of and remove
+ * take expected constant time to find an item.  the index is kept up to date as items are
+ * added and removed, and equal items are still told apart with the item compare functions.
+ * @param list the list instance
+ * @param hash the hash function for item data, equal data must hash the same
+ */
+void clist_enable_hash_index(Clist *list, ClistHashCallback hash) {
+    assert(list != NULL);
+    assert(hash != NULL);
+
+    clist_assert_vtable(list, get_item);
+
+    if (list->vtable == __clist_concurrent_vtable()) {
+        __clist_concurrent_set_hash_index(list, hash);
+        return;
+    }
+
+    __clist_index_delete(list->index);
+
+    list->index = __clist_index_new(hash);
+
+    __clist_reindex(list);
+}
+
+/**
+ * stops keeping a hash index of the items in a list
+ * @param list the list instance
+ */
+void clist_disable_hash_index(Clist *list) {
+    assert(list != NULL);
+
+    if (list->vtable == __clist_concurrent_vtable()) {
+        __clist_concurrent_set_hash_index(list, NULL);
+        return;
+    }
+
+    __clist_index_delete(list->index);
+
+    list->index = NULL;
+}
+
+/**
+ * gets the node pool counters for a list
+ * @param list the list instance
+ * @param stats the counters to fill
+ * @return positive if the list uses a pool, otherwise zero
+ */
+int clist_pool_stats(const Clist *list, ClistPoolStats *stats) {
+    assert(list != NULL);
+    assert(stats != NULL);
+
+    if (list->vtable->pool_stats == NULL) {
+        return 0;
+    }
+
+    return clist_vtable1(list, pool_stats, stats);
+}
+
+/**
+ * iterates a list for each item
+ * @param list the list to iterator
+ * @param callback the callback for each item
+ */
+void clist_for_each(Clist *list, ClistCallback callback) {
+    assert(list != NULL);
+    assert(callback != NULL);
+
+    clist_assert_vtable(list, for_each);
+
+    clist_vtable1(list, for_each, callback);
+
+    /* the callback may have deleted items */
+    __clist_reindex(list);
+}
+
+/**
+ * calls a function for the data of each item, with the items split between threads
+ * @param list     the list instance
+ * @param callback the function to call
+ * @param ctx      user data passed to the callback
+ * @param nthreads the most threads to use, including the calling thread
+ */
+void clist_parallel_for_each(Clist *list, ClistParallelCallback callback, void *ctx, size_t nthreads) {
+    assert(list != NULL);
+    assert(callback != NULL);
+
+    clist_assert_vtable(list, iter_next);
+
+    __clist_parallel_for_each(list, callback, ctx, nthreads);
+}
+
+/**
+ * maps the data of each item to a value and combines the values, with the items split between threads
+ * @param list     the list instance
+ * @param map      the map function
+ * @param combine  the associative combine function
+ * @param identity the identity of the combine function
+ * @param nthreads the most threads to use, including the calling thread
+ * @return the combined value
+ */
+int64_t clist_parallel_reduce(Clist *list, ClistMapCallback map, ClistCombineCallback combine, int64_t identity,
+                              size_t nthreads) {
+    assert(list != NULL);
+    assert(map != NULL);
+    assert(combine != NULL);
+
+    clist_assert_vtable(list, iter_next);
+
+    return __clist_parallel_reduce(list, map, combine, identity, nthreads);
+}
+
+/**
+ * calls a function that makes several changes to a list, holding the lock of a concurrent list once
+ * @param list the list instance
+ * @param callback the function to call, given the list to change
+ * @param arg user data passed to the callback
+ * @return the callback result
+ */
+int clist_locked_apply(Clist *list, ClistApplyCallback callback, void *arg) {
+    assert(list != NULL);
+    assert(callback != NULL);
+
+    if (list->vtable == __clist_concurrent_vtable()) {
+        return __clist_concurrent_apply(list, callback, arg);
+    }
+
+    return callback(list, arg);
+}
+
+/**
+ * starts iterating a list, before the first item
+ * @param list the list instance
+ * @param iter the iterator to start
+ */
+void clist_iter_begin(Clist *list, ClistIterator *iter) {
+    assert(list != NULL);
+    assert(iter != NULL);
+
+    clist_assert_vtable(list, iter_next);
+
+    iter->list = list;
+    iter->item = NULL;
+    iter->index = 0;
+    iter->node = NULL;
+    iter->prev = NULL;
+    iter->offset = 0;
+}
+
+/**
+ * steps to the next item
+ * @param iter the iterator
+ * @return the item, still owned by the list, or NULL at the end
+ */
+ClistItem *clist_iter_next(ClistIterator *iter) {
+    assert(iter != NULL);
+    assert(iter->list != NULL);
+
+    iter->item = (iter->list->vtable->iter_next)(iter);
+
+    return iter->item;
+}
+
+/**
+ * removes the item returned by the last step, the next step returns the item after it
+ * @param iter the iterator
+ * @return positive if an item was removed, zero if there was no item to remove
+ */
+int clist_iter_remove(ClistIterator *iter) {
+    assert(iter != NULL);
+    assert(iter->list != NULL);
+
+    clist_assert_vtable(iter->list, iter_remove);
+
+    if (iter->item == NULL) {
+        return 0;
+    }
+
+    if (iter->list->index) {
+        __clist_index_detach(iter->list->index, iter->item);
+    }
+
+    (iter->list->vtable->iter_remove)(iter);
+
+    iter->item = NULL;
+
+    return 1;
+}
+
+/**
+ * inserts an item after the items stepped over, and moves the iterator past it
+ * @param iter the iterator
+ * @param item the item to insert
+ * @return positive if the item was inserted, zero if it was rejected and is left with the caller
+ */
+int clist_iter_insert_after(ClistIterator *iter, ClistItem *item) {
+    int result;
+
+    assert(iter != NULL);
+    assert(iter->list != NULL);
+    assert(item != NULL);
+
+    clist_assert_vtable(iter->list, iter_insert);
+
+    if (iter->list->index) {
+        __clist_index_attach(iter->list->index, item);
+    }
+
+    result = (iter->list->vtable->iter_insert)(iter, item);
+
+    iter->item = NULL;
+
+    return result;
+}
+
+/*
+ * visits each item in a list, regardless of implementation
+ */
+void __clist_visit(const Clist *list, ClistVisitCallback callback, void *arg) {
+    assert(list != NULL);
+    assert(callback != NULL);
+
+    clist_assert_vtable(list, visit);
+
+    ((list)->vtable->visit)((Clist *) list, callback, arg);
+}